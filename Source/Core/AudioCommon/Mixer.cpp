@@ -8,6 +8,7 @@
 #include <cstring>
 
 #include "AudioCommon/Enums.h"
+#include "AudioCommon/MixerKernels.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -62,8 +63,6 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
                                    int timing_variance)
 {
-  unsigned int currentSample = 0;
-
   // Cache access in non-volatile variable
   // This is the only function changing the read value, so it's safe to
   // cache it locally although it's written here.
@@ -107,46 +106,59 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Copy the input frames that the resampler can reach into per-channel linear buffers, so that
+  // the resampling kernels don't have to deal with wrapping and byte swapping.
+  const bool use_sinc = m_mixer->m_config_sinc_resampling;
+  const u32 history = use_sinc ? AudioCommon::SINC_HISTORY : 0;
+  const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+  const u64 reachable_frames = ((static_cast<u64>(numSamples) * ratio + m_frac) >> 16) + 1 +
+                               AudioCommon::SINC_LOOKAHEAD;
+  const u32 input_frames = static_cast<u32>(std::min<u64>(available_frames, reachable_frames));
+
+  s16* const left = m_mixer->m_resampler_left.data();
+  s16* const right = m_mixer->m_resampler_right.data();
+  for (u32 i = 0; i < input_frames + history; ++i)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    const u32 index = indexR + (i - history) * 2;
+    left[i] = read_buffer(index & INDEX_MASK);
+    right[i] = read_buffer((index + 1) & INDEX_MASK);
   }
 
+  // Resample into a scratch buffer, then apply the volume and mix into the output.
+  u32 position = 0;
+  s16* const resampled = m_mixer->m_resampler_output.data();
+  unsigned int currentSample = 0;
+  while (currentSample < numSamples)
+  {
+    const u32 chunk = std::min(numSamples - currentSample, MAX_SAMPLES);
+    const u32 written =
+        use_sinc ? AudioCommon::ResampleSinc(resampled, chunk, left + history, right + history,
+                                             input_frames, &position, &m_frac, ratio) :
+                   AudioCommon::ResampleLinear(resampled, chunk, left, right, input_frames,
+                                               &position, &m_frac, ratio);
+    AudioCommon::MixWithVolume(samples + currentSample * 2, resampled, written, lvolume, rvolume);
+    currentSample += written;
+    if (written < chunk)
+      break;
+  }
+  indexR += position * 2;
+
   // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  const unsigned int actual_sample_count = currentSample;
 
   // Padding
-  short s[2];
-  s[0] = read_buffer((indexR - 1) & INDEX_MASK);
-  s[1] = read_buffer((indexR - 2) & INDEX_MASK);
-  s[0] = (s[0] * rvolume) >> 8;
-  s[1] = (s[1] * lvolume) >> 8;
-  for (; currentSample < numSamples * 2; currentSample += 2)
+  const s16 pad_r = read_buffer((indexR - 1) & INDEX_MASK);
+  const s16 pad_l = read_buffer((indexR - 2) & INDEX_MASK);
+  for (u32 i = 0; i < std::min(numSamples - currentSample, MAX_SAMPLES); ++i)
   {
-    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
-    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
-
-    samples[currentSample + 0] = sampleR;
-    samples[currentSample + 1] = sampleL;
+    resampled[i * 2] = pad_r;
+    resampled[i * 2 + 1] = pad_l;
+  }
+  while (currentSample < numSamples)
+  {
+    const u32 chunk = std::min(numSamples - currentSample, MAX_SAMPLES);
+    AudioCommon::MixWithVolume(samples + currentSample * 2, resampled, chunk, lvolume, rvolume);
+    currentSample += chunk;
   }
 
   // Flush cached variable
@@ -458,6 +470,7 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_sinc_resampling = Config::Get(Config::MAIN_AUDIO_SINC_RESAMPLING);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
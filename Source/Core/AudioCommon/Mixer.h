@@ -111,6 +111,11 @@ private:
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
 
+  // Working buffers for MixerFifo::Mix, which is only called from the audio thread.
+  std::array<s16, MAX_SAMPLES + 32> m_resampler_left{};
+  std::array<s16, MAX_SAMPLES + 32> m_resampler_right{};
+  std::array<s16, MAX_SAMPLES * 2> m_resampler_output{};
+
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
 
@@ -120,6 +125,7 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_sinc_resampling;
 
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
@@ -0,0 +1,461 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/MixerKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <numbers>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+
+#if defined(_M_X86_64)
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace AudioCommon
+{
+namespace
+{
+constexpr u32 SINC_PHASE_BITS = 8;
+constexpr u32 SINC_PHASES = 1 << SINC_PHASE_BITS;
+constexpr u32 SINC_COEFFICIENT_BITS = 14;
+// Cut off slightly below the Nyquist frequency to leave room for the transition band.
+constexpr double SINC_CUTOFF = 0.95;
+// Ratios are rounded up to multiples of this when picking the cutoff for downsampling.
+constexpr u32 SINC_CUTOFF_RATIO_STEP = 0x1000;
+// Beyond this, the lowered cutoff would need more taps than the filter has.
+constexpr u32 SINC_MAX_CUTOFF_RATIO = 4 << 16;
+
+// Aligned so that the SIMD dot products can use aligned loads for the coefficients.
+struct alignas(32) SincTable
+{
+  std::array<std::array<s16, SINC_TAPS>, SINC_PHASES> phases;
+};
+
+// cutoff is relative to the Nyquist frequency of the input.
+SincTable GenerateSincTable(double cutoff)
+{
+  constexpr double half_width = SINC_TAPS / 2;
+
+  SincTable table{};
+  for (u32 phase = 0; phase < SINC_PHASES; ++phase)
+  {
+    const double t = static_cast<double>(phase) / SINC_PHASES;
+
+    std::array<double, SINC_TAPS> weights;
+    double sum = 0.0;
+    for (u32 tap = 0; tap < SINC_TAPS; ++tap)
+    {
+      const double x = static_cast<double>(tap) - SINC_HISTORY - t;
+      const double px = std::numbers::pi * x * cutoff;
+      const double sinc = x == 0.0 ? 1.0 : std::sin(px) / px;
+      // Blackman window
+      const double w = 0.42 + 0.5 * std::cos(std::numbers::pi * x / half_width) +
+                       0.08 * std::cos(2.0 * std::numbers::pi * x / half_width);
+      weights[tap] = sinc * std::max(w, 0.0);
+      sum += weights[tap];
+    }
+
+    // Normalize so that every phase has a DC gain of exactly 1.
+    s32 total = 0;
+    for (u32 tap = 0; tap < SINC_TAPS; ++tap)
+    {
+      table.phases[phase][tap] =
+          static_cast<s16>(std::lround(weights[tap] / sum * (1 << SINC_COEFFICIENT_BITS)));
+      total += table.phases[phase][tap];
+    }
+    const u32 center = t < 0.5 ? SINC_HISTORY : SINC_HISTORY + 1;
+    table.phases[phase][center] += static_cast<s16>((1 << SINC_COEFFICIENT_BITS) - total);
+  }
+  return table;
+}
+
+// When downsampling, everything above the Nyquist frequency of the output has to be removed, so
+// the cutoff is lowered by the ratio. Ratios are rounded up to a few steps so that the tables for
+// the slightly varying ratios the mixer uses are generated only once.
+const SincTable& GetSincTable(u32 ratio)
+{
+  static std::mutex mutex;
+  static std::map<u32, SincTable> tables;
+
+  const u32 rounded_ratio = Common::AlignUp(std::max<u32>(ratio, 1 << 16), SINC_CUTOFF_RATIO_STEP);
+  const u32 cutoff_ratio = std::min(rounded_ratio, SINC_MAX_CUTOFF_RATIO);
+
+  std::lock_guard lock(mutex);
+  const auto [iter, inserted] = tables.try_emplace(cutoff_ratio);
+  if (inserted)
+    iter->second = GenerateSincTable(SINC_CUTOFF * (1 << 16) / cutoff_ratio);
+  return iter->second;
+}
+
+s16 SaturateSincSum(s32 sum)
+{
+  constexpr s32 rounding = 1 << (SINC_COEFFICIENT_BITS - 1);
+  return static_cast<s16>(std::clamp((sum + rounding) >> SINC_COEFFICIENT_BITS, -32768, 32767));
+}
+
+[[maybe_unused]] u32 ResampleLinearGeneric(s16* out, u32 max_frames, const s16* left,
+                                           const s16* right, u32 num_frames, u32* position,
+                                           u32* frac, u32 ratio)
+{
+  u32 pos = *position;
+  u32 f = *frac;
+
+  u32 written = 0;
+  for (; written < max_frames && pos + 1 < num_frames; ++written)
+  {
+    const s32 l1 = left[pos];
+    const s32 l2 = left[pos + 1];
+    const s32 r1 = right[pos];
+    const s32 r2 = right[pos + 1];
+    out[written * 2] = static_cast<s16>(r1 + ((static_cast<s64>(r2 - r1) * f) >> 16));
+    out[written * 2 + 1] = static_cast<s16>(l1 + ((static_cast<s64>(l2 - l1) * f) >> 16));
+
+    f += ratio;
+    pos += f >> 16;
+    f &= 0xFFFF;
+  }
+
+  *position = pos;
+  *frac = f;
+  return written;
+}
+
+// Steps through the next four output frames of the linear resampler. For each of them, the two
+// input frames of each channel are packed into one word, with the first one in the low half.
+// Returns false without advancing if the input runs out before the last one.
+[[maybe_unused]] bool GetLinearFrames(const s16* left, const s16* right, u32 num_frames, u32* pos,
+                                      u32* f, u32 ratio, std::array<u32, 4>* left_pairs,
+                                      std::array<u32, 4>* right_pairs, std::array<u32, 4>* fracs)
+{
+  u32 p = *pos;
+  u32 next_f = *f;
+  for (u32 i = 0; i < 4; ++i)
+  {
+    if (p + 1 >= num_frames)
+      return false;
+
+    std::memcpy(&(*left_pairs)[i], left + p, sizeof(u32));
+    std::memcpy(&(*right_pairs)[i], right + p, sizeof(u32));
+    (*fracs)[i] = next_f;
+
+    next_f += ratio;
+    p += next_f >> 16;
+    next_f &= 0xFFFF;
+  }
+
+  *pos = p;
+  *f = next_f;
+  return true;
+}
+
+[[maybe_unused]] s32 SincDotGeneric(const s16* samples, const s16* coefficients)
+{
+  s32 sum = 0;
+  for (u32 i = 0; i < SINC_TAPS; ++i)
+    sum += samples[i] * coefficients[i];
+  return sum;
+}
+
+[[maybe_unused]] void MixWithVolumeGeneric(s16* dest, const s16* src, u32 num_frames,
+                                           s32 left_volume, s32 right_volume)
+{
+  for (u32 i = 0; i < num_frames * 2; i += 2)
+  {
+    dest[i] = std::clamp(dest[i] + ((src[i] * right_volume) >> 8), -32767, 32767);
+    dest[i + 1] = std::clamp(dest[i + 1] + ((src[i + 1] * left_volume) >> 8), -32767, 32767);
+  }
+}
+
+#if defined(_M_X86_64)
+
+s32 SincDotSSE2(const s16* samples, const s16* coefficients)
+{
+  const __m128i* s = reinterpret_cast<const __m128i*>(samples);
+  const __m128i* c = reinterpret_cast<const __m128i*>(coefficients);
+  __m128i sum = _mm_add_epi32(_mm_madd_epi16(_mm_loadu_si128(s), _mm_load_si128(c)),
+                              _mm_madd_epi16(_mm_loadu_si128(s + 1), _mm_load_si128(c + 1)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Interpolates between the two samples packed into each word of pairs, as
+// (first << 16) + (second - first) * f. pmaddwd computes first * (65536 - f) + second * f, but
+// with both weights taken as signed 16-bit values, which are 65536 too small when they're at
+// least 32768. Adding back 65536 times the samples whose weight that happened to makes the result
+// exact modulo 2^32, and the exact value always fits in 32 bits.
+__m128i InterpolateLinearSSE2(__m128i pairs, __m128i fracs)
+{
+  const __m128i low_half = _mm_set1_epi32(0xFFFF);
+  const __m128i weights = _mm_or_si128(
+      _mm_and_si128(_mm_sub_epi32(_mm_set1_epi32(0x10000), fracs), low_half),
+      _mm_slli_epi32(fracs, 16));
+  const __m128i wrapped_first = _mm_cmplt_epi32(fracs, _mm_set1_epi32(0x8001));
+  const __m128i wrapped_second = _mm_cmpgt_epi32(fracs, _mm_set1_epi32(0x7FFF));
+  const __m128i wrapped = _mm_and_si128(
+      pairs, _mm_or_si128(_mm_and_si128(wrapped_first, low_half),
+                          _mm_andnot_si128(low_half, wrapped_second)));
+  const __m128i correction =
+      _mm_add_epi32(_mm_slli_epi32(wrapped, 16), _mm_andnot_si128(low_half, wrapped));
+  return _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(pairs, weights), correction), 16);
+}
+
+u32 ResampleLinearSSE2(s16* out, u32 max_frames, const s16* left, const s16* right,
+                       u32 num_frames, u32* position, u32* frac, u32 ratio)
+{
+  u32 pos = *position;
+  u32 f = *frac;
+
+  // Finding the input frames is inherently serial, so only the interpolation is vectorized.
+  u32 written = 0;
+  std::array<u32, 4> left_pairs, right_pairs, fracs;
+  for (; written + 4 <= max_frames &&
+         GetLinearFrames(left, right, num_frames, &pos, &f, ratio, &left_pairs, &right_pairs,
+                         &fracs);
+       written += 4)
+  {
+    // Each vector holds the (right, left) pairs of two output frames, in output order.
+    const __m128i pairs0 =
+        _mm_setr_epi32(right_pairs[0], left_pairs[0], right_pairs[1], left_pairs[1]);
+    const __m128i pairs1 =
+        _mm_setr_epi32(right_pairs[2], left_pairs[2], right_pairs[3], left_pairs[3]);
+    const __m128i fracs0 = _mm_setr_epi32(fracs[0], fracs[0], fracs[1], fracs[1]);
+    const __m128i fracs1 = _mm_setr_epi32(fracs[2], fracs[2], fracs[3], fracs[3]);
+    const __m128i result = _mm_packs_epi32(InterpolateLinearSSE2(pairs0, fracs0),
+                                           InterpolateLinearSSE2(pairs1, fracs1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written * 2), result);
+  }
+
+  *position = pos;
+  *frac = f;
+  return written + ResampleLinearGeneric(out + written * 2, max_frames - written, left, right,
+                                         num_frames, position, frac, ratio);
+}
+
+FUNCTION_TARGET_AVX2
+s32 SincDotAVX2(const s16* samples, const s16* coefficients)
+{
+  const __m256i product =
+      _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples)),
+                        _mm256_load_si256(reinterpret_cast<const __m256i*>(coefficients)));
+  __m128i sum =
+      _mm_add_epi32(_mm256_castsi256_si128(product), _mm256_extracti128_si256(product, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Computes saturate(dest + ((src * volume) >> 8)) for eight samples. The 32-bit products are
+// built from the low and high halves of the 16-bit multiplications, since SSE2 has no 32-bit
+// multiply. (src * volume) >> 8 always fits in 16 bits because volume is at most 256.
+__m128i MixVolumeSSE2(__m128i dest, __m128i src, __m128i volume)
+{
+  const __m128i lo = _mm_mullo_epi16(src, volume);
+  const __m128i hi = _mm_mulhi_epi16(src, volume);
+  const __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 8);
+  const __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 8);
+  const __m128i sum = _mm_adds_epi16(dest, _mm_packs_epi32(p0, p1));
+  return _mm_max_epi16(sum, _mm_set1_epi16(-32767));
+}
+
+void MixWithVolumeSSE2(s16* dest, const s16* src, u32 num_frames, s32 left_volume,
+                       s32 right_volume)
+{
+  const __m128i volume = _mm_set1_epi32((left_volume << 16) | (right_volume & 0xFFFF));
+
+  u32 i = 0;
+  for (; i + 8 <= num_frames * 2; i += 8)
+  {
+    __m128i* d = reinterpret_cast<__m128i*>(dest + i);
+    const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(d, MixVolumeSSE2(_mm_loadu_si128(d), s, volume));
+  }
+
+  MixWithVolumeGeneric(dest + i, src + i, num_frames - i / 2, left_volume, right_volume);
+}
+
+FUNCTION_TARGET_AVX2
+void MixWithVolumeAVX2(s16* dest, const s16* src, u32 num_frames, s32 left_volume,
+                       s32 right_volume)
+{
+  const __m256i volume = _mm256_set1_epi32((left_volume << 16) | (right_volume & 0xFFFF));
+  const __m256i min_value = _mm256_set1_epi16(-32767);
+
+  u32 i = 0;
+  for (; i + 16 <= num_frames * 2; i += 16)
+  {
+    __m256i* d = reinterpret_cast<__m256i*>(dest + i);
+    const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i lo = _mm256_mullo_epi16(s, volume);
+    const __m256i hi = _mm256_mulhi_epi16(s, volume);
+    const __m256i p0 = _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), 8);
+    const __m256i p1 = _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), 8);
+    // unpack and pack both operate within 128-bit lanes, so the order is preserved.
+    const __m256i sum = _mm256_adds_epi16(_mm256_loadu_si256(d), _mm256_packs_epi32(p0, p1));
+    _mm256_storeu_si256(d, _mm256_max_epi16(sum, min_value));
+  }
+
+  MixWithVolumeSSE2(dest + i, src + i, num_frames - i / 2, left_volume, right_volume);
+}
+
+#elif defined(_M_ARM_64)
+
+s32 SincDotNEON(const s16* samples, const s16* coefficients)
+{
+  const int16x8_t s0 = vld1q_s16(samples);
+  const int16x8_t s1 = vld1q_s16(samples + 8);
+  const int16x8_t c0 = vld1q_s16(coefficients);
+  const int16x8_t c1 = vld1q_s16(coefficients + 8);
+  int32x4_t sum = vmull_s16(vget_low_s16(s0), vget_low_s16(c0));
+  sum = vmlal_high_s16(sum, s0, c0);
+  sum = vmlal_s16(sum, vget_low_s16(s1), vget_low_s16(c1));
+  sum = vmlal_high_s16(sum, s1, c1);
+  return vaddvq_s32(sum);
+}
+
+// Computes (first << 16) + (second - first) * f for the samples packed into each word of pairs.
+// The multiplication wraps, but the exact value always fits in 32 bits.
+int16x4_t InterpolateLinearNEON(uint32x4_t pairs, int32x4_t fracs)
+{
+  const int16x4_t first = vmovn_s32(vreinterpretq_s32_u32(pairs));
+  const int16x4_t second = vshrn_n_s32(vreinterpretq_s32_u32(pairs), 16);
+  const int32x4_t result = vmlaq_s32(vshll_n_s16(first, 16), vsubl_s16(second, first), fracs);
+  return vshrn_n_s32(result, 16);
+}
+
+u32 ResampleLinearNEON(s16* out, u32 max_frames, const s16* left, const s16* right,
+                       u32 num_frames, u32* position, u32* frac, u32 ratio)
+{
+  u32 pos = *position;
+  u32 f = *frac;
+
+  // Finding the input frames is inherently serial, so only the interpolation is vectorized.
+  u32 written = 0;
+  std::array<u32, 4> left_pairs, right_pairs, fracs;
+  for (; written + 4 <= max_frames &&
+         GetLinearFrames(left, right, num_frames, &pos, &f, ratio, &left_pairs, &right_pairs,
+                         &fracs);
+       written += 4)
+  {
+    const int32x4_t f_vector = vreinterpretq_s32_u32(vld1q_u32(fracs.data()));
+    int16x4x2_t result;
+    result.val[0] = InterpolateLinearNEON(vld1q_u32(right_pairs.data()), f_vector);
+    result.val[1] = InterpolateLinearNEON(vld1q_u32(left_pairs.data()), f_vector);
+    vst2_s16(out + written * 2, result);
+  }
+
+  *position = pos;
+  *frac = f;
+  return written + ResampleLinearGeneric(out + written * 2, max_frames - written, left, right,
+                                         num_frames, position, frac, ratio);
+}
+
+void MixWithVolumeNEON(s16* dest, const s16* src, u32 num_frames, s32 left_volume,
+                       s32 right_volume)
+{
+  const int16x8_t volume = vreinterpretq_s16_s32(vdupq_n_s32((left_volume << 16) | right_volume));
+  const int16x8_t min_value = vdupq_n_s16(-32767);
+
+  u32 i = 0;
+  for (; i + 8 <= num_frames * 2; i += 8)
+  {
+    const int16x8_t s = vld1q_s16(src + i);
+    const int32x4_t p0 = vshrq_n_s32(vmull_s16(vget_low_s16(s), vget_low_s16(volume)), 8);
+    const int32x4_t p1 = vshrq_n_s32(vmull_high_s16(s, volume), 8);
+    const int16x8_t sum = vqaddq_s16(vld1q_s16(dest + i), vcombine_s16(vqmovn_s32(p0),
+                                                                       vqmovn_s32(p1)));
+    vst1q_s16(dest + i, vmaxq_s16(sum, min_value));
+  }
+
+  MixWithVolumeGeneric(dest + i, src + i, num_frames - i / 2, left_volume, right_volume);
+}
+
+#endif
+
+using ResampleLinearFunction = u32 (*)(s16*, u32, const s16*, const s16*, u32, u32*, u32*, u32);
+using SincDotFunction = s32 (*)(const s16*, const s16*);
+using MixWithVolumeFunction = void (*)(s16*, const s16*, u32, s32, s32);
+
+ResampleLinearFunction GetResampleLinearFunction()
+{
+#if defined(_M_X86_64)
+  return ResampleLinearSSE2;
+#elif defined(_M_ARM_64)
+  return ResampleLinearNEON;
+#else
+  return ResampleLinearGeneric;
+#endif
+}
+
+SincDotFunction GetSincDotFunction()
+{
+#if defined(_M_X86_64)
+  return cpu_info.bAVX2 ? SincDotAVX2 : SincDotSSE2;
+#elif defined(_M_ARM_64)
+  return SincDotNEON;
+#else
+  return SincDotGeneric;
+#endif
+}
+
+MixWithVolumeFunction GetMixWithVolumeFunction()
+{
+#if defined(_M_X86_64)
+  return cpu_info.bAVX2 ? MixWithVolumeAVX2 : MixWithVolumeSSE2;
+#elif defined(_M_ARM_64)
+  return MixWithVolumeNEON;
+#else
+  return MixWithVolumeGeneric;
+#endif
+}
+}  // namespace
+
+u32 ResampleLinear(s16* out, u32 max_frames, const s16* left, const s16* right, u32 num_frames,
+                   u32* position, u32* frac, u32 ratio)
+{
+  static const ResampleLinearFunction resample = GetResampleLinearFunction();
+  return resample(out, max_frames, left, right, num_frames, position, frac, ratio);
+}
+
+u32 ResampleSinc(s16* out, u32 max_frames, const s16* left, const s16* right, u32 num_frames,
+                 u32* position, u32* frac, u32 ratio)
+{
+  static const SincDotFunction dot = GetSincDotFunction();
+  const SincTable& table = GetSincTable(ratio);
+
+  u32 pos = *position;
+  u32 f = *frac;
+
+  u32 written = 0;
+  for (; written < max_frames && pos + SINC_LOOKAHEAD < num_frames; ++written)
+  {
+    const s16* coefficients = table.phases[f >> (16 - SINC_PHASE_BITS)].data();
+    out[written * 2] = SaturateSincSum(dot(right + pos - SINC_HISTORY, coefficients));
+    out[written * 2 + 1] = SaturateSincSum(dot(left + pos - SINC_HISTORY, coefficients));
+
+    f += ratio;
+    pos += f >> 16;
+    f &= 0xFFFF;
+  }
+
+  *position = pos;
+  *frac = f;
+  return written;
+}
+
+void MixWithVolume(s16* dest, const s16* src, u32 num_frames, s32 left_volume, s32 right_volume)
+{
+  static const MixWithVolumeFunction mix = GetMixWithVolumeFunction();
+  mix(dest, src, num_frames, left_volume, right_volume);
+}
+}  // namespace AudioCommon
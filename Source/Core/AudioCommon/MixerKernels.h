@@ -0,0 +1,37 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Sample processing routines used by the Mixer on the audio thread. Stereo data is laid out as
+// interleaved (right, left) frames, matching the output of Mixer::Mix. Resampler input is
+// passed as two separate channel arrays indexed by input frame.
+namespace AudioCommon
+{
+// Number of input frames the windowed-sinc resampler reads around each output frame.
+constexpr u32 SINC_TAPS = 16;
+// Frames before the current input frame that the sinc resampler reads.
+constexpr u32 SINC_HISTORY = SINC_TAPS / 2 - 1;
+// Frames after the current input frame that the sinc resampler reads.
+constexpr u32 SINC_LOOKAHEAD = SINC_TAPS / 2;
+
+// Produces up to max_frames output frames by linearly interpolating between input frames.
+// position is the current input frame and frac the 16-bit fractional position between it and
+// the next one; both are advanced by ratio (16.16 fixed point) per output frame. Stops early
+// when fewer than two input frames are left. Returns the number of frames written.
+u32 ResampleLinear(s16* out, u32 max_frames, const s16* left, const s16* right, u32 num_frames,
+                   u32* position, u32* frac, u32 ratio);
+
+// Same as ResampleLinear, but uses a windowed-sinc filter. left and right must have
+// SINC_HISTORY valid frames before index 0, and SINC_LOOKAHEAD frames after the current
+// position are required to produce an output frame. When downsampling, the cutoff frequency is
+// lowered to stay below the Nyquist frequency of the output.
+u32 ResampleSinc(s16* out, u32 max_frames, const s16* left, const s16* right, u32 num_frames,
+                 u32* position, u32* frac, u32 ratio);
+
+// Scales src by the per-channel volume (0-256) and adds it to dest, saturating to
+// [-32767, 32767].
+void MixWithVolume(s16* dest, const s16* src, u32 num_frames, s32 left_volume, s32 right_volume);
+}  // namespace AudioCommon
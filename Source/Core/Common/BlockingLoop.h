@@ -3,12 +3,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <limits>
 #include <mutex>
 #include <thread>
+#include <utility>
 
+#include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "Common/Thread.h"
 
 namespace Common
 {
@@ -18,6 +24,9 @@ namespace Common
 // often.
 // Be careful when using Wait() and Wakeup() at the same time. Wait() may block forever while
 // Wakeup() is called regularly.
+// Before going to sleep, the worker can spin for a short time to catch new work without a kernel
+// round trip. The spin time adapts: it grows while spinning catches new work, and shrinks while
+// the worker ends up sleeping anyway.
 class BlockingLoop
 {
 public:
@@ -28,6 +37,17 @@ public:
     BlockAndGiveUp,
   };
 
+  // Counters about how the worker waited for new work.
+  struct WaitCounters
+  {
+    // Number of times the worker went to sleep.
+    u64 sleeps = 0;
+    // Number of times new work arrived while spinning.
+    u64 spin_hits = 0;
+    // Total time spent spinning.
+    std::chrono::microseconds spin_time{};
+  };
+
   BlockingLoop() { m_stopped.Set(); }
   ~BlockingLoop() { Stop(StopMode::BlockAndGiveUp); }
   // Triggers to rerun the payload of the Run() function at least once again.
@@ -164,6 +184,10 @@ public:
         // loop.
         if (m_may_sleep.TestAndClear())
         {
+          // New work may arrive shortly, which is cheaper to catch by spinning than by sleeping.
+          if (SpinForWork())
+            break;
+
           // Try to set the sleeping state.
           if (m_running_state-- != STATE_DONE)
             break;
@@ -177,6 +201,7 @@ public:
 
       case STATE_SLEEPING:
         // Just relax
+        ++m_wait_counters.sleeps;
         if (timeout > 0)
         {
           m_new_work_event.WaitFor(std::chrono::milliseconds(timeout));
@@ -226,6 +251,17 @@ public:
     }
   }
 
+  // Sets the maximum time the worker spins before going to sleep. Zero disables spinning.
+  // This may be called from any thread.
+  void SetMaxSpinTime(std::chrono::microseconds max_spin_time)
+  {
+    m_max_spin_time_us.store(max_spin_time.count(), std::memory_order_relaxed);
+  }
+
+  // Returns the counters collected since the last call and resets them.
+  // Must only be called from within the payload of Run().
+  WaitCounters TakeWaitCounters() { return std::exchange(m_wait_counters, {}); }
+
   bool IsRunning() const { return !m_stopped.IsSet() && !m_shutdown.IsSet(); }
   bool IsDone() const { return m_stopped.IsSet() || m_running_state.load() <= STATE_DONE; }
   // This function should be triggered regularly over time so
@@ -233,6 +269,46 @@ public:
   void AllowSleep() { m_may_sleep.Set(); }
 
 private:
+  static constexpr s64 MIN_SPIN_TIME_US = 1;
+
+  // Spins until new work arrives or the spin time runs out. Returns whether there is new work.
+  bool SpinForWork()
+  {
+    const s64 max_spin_time_us = m_max_spin_time_us.load(std::memory_order_relaxed);
+    if (max_spin_time_us <= 0)
+      return false;
+
+    m_spin_time_us = std::clamp(m_spin_time_us, MIN_SPIN_TIME_US, max_spin_time_us);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::microseconds(m_spin_time_us);
+    bool has_work = false;
+    auto now = start;
+    while (now < deadline)
+    {
+      if (m_running_state.load() != STATE_DONE || m_shutdown.IsSet())
+      {
+        has_work = true;
+        break;
+      }
+      YieldCPU();
+      now = std::chrono::steady_clock::now();
+    }
+
+    m_wait_counters.spin_time +=
+        std::chrono::duration_cast<std::chrono::microseconds>(now - start);
+    if (has_work)
+    {
+      ++m_wait_counters.spin_hits;
+      m_spin_time_us = std::min(m_spin_time_us * 2, max_spin_time_us);
+    }
+    else
+    {
+      m_spin_time_us = std::max(m_spin_time_us / 2, MIN_SPIN_TIME_US);
+    }
+    return has_work;
+  }
+
   std::mutex m_wait_lock;
   std::mutex m_prepare_lock;
 
@@ -253,5 +329,10 @@ private:
 
   Flag m_may_sleep;  // If this is set, we fall back from the busy loop to an event based
                      // synchronization.
+
+  std::atomic<s64> m_max_spin_time_us = 0;
+  // Only used by the worker thread. Starts at the maximum and adapts from there.
+  s64 m_spin_time_us = std::numeric_limits<s64>::max();
+  WaitCounters m_wait_counters;  // Only used by the worker thread.
 };
 }  // namespace Common
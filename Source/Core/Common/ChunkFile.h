@@ -28,6 +28,7 @@
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/ChunkedWriter.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
 #include "Common/Flag.h"
@@ -48,12 +49,22 @@ public:
 
 private:
   u8** m_ptr_current;
+  u8* m_ptr_start;
   u8* m_ptr_end;
   Mode m_mode;
+  Common::ChunkedWriter* m_writer = nullptr;
 
 public:
   PointerWrap(u8** ptr, size_t size, Mode mode)
-      : m_ptr_current(ptr), m_ptr_end(*ptr + size), m_mode(mode)
+      : m_ptr_current(ptr), m_ptr_start(*ptr), m_ptr_end(*ptr + size), m_mode(mode)
+  {
+  }
+
+  // Writes to a ChunkedWriter, which grows as needed. This avoids having to measure the size of
+  // the data before writing it.
+  explicit PointerWrap(Common::ChunkedWriter& writer)
+      : m_ptr_current(writer.GetCurrentPointer()), m_ptr_start(nullptr),
+        m_ptr_end(writer.GetEnd()), m_mode(Mode::Write), m_writer(&writer)
   {
   }
 
@@ -219,30 +230,53 @@ public:
   [[nodiscard]] u8* DoExternal(u32& count)
   {
     Do(count);
+    if (!IsMeasureMode() && (*m_ptr_current + count) > m_ptr_end)
+      HandleEndOfBuffer(count);
     u8* current = *m_ptr_current;
     *m_ptr_current += count;
-    if (!IsMeasureMode() && *m_ptr_current > m_ptr_end)
-    {
-      // trying to read/write past the end of the buffer, prevent this
-      SetMeasureMode();
-    }
     return current;
   }
 
-  // The reserved u32 is set to 0, and a pointer to it is returned.
-  // The caller needs to fill in the reserved u32 with the appropriate value later on, if they
-  // want a non-zero value there.
-  [[nodiscard]] u8* ReserveU32()
+  // Number of bytes that have been read or written so far.
+  size_t GetPosition() const
+  {
+    if (m_writer)
+      return m_writer->GetPosition();
+    return static_cast<size_t>(*m_ptr_current - m_ptr_start);
+  }
+
+  // The reserved u32 is set to 0, and its position is returned.
+  // The caller needs to fill in the reserved u32 with SetReservedU32 later on when in write mode.
+  [[nodiscard]] size_t ReserveU32()
   {
+    if (m_writer && IsWriteMode())
+      m_writer->Hold();
+
     u32 temp = 0;
-    u8* previous_pointer = *m_ptr_current;
+    const size_t position = GetPosition();
     Do(temp);
-    return previous_pointer;
+    return position;
   }
 
-  u32 GetOffsetFromPreviousPosition(u8* previous_pointer)
+  u32 GetOffsetFromReservedU32(size_t position) const
   {
-    return static_cast<u32>((*m_ptr_current) - previous_pointer);
+    return static_cast<u32>(GetPosition() - position - sizeof(u32));
+  }
+
+  void SetReservedU32(size_t position, u32 value)
+  {
+    if (!IsWriteMode())
+      return;
+
+    if (m_writer)
+    {
+      m_writer->Overwrite(position, &value, sizeof(u32));
+      m_writer->Release();
+    }
+    else
+    {
+      memcpy(m_ptr_start + position, &value, sizeof(u32));
+    }
   }
 
   void Do(Common::Flag& flag)
@@ -343,14 +377,24 @@ private:
     DoEachElement(x, [](PointerWrap& p, typename T::value_type& elem) { p.Do(elem); });
   }
 
-  DOLPHIN_FORCE_INLINE void DoVoid(void* data, u32 size)
+  void HandleEndOfBuffer(u32 size)
   {
-    if (!IsMeasureMode() && (*m_ptr_current + size) > m_ptr_end)
+    if (m_writer && IsWriteMode())
     {
-      // trying to read/write past the end of the buffer, prevent this
-      SetMeasureMode();
+      m_writer->NextChunk(size);
+      m_ptr_end = m_writer->GetEnd();
+      return;
     }
 
+    // trying to read/write past the end of the buffer, prevent this
+    SetMeasureMode();
+  }
+
+  DOLPHIN_FORCE_INLINE void DoVoid(void* data, u32 size)
+  {
+    if (!IsMeasureMode() && (*m_ptr_current + size) > m_ptr_end)
+      HandleEndOfBuffer(size);
+
     switch (m_mode)
     {
     case Mode::Read:
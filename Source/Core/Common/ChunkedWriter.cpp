@@ -0,0 +1,111 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ChunkedWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Common/Assert.h"
+
+namespace Common
+{
+ChunkedWriter::ChunkedWriter(ChunkCallback callback, size_t chunk_size)
+    : m_callback(std::move(callback)), m_chunk_size(chunk_size), m_chunk(chunk_size),
+      m_current(m_chunk.data())
+{
+}
+
+void ChunkedWriter::Finish()
+{
+  ASSERT_MSG(COMMON, m_hold_count == 0, "ChunkedWriter finished while data is still held");
+
+  CompleteChunk();
+  while (!m_held_chunks.empty())
+  {
+    m_callback(std::move(m_held_chunks.front().data));
+    m_held_chunks.pop_front();
+  }
+
+  m_chunk = {};
+  m_current = nullptr;
+}
+
+size_t ChunkedWriter::GetPosition() const
+{
+  return m_chunk_position + static_cast<size_t>(m_current - m_chunk.data());
+}
+
+void ChunkedWriter::Hold()
+{
+  ++m_hold_count;
+}
+
+void ChunkedWriter::Release()
+{
+  ASSERT(m_hold_count != 0);
+  if (--m_hold_count != 0)
+    return;
+
+  while (!m_held_chunks.empty())
+  {
+    m_callback(std::move(m_held_chunks.front().data));
+    m_held_chunks.pop_front();
+  }
+}
+
+void ChunkedWriter::Overwrite(size_t position, const void* data, size_t size)
+{
+  const u8* src = static_cast<const u8*>(data);
+
+  const auto overwrite_in = [&](size_t chunk_position, u8* chunk_data, size_t chunk_size) {
+    if (size == 0 || position < chunk_position || position >= chunk_position + chunk_size)
+      return;
+
+    const size_t offset = position - chunk_position;
+    const size_t count = std::min(size, chunk_size - offset);
+    std::memcpy(chunk_data + offset, src, count);
+    src += count;
+    position += count;
+    size -= count;
+  };
+
+  for (HeldChunk& chunk : m_held_chunks)
+    overwrite_in(chunk.position, chunk.data.data(), chunk.data.size());
+  overwrite_in(m_chunk_position, m_chunk.data(), static_cast<size_t>(m_current - m_chunk.data()));
+
+  ASSERT_MSG(COMMON, size == 0, "ChunkedWriter: overwritten data was already submitted");
+}
+
+void ChunkedWriter::NextChunk(size_t size)
+{
+  CompleteChunk();
+
+  m_chunk = std::vector<u8>(std::max(m_chunk_size, size));
+  m_current = m_chunk.data();
+}
+
+void ChunkedWriter::CompleteChunk()
+{
+  const size_t used = static_cast<size_t>(m_current - m_chunk.data());
+  const size_t position = m_chunk_position;
+  m_chunk_position += used;
+
+  if (used == 0)
+    return;
+
+  m_chunk.resize(used);
+  SubmitChunk(position, std::move(m_chunk));
+  m_chunk = {};
+  m_current = nullptr;
+}
+
+void ChunkedWriter::SubmitChunk(size_t position, std::vector<u8> chunk)
+{
+  if (m_hold_count != 0)
+    m_held_chunks.push_back({position, std::move(chunk)});
+  else
+    m_callback(std::move(chunk));
+}
+}  // namespace Common
@@ -0,0 +1,72 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// Output of a PointerWrap in write mode for data whose size isn't known in advance. Data is
+// written into chunks that are allocated as needed, and every completed chunk is passed to a
+// callback in order, which lets the consumer (e.g. a compressor on another thread) process it
+// while the rest of the data is still being written.
+class ChunkedWriter final
+{
+public:
+  using ChunkCallback = std::function<void(std::vector<u8> chunk)>;
+
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+  explicit ChunkedWriter(ChunkCallback callback, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  ChunkedWriter(const ChunkedWriter&) = delete;
+  ChunkedWriter& operator=(const ChunkedWriter&) = delete;
+  ChunkedWriter(ChunkedWriter&&) = delete;
+  ChunkedWriter& operator=(ChunkedWriter&&) = delete;
+
+  // Passes all remaining data to the callback. Nothing may be written afterwards.
+  void Finish();
+
+  // Total number of bytes written so far.
+  size_t GetPosition() const;
+
+  // While held, completed chunks are kept instead of being passed to the callback, so that
+  // already written data can still be changed with Overwrite. Holds can be nested.
+  void Hold();
+  void Release();
+  void Overwrite(size_t position, const void* data, size_t size);
+
+  // Used by PointerWrap to write directly into the current chunk.
+  u8** GetCurrentPointer() { return &m_current; }
+  u8* GetEnd() { return m_chunk.data() + m_chunk.size(); }
+
+  // Completes the current chunk and starts a new one with room for at least size bytes.
+  void NextChunk(size_t size);
+
+private:
+  struct HeldChunk
+  {
+    size_t position;
+    std::vector<u8> data;
+  };
+
+  void CompleteChunk();
+  void SubmitChunk(size_t position, std::vector<u8> chunk);
+
+  ChunkCallback m_callback;
+  size_t m_chunk_size;
+
+  std::vector<u8> m_chunk;
+  size_t m_chunk_position = 0;
+  u8* m_current = nullptr;
+
+  std::deque<HeldChunk> m_held_chunks;
+  u32 m_hold_count = 0;
+};
+}  // namespace Common
@@ -54,6 +54,7 @@
 #define REDUMPCACHE_DIR "Redump"
 #define SHADERCACHE_DIR "Shaders"
 #define RETROACHIEVEMENTSCACHE_DIR "RetroAchievements"
+#define SYMBOLCACHE_DIR "Symbols"
 #define STATESAVES_DIR "StateSaves"
 #define SCREENSHOTS_DIR "ScreenShots"
 #define LOAD_DIR "Load"
@@ -123,6 +124,7 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define MEMORYWATCHER_VALUES "Values.bin"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
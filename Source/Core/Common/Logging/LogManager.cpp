@@ -7,10 +7,14 @@
 #include <chrono>
 #include <cstdarg>
 #include <cstring>
+#include <iterator>
 #include <locale>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -20,7 +24,9 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/LogRingBuffer.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 namespace Common::Log
 {
@@ -30,6 +36,8 @@ const Config::Info<bool> LOGGER_WRITE_TO_CONSOLE{
     {Config::System::Logger, "Options", "WriteToConsole"}, true};
 const Config::Info<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
+const Config::Info<bool> LOGGER_ASYNC{{Config::System::Logger, "Options", "Asynchronous"},
+                                      false};
 const Config::Info<LogLevel> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"},
                                               LogLevel::LNOTICE};
 
@@ -61,6 +69,46 @@ private:
   bool m_enable;
 };
 
+// Per-thread buffers for asynchronous logging. They live outside of the LogManager so that
+// a thread's buffer survives the LogManager being shut down and recreated.
+constexpr size_t THREAD_LOG_BUFFER_SIZE = 256 * 1024;
+constexpr auto ASYNC_FLUSH_INTERVAL = std::chrono::milliseconds(20);
+
+namespace
+{
+struct ThreadLogBuffer
+{
+  LogRingBuffer ring{THREAD_LOG_BUFFER_SIZE};
+  std::atomic<bool> thread_exited = false;
+};
+
+struct ThreadLogBufferOwner
+{
+  ~ThreadLogBufferOwner()
+  {
+    if (buffer)
+      buffer->thread_exited.store(true, std::memory_order_release);
+  }
+
+  std::shared_ptr<ThreadLogBuffer> buffer;
+};
+}  // namespace
+
+static std::mutex s_thread_buffers_lock;
+static std::vector<std::shared_ptr<ThreadLogBuffer>> s_thread_buffers;
+
+static LogRingBuffer& GetThreadLogBuffer()
+{
+  thread_local ThreadLogBufferOwner owner;
+  if (!owner.buffer)
+  {
+    owner.buffer = std::make_shared<ThreadLogBuffer>();
+    std::lock_guard lk(s_thread_buffers_lock);
+    s_thread_buffers.push_back(owner.buffer);
+  }
+  return owner.buffer->ring;
+}
+
 void GenericLogFmtImpl(LogLevel level, LogType type, const char* file, int line,
                        fmt::string_view format, const fmt::format_args& args)
 {
@@ -71,8 +119,11 @@ void GenericLogFmtImpl(LogLevel level, LogType type, const char* file, int line,
   if (!instance->IsEnabled(type, level))
     return;
 
-  const auto message = fmt::vformat(format, args);
-  instance->Log(level, type, file, line, message.c_str());
+  // Most messages fit in the inline storage, which avoids a heap allocation per message.
+  fmt::memory_buffer message;
+  fmt::vformat_to(std::back_inserter(message), format, args);
+  message.push_back('\0');
+  instance->Log(level, type, file, line, message.data());
 }
 
 static size_t DeterminePathCutOffPoint()
@@ -169,10 +220,14 @@ LogManager::LogManager()
   }
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  SetAsyncEnabled(Config::Get(LOGGER_ASYNC));
 }
 
 LogManager::~LogManager()
 {
+  SetAsyncEnabled(false);
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -187,6 +242,7 @@ void LogManager::SaveSettings()
                            IsListenerEnabled(LogListener::CONSOLE_LISTENER));
   Config::SetBaseOrCurrent(LOGGER_WRITE_TO_WINDOW,
                            IsListenerEnabled(LogListener::LOG_WINDOW_LISTENER));
+  Config::SetBaseOrCurrent(LOGGER_ASYNC, IsAsyncEnabled());
   Config::SetBaseOrCurrent(LOGGER_VERBOSITY, GetLogLevel());
 
   for (const auto& container : m_log)
@@ -206,23 +262,51 @@ void LogManager::Log(LogLevel level, LogType type, const char* file, int line, c
   LogWithFullPath(level, type, file + m_path_cutoff_point, line, message);
 }
 
-std::string LogManager::GetTimestamp()
+std::string LogManager::GetTimestamp(std::chrono::system_clock::time_point time)
 {
   // NOTE: the Qt LogWidget hardcodes the expected length of the timestamp portion of the log line,
   // so ensure they stay in sync
 
   // We want milliseconds *and not hours*, so can't directly use STL formatters
-  const auto now = std::chrono::system_clock::now();
-  const auto now_s = std::chrono::floor<std::chrono::seconds>(now);
-  const auto now_ms = std::chrono::floor<std::chrono::milliseconds>(now);
-  return fmt::format("{:%M:%S}:{:03}", now_s, (now_ms - now_s).count());
+  const auto time_s = std::chrono::floor<std::chrono::seconds>(time);
+  const auto time_ms = std::chrono::floor<std::chrono::milliseconds>(time);
+  return fmt::format("{:%M:%S}:{:03}", time_s, (time_ms - time_s).count());
 }
 
 void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                                  const char* message)
+{
+  const auto now = std::chrono::system_clock::now();
+
+  if (m_async_enabled.load(std::memory_order_relaxed))
+  {
+    // Disabling asynchronous logging waits for pushes that started before it, so that nothing
+    // can be left in a buffer after its final flush. That only works if the flag is checked again
+    // after registering the push.
+    m_async_pushes.fetch_add(1, std::memory_order_seq_cst);
+    if (m_async_enabled.load(std::memory_order_seq_cst))
+    {
+      LogRingBuffer& ring = GetThreadLogBuffer();
+      ring.Push({now, file, static_cast<u32>(line), 0, level, type}, message);
+
+      // Don't wait for the next periodic flush if this thread is logging heavily.
+      if (ring.GetUsedSize() > ring.GetCapacity() / 2)
+        m_writer_event.Set();
+      m_async_pushes.fetch_sub(1, std::memory_order_release);
+      return;
+    }
+    m_async_pushes.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  DispatchToListeners(now, level, type, file, line, message);
+}
+
+void LogManager::DispatchToListeners(std::chrono::system_clock::time_point time, LogLevel level,
+                                     LogType type, const char* file, int line,
+                                     std::string_view message)
 {
   const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(), file, line,
+      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(time), file, line,
                   LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
 
   for (const auto listener_id : m_listener_ids)
@@ -232,6 +316,102 @@ void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file,
   }
 }
 
+bool LogManager::IsAsyncEnabled() const
+{
+  return m_async_enabled.load(std::memory_order_relaxed);
+}
+
+void LogManager::SetAsyncEnabled(bool enable)
+{
+  if (enable == IsAsyncEnabled())
+    return;
+
+  if (enable)
+  {
+    m_writer_running.Set();
+    m_writer_thread = std::thread(&LogManager::WriterThreadFunc, this);
+    m_async_enabled.store(true, std::memory_order_relaxed);
+  }
+  else
+  {
+    m_async_enabled.store(false, std::memory_order_seq_cst);
+    while (m_async_pushes.load(std::memory_order_seq_cst) != 0)
+      std::this_thread::yield();
+
+    m_writer_running.Clear();
+    m_writer_event.Set();
+    m_writer_thread.join();
+    Flush();
+  }
+}
+
+u64 LogManager::GetDroppedMessageCount() const
+{
+  return m_dropped_messages.load(std::memory_order_relaxed);
+}
+
+void LogManager::WriterThreadFunc()
+{
+  Common::SetCurrentThreadName("Log Writer");
+
+  while (m_writer_running.IsSet())
+  {
+    m_writer_event.WaitFor(ASYNC_FLUSH_INTERVAL);
+    Flush();
+  }
+}
+
+void LogManager::Flush()
+{
+  std::lock_guard flush_lk(m_flush_lock);
+
+  std::vector<std::shared_ptr<ThreadLogBuffer>> buffers;
+  {
+    std::lock_guard lk(s_thread_buffers_lock);
+    std::erase_if(s_thread_buffers, [](const auto& buffer) {
+      return buffer->thread_exited.load(std::memory_order_acquire) && buffer->ring.IsEmpty();
+    });
+    buffers = s_thread_buffers;
+  }
+
+  u64 dropped = 0;
+  for (const auto& buffer : buffers)
+    dropped += buffer->ring.TakeDroppedCount();
+  if (dropped != 0)
+  {
+    m_dropped_messages.fetch_add(dropped, std::memory_order_relaxed);
+    DispatchToListeners(std::chrono::system_clock::now(), LogLevel::LWARNING, LogType::COMMON,
+                        __FILE__ + m_path_cutoff_point, __LINE__,
+                        fmt::format("Log buffers full, dropped {} messages", dropped));
+  }
+
+  // Merge the per-thread buffers by timestamp so that the output stays in order.
+  while (true)
+  {
+    LogRingBuffer* oldest_ring = nullptr;
+    auto oldest_time = std::chrono::system_clock::time_point::max();
+    for (const auto& buffer : buffers)
+    {
+      buffer->ring.Peek([&](const LogRecordHeader& header, std::string_view) {
+        if (header.timestamp < oldest_time)
+        {
+          oldest_time = header.timestamp;
+          oldest_ring = &buffer->ring;
+        }
+      });
+    }
+
+    if (!oldest_ring)
+      break;
+
+    oldest_ring->Peek([this](const LogRecordHeader& header, std::string_view message) {
+      DispatchToListeners(header.timestamp, header.level, header.type, header.file,
+                          static_cast<int>(header.line), message);
+    });
+    oldest_ring->Pop();
+  }
+}
+
 LogLevel LogManager::GetLogLevel() const
 {
   return m_level;
@@ -274,6 +454,8 @@ const char* LogManager::GetFullName(LogType type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  // Don't pull a listener out from under the log writer thread.
+  std::lock_guard lk(m_flush_lock);
   m_listeners[id] = listener;
 }
 
@@ -4,12 +4,20 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 
 #include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 
 namespace Common::Log
@@ -39,6 +47,7 @@ public:
   static void Shutdown();
 
   void Log(LogLevel level, LogType type, const char* file, int line, const char* message);
+  // When asynchronous logging is enabled, file must have static lifetime.
   void LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                        const char* message);
 
@@ -57,6 +66,16 @@ public:
   void EnableListener(LogListener::LISTENER id, bool enable);
   bool IsListenerEnabled(LogListener::LISTENER id) const;
 
+  // In asynchronous mode, messages are copied into a per-thread ring buffer and a background
+  // thread formats them and hands them to the listeners. Messages are dropped (and counted)
+  // rather than blocking the logging thread when its buffer is full.
+  bool IsAsyncEnabled() const;
+  void SetAsyncEnabled(bool enable);
+  u64 GetDroppedMessageCount() const;
+
+  // Writes out all messages queued by asynchronous logging.
+  void Flush();
+
   void SaveSettings();
 
 private:
@@ -75,12 +94,27 @@ private:
   LogManager(LogManager&&) = delete;
   LogManager& operator=(LogManager&&) = delete;
 
-  static std::string GetTimestamp();
+  static std::string GetTimestamp(std::chrono::system_clock::time_point time);
+
+  void DispatchToListeners(std::chrono::system_clock::time_point time, LogLevel level,
+                           LogType type, const char* file, int line, std::string_view message);
+  void WriterThreadFunc();
 
   LogLevel m_level;
   EnumMap<LogContainer, LAST_LOG_TYPE> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  std::atomic<bool> m_async_enabled = false;
+  // Number of threads that are pushing a message into their buffer right now
+  std::atomic<u32> m_async_pushes = 0;
+  std::atomic<u64> m_dropped_messages = 0;
+  std::thread m_writer_thread;
+  Common::Flag m_writer_running;
+  Common::Event m_writer_event;
+  // Held while draining the thread buffers, so that only one thread consumes them at a time
+  // and listeners aren't replaced while they are being written to.
+  std::mutex m_flush_lock;
 };
 }  // namespace Common::Log
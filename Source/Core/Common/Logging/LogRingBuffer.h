@@ -0,0 +1,162 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// A lock-free, single producer, single consumer ring of variable-length log records.
+// Each emulation thread owns one of these and the log writer thread drains them.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::Log
+{
+struct LogRecordHeader
+{
+  std::chrono::system_clock::time_point timestamp;
+  // Must point to storage with static lifetime (normally a __FILE__ literal).
+  const char* file;
+  u32 line;
+  u16 length;
+  LogLevel level;
+  LogType type;
+};
+
+class LogRingBuffer
+{
+public:
+  static constexpr size_t ALIGNMENT = alignof(LogRecordHeader);
+
+  // capacity must be a power of two.
+  explicit LogRingBuffer(size_t capacity)
+      : m_buffer(std::make_unique<u8[]>(capacity)), m_capacity(capacity)
+  {
+  }
+
+  LogRingBuffer(const LogRingBuffer&) = delete;
+  LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+  size_t GetCapacity() const { return m_capacity; }
+  size_t GetMaxMessageLength() const
+  {
+    return std::min<size_t>(m_capacity / 4 - sizeof(LogRecordHeader), UINT16_MAX);
+  }
+
+  // Producer side. Messages longer than GetMaxMessageLength() are truncated.
+  // Returns false (and counts the record as dropped) if the ring is full.
+  bool Push(const LogRecordHeader& header, std::string_view message)
+  {
+    message = message.substr(0, GetMaxMessageLength());
+    const size_t size = RecordSize(message.size());
+
+    const u64 write = m_write.load(std::memory_order_relaxed);
+    const u64 read = m_read.load(std::memory_order_acquire);
+    const size_t padding = PaddingBefore(write, size);
+    if (write - read + padding + size > m_capacity)
+    {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    if (padding >= sizeof(LogRecordHeader))
+    {
+      const LogRecordHeader marker{};
+      std::memcpy(&m_buffer[write & (m_capacity - 1)], &marker, sizeof(marker));
+    }
+
+    u8* const record = &m_buffer[(write + padding) & (m_capacity - 1)];
+    LogRecordHeader stored = header;
+    if (stored.file == nullptr)
+      stored.file = "";
+    stored.length = static_cast<u16>(message.size());
+    std::memcpy(record, &stored, sizeof(stored));
+    std::memcpy(record + sizeof(stored), message.data(), message.size());
+
+    m_write.store(write + padding + size, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Calls func(const LogRecordHeader&, std::string_view) for the oldest record
+  // without removing it. Returns false if the ring is empty.
+  template <typename Func>
+  bool Peek(Func&& func) const
+  {
+    const u64 read = m_read.load(std::memory_order_relaxed);
+    const u64 write = m_write.load(std::memory_order_acquire);
+    if (read == write)
+      return false;
+
+    const u8* const record = &m_buffer[(read + PaddingAt(read)) & (m_capacity - 1)];
+    LogRecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    func(header, std::string_view(reinterpret_cast<const char*>(record + sizeof(header)),
+                                  header.length));
+    return true;
+  }
+
+  void Pop()
+  {
+    const u64 read = m_read.load(std::memory_order_relaxed);
+    const u64 offset = read + PaddingAt(read);
+    LogRecordHeader header;
+    std::memcpy(&header, &m_buffer[offset & (m_capacity - 1)], sizeof(header));
+    m_read.store(offset + RecordSize(header.length), std::memory_order_release);
+  }
+
+  bool IsEmpty() const
+  {
+    return m_read.load(std::memory_order_relaxed) == m_write.load(std::memory_order_acquire);
+  }
+
+  size_t GetUsedSize() const
+  {
+    return static_cast<size_t>(m_write.load(std::memory_order_acquire) -
+                               m_read.load(std::memory_order_acquire));
+  }
+
+  // Returns the number of records dropped since the last call.
+  u64 TakeDroppedCount() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+  static constexpr size_t RecordSize(size_t message_length)
+  {
+    return (sizeof(LogRecordHeader) + message_length + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  // Records never wrap around the end of the buffer. A record that doesn't fit in the
+  // remaining space is written at the start instead, and the tail is skipped.
+  size_t PaddingBefore(u64 position, size_t size) const
+  {
+    const size_t tail = m_capacity - (position & (m_capacity - 1));
+    return size > tail ? tail : 0;
+  }
+
+  // The consumer can't know the size of the next record before reading its header, so the
+  // producer writes a zero-length marker record into any tail that is large enough to hold one.
+  size_t PaddingAt(u64 position) const
+  {
+    const size_t offset = position & (m_capacity - 1);
+    const size_t tail = m_capacity - offset;
+    if (tail < sizeof(LogRecordHeader))
+      return tail;
+    LogRecordHeader header;
+    std::memcpy(&header, &m_buffer[offset], sizeof(header));
+    return header.file == nullptr ? tail : 0;
+  }
+
+  std::unique_ptr<u8[]> m_buffer;
+  size_t m_capacity;
+
+  alignas(64) std::atomic<u64> m_write{0};
+  alignas(64) std::atomic<u64> m_read{0};
+  alignas(64) std::atomic<u64> m_dropped{0};
+};
+}  // namespace Common::Log
@@ -0,0 +1,200 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <string>
+
+#include "Common/CommonFuncs.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path, Mode mode, size_t size)
+{
+  Close();
+
+  const bool writable = mode == Mode::ReadWrite;
+  const DWORD access = writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+  const DWORD creation = writable && size != 0 ? OPEN_ALWAYS : OPEN_EXISTING;
+  HANDLE file = CreateFileW(UTF8ToWString(path).c_str(), access, FILE_SHARE_READ, nullptr,
+                            creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open {} for mapping: {}", path, GetLastErrorString());
+    return false;
+  }
+  m_file_handle = file;
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size))
+  {
+    Close();
+    return false;
+  }
+
+  if (writable && size != 0 && static_cast<u64>(file_size.QuadPart) != size)
+  {
+    file_size.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file, file_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to resize {}: {}", path, GetLastErrorString());
+      Close();
+      return false;
+    }
+  }
+
+  if (file_size.QuadPart == 0)
+  {
+    Close();
+    return false;
+  }
+
+  m_mapping_handle = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                        0, 0, nullptr);
+  if (!m_mapping_handle)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to create mapping for {}: {}", path, GetLastErrorString());
+    Close();
+    return false;
+  }
+
+  m_data = static_cast<u8*>(
+      MapViewOfFile(m_mapping_handle, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+  if (!m_data)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to map {}: {}", path, GetLastErrorString());
+    Close();
+    return false;
+  }
+
+  m_size = static_cast<size_t>(file_size.QuadPart);
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping_handle)
+    CloseHandle(m_mapping_handle);
+  if (m_file_handle)
+    CloseHandle(m_file_handle);
+
+  m_data = nullptr;
+  m_mapping_handle = nullptr;
+  m_file_handle = nullptr;
+  m_size = 0;
+}
+
+bool MappedFile::Flush(size_t offset, size_t length)
+{
+  if (!m_data || offset >= m_size)
+    return false;
+
+  length = std::min(length, m_size - offset);
+  return FlushViewOfFile(m_data + offset, length) && FlushFileBuffers(m_file_handle);
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path, Mode mode, size_t size)
+{
+  Close();
+
+  const bool writable = mode == Mode::ReadWrite;
+  int flags = writable ? O_RDWR : O_RDONLY;
+  if (writable && size != 0)
+    flags |= O_CREAT;
+
+  m_fd = open(path.c_str(), flags | O_CLOEXEC, 0644);
+  if (m_fd < 0)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open {} for mapping: {}", path, LastStrerrorString());
+    return false;
+  }
+
+  struct stat file_info;
+  if (fstat(m_fd, &file_info) != 0)
+  {
+    Close();
+    return false;
+  }
+
+  size_t file_size = static_cast<size_t>(file_info.st_size);
+  if (writable && size != 0 && file_size != size)
+  {
+    if (ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to resize {}: {}", path, LastStrerrorString());
+      Close();
+      return false;
+    }
+    file_size = size;
+  }
+
+  if (file_size == 0)
+  {
+    Close();
+    return false;
+  }
+
+  void* const data = mmap(nullptr, file_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                          MAP_SHARED, m_fd, 0);
+  if (data == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to map {}: {}", path, LastStrerrorString());
+    Close();
+    return false;
+  }
+
+  m_data = static_cast<u8*>(data);
+  m_size = file_size;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (m_data)
+    munmap(m_data, m_size);
+  if (m_fd >= 0)
+    close(m_fd);
+
+  m_data = nullptr;
+  m_fd = -1;
+  m_size = 0;
+}
+
+bool MappedFile::Flush(size_t offset, size_t length)
+{
+  if (!m_data || offset >= m_size)
+    return false;
+
+  // msync requires a page aligned address.
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t aligned_offset = offset & ~(page_size - 1);
+  length = std::min(length, m_size - offset) + (offset - aligned_offset);
+  return msync(m_data + aligned_offset, length, MS_SYNC) == 0;
+}
+
+#endif
+}  // namespace Common
@@ -0,0 +1,55 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// A file that is mapped into the address space of the process, so that it can be read and
+// written like regular memory. Writes to a read-write mapping reach the file when the OS
+// writes back the pages or when Flush() is called.
+class MappedFile final
+{
+public:
+  enum class Mode
+  {
+    Read,
+    ReadWrite,
+  };
+
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  // Maps the file at path. In ReadWrite mode with a non-zero size, the file is created if it
+  // doesn't exist and resized to size if needed; otherwise the whole existing file is mapped.
+  bool Open(const std::string& path, Mode mode, size_t size = 0);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  u8* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+
+  // Synchronously writes back the pages of a ReadWrite mapping that cover the given range.
+  bool Flush(size_t offset, size_t length);
+
+private:
+#ifdef _WIN32
+  void* m_file_handle = nullptr;
+  void* m_mapping_handle = nullptr;
+#else
+  int m_fd = -1;
+#endif
+  u8* m_data = nullptr;
+  size_t m_size = 0;
+};
+}  // namespace Common
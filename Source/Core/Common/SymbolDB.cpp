@@ -3,6 +3,7 @@
 
 #include "Common/SymbolDB.h"
 
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <string>
@@ -52,6 +53,7 @@ void SymbolDB::Clear(const char* prefix)
   // TODO: honor prefix
   m_functions.clear();
   m_checksum_to_function.clear();
+  InvalidateAddressIndex();
 }
 
 void SymbolDB::Index()
@@ -109,5 +111,36 @@ std::vector<Symbol*> SymbolDB::GetSymbolsFromHash(u32 hash)
 void SymbolDB::AddCompleteSymbol(const Symbol& symbol)
 {
   m_functions.emplace(symbol.address, symbol);
+  InvalidateAddressIndex();
+}
+
+Symbol* SymbolDB::GetSymbolStartingAtOrBefore(u32 addr)
+{
+  if (!m_address_index_valid.load(std::memory_order_acquire))
+    BuildAddressIndex();
+
+  const auto iter = std::upper_bound(m_address_index.begin(), m_address_index.end(), addr);
+  if (iter == m_address_index.begin())
+    return nullptr;
+  return m_address_index_symbols[iter - m_address_index.begin() - 1];
+}
+
+void SymbolDB::BuildAddressIndex()
+{
+  std::lock_guard lk(m_address_index_lock);
+  if (m_address_index_valid.load(std::memory_order_relaxed))
+    return;
+
+  m_address_index.clear();
+  m_address_index_symbols.clear();
+  m_address_index.reserve(m_functions.size());
+  m_address_index_symbols.reserve(m_functions.size());
+  for (auto& [address, symbol] : m_functions)
+  {
+    m_address_index.push_back(address);
+    m_address_index_symbols.push_back(&symbol);
+  }
+
+  m_address_index_valid.store(true, std::memory_order_release);
 }
 }  // namespace Common
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <string_view>
@@ -85,14 +87,35 @@ public:
   std::vector<Symbol*> GetSymbolsFromHash(u32 hash);
 
   const XFuncMap& Symbols() const { return m_functions; }
-  XFuncMap& AccessSymbols() { return m_functions; }
+  XFuncMap& AccessSymbols()
+  {
+    InvalidateAddressIndex();
+    return m_functions;
+  }
   bool IsEmpty() const;
   void Clear(const char* prefix = "");
   void List();
   void Index();
 
 protected:
+  // Must be called whenever symbols are added to or removed from m_functions.
+  void InvalidateAddressIndex() { m_address_index_valid.store(false, std::memory_order_release); }
+
+  // Returns the symbol with the highest start address that is not above addr, if any.
+  // This is a binary search over a flat array, so it is cheap enough for hot paths.
+  Symbol* GetSymbolStartingAtOrBefore(u32 addr);
+
   XFuncMap m_functions;
   XFuncPtrMap m_checksum_to_function;
+
+private:
+  void BuildAddressIndex();
+
+  // Start addresses of all symbols in ascending order, and the matching symbols. Rebuilt lazily
+  // after m_functions changed.
+  std::vector<u32> m_address_index;
+  std::vector<Symbol*> m_address_index_symbols;
+  std::atomic<bool> m_address_index_valid = false;
+  std::mutex m_address_index_lock;
 };
 }  // namespace Common
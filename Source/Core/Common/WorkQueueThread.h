@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -10,10 +11,12 @@
 #include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 #include "Common/Thread.h"
 
 // A thread that executes the given function for every item placed into its queue.
+// Optionally, several threads can share the queue, in which case items are processed in parallel.
 
 namespace Common
 {
@@ -22,22 +25,25 @@ class WorkQueueThread
 {
 public:
   WorkQueueThread() = default;
-  WorkQueueThread(const std::string_view name, std::function<void(T)> function)
+  WorkQueueThread(const std::string_view name, std::function<void(T)> function,
+                  std::size_t thread_count = 1)
   {
-    Reset(name, std::move(function));
+    Reset(name, std::move(function), thread_count);
   }
   ~WorkQueueThread() { Shutdown(); }
 
-  // Shuts the current work thread down (if any) and starts a new thread with the given function
+  // Shuts the current work threads down (if any) and starts new threads with the given function
   // Note: Some consumers of this API push items to the queue before starting the thread.
-  void Reset(const std::string_view name, std::function<void(T)> function)
+  void Reset(const std::string_view name, std::function<void(T)> function,
+             std::size_t thread_count = 1)
   {
     Shutdown();
     std::lock_guard lg(m_lock);
     m_thread_name = name;
     m_shutdown = false;
     m_function = std::move(function);
-    m_thread = std::thread(&WorkQueueThread::ThreadLoop, this);
+    for (std::size_t i = 0; i < std::max<std::size_t>(thread_count, 1); ++i)
+      m_threads.emplace_back(&WorkQueueThread::ThreadLoop, this);
   }
 
   // Adds an item to the work queue
@@ -87,7 +93,7 @@ public:
 
     m_cancelling = true;
     m_items = std::queue<T>();
-    m_worker_cond_var.notify_one();
+    m_worker_cond_var.notify_all();
   }
 
   // Tells the worker to shut down when it's queue is empty
@@ -98,7 +104,7 @@ public:
   {
     {
       std::unique_lock lg(m_lock);
-      if (m_shutdown || !m_thread.joinable())
+      if (m_shutdown || m_threads.empty())
         return;
 
       if (cancel)
@@ -108,10 +114,12 @@ public:
       }
 
       m_shutdown = true;
-      m_worker_cond_var.notify_one();
+      m_worker_cond_var.notify_all();
     }
 
-    m_thread.join();
+    for (std::thread& thread : m_threads)
+      thread.join();
+    m_threads.clear();
   }
 
   // Blocks until all items in the queue have been processed (or cancelled)
@@ -135,36 +143,46 @@ private:
   {
     Common::SetCurrentThreadName(m_thread_name.c_str());
 
+    std::unique_lock lg(m_lock);
     while (true)
     {
-      std::unique_lock lg(m_lock);
       while (m_items.empty())
       {
-        m_idle = true;
-        m_cancelling = false;
-        m_wait_cond_var.notify_all();
+        // The queue is only idle once the other workers are done with their items too.
+        if (m_busy_workers == 0)
+        {
+          m_idle = true;
+          m_cancelling = false;
+          m_wait_cond_var.notify_all();
+        }
         if (m_shutdown)
           return;
 
-        m_worker_cond_var.wait(
-            lg, [&] { return !m_items.empty() || m_shutdown || m_cancelling.load(); });
+        m_worker_cond_var.wait(lg, [&] {
+          return !m_items.empty() || m_shutdown || (m_cancelling.load() && m_busy_workers == 0);
+        });
       }
       T item{std::move(m_items.front())};
       m_items.pop();
+      ++m_busy_workers;
       lg.unlock();
 
       m_function(std::move(item));
+
+      lg.lock();
+      --m_busy_workers;
     }
   }
 
   std::function<void(T)> m_function;
   std::string m_thread_name;
-  std::thread m_thread;
+  std::vector<std::thread> m_threads;
   std::mutex m_lock;
   std::queue<T> m_items;
   std::condition_variable m_wait_cond_var;
   std::condition_variable m_worker_cond_var;
   std::atomic<bool> m_cancelling = false;
+  std::size_t m_busy_workers = 0;
   bool m_idle = true;
   bool m_shutdown = false;
 };
@@ -3,11 +3,17 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
 #include <bit>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -15,6 +21,7 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/Core.h"
@@ -23,6 +30,8 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
+Cheats::MemoryReader::~MemoryReader() = default;
+
 Cheats::DataType Cheats::GetDataType(const Cheats::SearchValue& value)
 {
   // sanity checks that our enum matches with our std::variant
@@ -198,19 +207,16 @@ TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
 {
   return PowerPC::MMU::HostTryReadF64(guard, addr, space);
 }
-}  // namespace
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+constexpr u32 PAGE_SHIFT = 12;
+static_assert(PowerPC::HW_PAGE_SIZE == 1 << PAGE_SHIFT);
+
+Cheats::SearchErrorCode CheckSearchPossible(const Core::CPUThreadGuard& guard,
+                                            PowerPC::RequestedAddressSpace address_space)
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
   auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
   const Core::State core_state = Core::GetState(system);
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -219,6 +225,321 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  return Cheats::SearchErrorCode::Success;
+}
+
+class MMUMemoryReader final : public Cheats::MemoryReader
+{
+public:
+  MMUMemoryReader(const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace space)
+      : m_guard(guard), m_space(space)
+  {
+  }
+
+  bool IsRAMAddress(u32 address) const override
+  {
+    return PowerPC::MMU::HostIsRAMAddress(m_guard, address, m_space);
+  }
+
+  std::optional<bool> TryReadBlock(u32 address, std::span<u8> dest) const override
+  {
+    const auto result = PowerPC::MMU::HostTryReadBlock(m_guard, address, dest, m_space);
+    if (!result)
+      return std::nullopt;
+    return result->translated;
+  }
+
+private:
+  const Core::CPUThreadGuard& m_guard;
+  PowerPC::RequestedAddressSpace m_space;
+};
+
+// Copies the given span of emulated memory page by page. Inaccessible pages are left zeroed.
+Cheats::MemorySnapshot::Block SnapshotBlock(const Cheats::MemoryReader& reader, u32 address,
+                                            u32 size, bool* translated)
+{
+  Cheats::MemorySnapshot::Block block{address, size};
+  block.data.resize(size + Cheats::MemorySnapshot::PADDING);
+  const u64 page_count = ((u64(address) + size - 1) >> PAGE_SHIFT) - (address >> PAGE_SHIFT) + 1;
+  block.accessible_pages.resize((page_count + 63) / 64);
+
+  for (u64 offset = 0; offset < size;)
+  {
+    const u64 current = u64(address) + offset;
+    const u64 count = std::min<u64>(size - offset, ((current | PowerPC::HW_PAGE_MASK) + 1) - current);
+    const std::optional<bool> result = reader.TryReadBlock(
+        static_cast<u32>(current), std::span(block.data.data() + offset, count));
+    if (result)
+    {
+      const u64 page = (current >> PAGE_SHIFT) - (address >> PAGE_SHIFT);
+      block.accessible_pages[page / 64] |= u64(1) << (page % 64);
+      *translated = *result;
+    }
+    offset += count;
+  }
+
+  return block;
+}
+
+template <typename T>
+T ReadSlot(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+// Reads a single value like the snapshot would contain it, so values that cross into an
+// inaccessible page are inaccessible.
+template <typename T>
+std::optional<PowerPC::ReadResult<T>> TryReadValue(const Cheats::MemoryReader& reader, u32 address)
+{
+  std::array<u8, sizeof(T)> data;
+  const u32 first_size =
+      std::min<u32>(sizeof(T), PowerPC::HW_PAGE_SIZE - (address & PowerPC::HW_PAGE_MASK));
+  const std::optional<bool> translated =
+      reader.TryReadBlock(address, std::span(data).first(first_size));
+  if (!translated)
+    return std::nullopt;
+  if (first_size < sizeof(T) &&
+      !reader.TryReadBlock(address + first_size, std::span(data).subspan(first_size)))
+  {
+    return std::nullopt;
+  }
+  return PowerPC::ReadResult<T>(*translated, ReadSlot<T>(data.data()));
+}
+
+// Returns a mask of which of the 64 slots starting at the given offset are on accessible pages.
+template <u32 Step>
+u64 GetSlotsOnAccessiblePages(const Cheats::MemorySnapshot::Block& block, u32 offset)
+{
+  const u64 first = u64(block.address) + offset;
+  const u64 last = first + 63 * Step;
+  const u64 first_page = (first >> PAGE_SHIFT) - (block.address >> PAGE_SHIFT);
+  const u64 last_page = (last >> PAGE_SHIFT) - (block.address >> PAGE_SHIFT);
+
+  const bool first_accessible = block.IsPageAccessible(first_page);
+  if (first_page == last_page)
+    return first_accessible ? ~u64(0) : 0;
+
+  // 64 values never span more than two pages.
+  const u64 slots_on_first_page = ((((first >> PAGE_SHIFT) + 1) << PAGE_SHIFT) - first + Step - 1) / Step;
+  const u64 first_mask = (u64(1) << slots_on_first_page) - 1;
+  return (first_accessible ? first_mask : 0) |
+         (block.IsPageAccessible(last_page) ? ~first_mask : 0);
+}
+
+// Returns a mask of which of the 64 values starting at the given offset are fully accessible.
+// Unaligned values can start on an accessible page and end on one that isn't.
+template <typename T, u32 Step>
+u64 GetAccessibleSlots(const Cheats::MemorySnapshot::Block& block, u32 offset)
+{
+  return GetSlotsOnAccessiblePages<Step>(block, offset) &
+         GetSlotsOnAccessiblePages<Step>(block, offset + sizeof(T) - 1);
+}
+
+// The filters compare a whole bitmap word of values at once. The loops are written so that the
+// compiler can turn them into vector compares.
+template <typename T, u32 Step, typename Compare>
+struct CompareWithSpecificValue
+{
+  T value;
+  Compare compare;
+
+  u64 operator()(const u8* data, const u8*) const
+  {
+    u64 result = 0;
+    for (u32 i = 0; i < 64; ++i)
+      result |= u64(compare(ReadSlot<T>(data + i * Step), value)) << i;
+    return result;
+  }
+};
+
+template <typename T, u32 Step, typename Compare>
+struct CompareWithLastValue
+{
+  Compare compare;
+
+  u64 operator()(const u8* data, const u8* old_data) const
+  {
+    u64 result = 0;
+    for (u32 i = 0; i < 64; ++i)
+      result |= u64(compare(ReadSlot<T>(data + i * Step), ReadSlot<T>(old_data + i * Step))) << i;
+    return result;
+  }
+};
+
+struct KeepAll
+{
+  u64 operator()(const u8*, const u8*) const { return ~u64(0); }
+};
+
+template <typename T, typename Func>
+void WithCompareFunction(Cheats::CompareType op, Func func)
+{
+  switch (op)
+  {
+  case Cheats::CompareType::Equal:
+    return func(std::equal_to<T>());
+  case Cheats::CompareType::NotEqual:
+    return func(std::not_equal_to<T>());
+  case Cheats::CompareType::Less:
+    return func(std::less<T>());
+  case Cheats::CompareType::LessOrEqual:
+    return func(std::less_equal<T>());
+  case Cheats::CompareType::Greater:
+    return func(std::greater<T>());
+  case Cheats::CompareType::GreaterOrEqual:
+    return func(std::greater_equal<T>());
+  default:
+    DEBUG_ASSERT(false);
+    return;
+  }
+}
+
+// Filters the candidates of every block of the snapshot on worker threads, and returns how many of
+// the remaining candidates have valid values. Without an old snapshot, this is a new search.
+template <typename T, u32 Step, typename Filter>
+size_t FilterCandidates(const Cheats::MemorySnapshot& snapshot,
+                        const Cheats::MemorySnapshot* old_snapshot,
+                        std::vector<Cheats::CandidateBlock>* blocks, const Filter& filter)
+{
+  struct Chunk
+  {
+    size_t block_index;
+    size_t begin_word;
+    size_t end_word;
+  };
+
+  constexpr size_t CHUNK_WORDS = 0x1000;
+  std::vector<Chunk> chunks;
+  for (size_t i = 0; i < blocks->size(); ++i)
+  {
+    const size_t word_count = (*blocks)[i].bits.size();
+    for (size_t word = 0; word < word_count; word += CHUNK_WORDS)
+      chunks.push_back({i, word, std::min(word + CHUNK_WORDS, word_count)});
+  }
+
+  const auto filter_chunks = [&](size_t first_chunk, size_t chunk_stride) {
+    size_t valid_count = 0;
+    for (size_t i = first_chunk; i < chunks.size(); i += chunk_stride)
+    {
+      const Chunk& chunk = chunks[i];
+      Cheats::CandidateBlock& candidates = (*blocks)[chunk.block_index];
+      const Cheats::MemorySnapshot::Block& block = snapshot.blocks[chunk.block_index];
+      const Cheats::MemorySnapshot::Block* old_block =
+          old_snapshot ? &old_snapshot->blocks[chunk.block_index] : nullptr;
+
+      for (size_t word = chunk.begin_word; word < chunk.end_word; ++word)
+      {
+        const u64 candidate_bits = candidates.bits[word];
+        if (candidate_bits == 0)
+          continue;
+
+        const u32 offset = candidates.first_offset + static_cast<u32>(word * 64 * Step);
+        const u64 accessible = GetAccessibleSlots<T, Step>(block, offset);
+        const u64 passed =
+            filter(block.data.data() + offset, old_block ? old_block->data.data() + offset : nullptr);
+
+        u64 kept;
+        if (old_block)
+        {
+          // Like in NextSearch, results are kept if the value can't be compared.
+          const u64 old_accessible = GetAccessibleSlots<T, Step>(*old_block, offset);
+          kept = candidate_bits & (~accessible | ~old_accessible | passed);
+        }
+        else
+        {
+          kept = candidate_bits & accessible & passed;
+        }
+
+        candidates.bits[word] = kept;
+        valid_count += std::popcount(kept & accessible);
+      }
+    }
+    return valid_count;
+  };
+
+  const size_t thread_count =
+      std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(chunks.size(), 1));
+  if (thread_count == 1)
+    return filter_chunks(0, 1);
+
+  std::vector<std::future<size_t>> futures(thread_count - 1);
+  for (size_t i = 0; i < futures.size(); ++i)
+    futures[i] = std::async(std::launch::async, filter_chunks, i + 1, thread_count);
+
+  size_t valid_count = filter_chunks(0, thread_count);
+  for (auto& future : futures)
+    valid_count += future.get();
+  return valid_count;
+}
+
+template <typename T, u32 Step>
+size_t FilterCandidates(const Cheats::MemorySnapshot& snapshot,
+                        const Cheats::MemorySnapshot* old_snapshot,
+                        std::vector<Cheats::CandidateBlock>* blocks, Cheats::FilterType filter_type,
+                        Cheats::CompareType compare_type, const std::optional<T>& value)
+{
+  size_t valid_count = 0;
+  switch (filter_type)
+  {
+  case Cheats::FilterType::CompareAgainstSpecificValue:
+    WithCompareFunction<T>(compare_type, [&](auto compare) {
+      const CompareWithSpecificValue<T, Step, decltype(compare)> filter{*value, compare};
+      valid_count = FilterCandidates<T, Step>(snapshot, old_snapshot, blocks, filter);
+    });
+    break;
+  case Cheats::FilterType::CompareAgainstLastValue:
+    WithCompareFunction<T>(compare_type, [&](auto compare) {
+      const CompareWithLastValue<T, Step, decltype(compare)> filter{compare};
+      valid_count = FilterCandidates<T, Step>(snapshot, old_snapshot, blocks, filter);
+    });
+    break;
+  case Cheats::FilterType::DoNotFilter:
+    valid_count = FilterCandidates<T, Step>(snapshot, old_snapshot, blocks, KeepAll{});
+    break;
+  }
+  return valid_count;
+}
+
+void CountCandidates(Cheats::CandidateBlock* candidates)
+{
+  constexpr size_t GROUP_WORDS = Cheats::CandidateBlock::GROUP_WORDS;
+  candidates->group_counts.resize((candidates->bits.size() + GROUP_WORDS - 1) / GROUP_WORDS);
+  u32 count = 0;
+  for (size_t word = 0; word < candidates->bits.size(); ++word)
+  {
+    if (word % GROUP_WORDS == 0)
+      candidates->group_counts[word / GROUP_WORDS] = count;
+    count += std::popcount(candidates->bits[word]);
+  }
+  candidates->count = count;
+}
+}  // namespace
+
+bool Cheats::MemorySnapshot::Block::IsPageAccessible(u64 page) const
+{
+  return page / 64 < accessible_pages.size() && ((accessible_pages[page / 64] >> (page % 64)) & 1);
+}
+
+bool Cheats::MemorySnapshot::Block::IsAccessible(u32 offset) const
+{
+  return IsPageAccessible(((u64(address) + offset) >> PAGE_SHIFT) - (address >> PAGE_SHIFT));
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const T& value)>& validator)
+{
+  const Cheats::SearchErrorCode error_code = CheckSearchPossible(guard, address_space);
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
+  std::vector<Cheats::SearchResult<T>> results;
+
   for (const Cheats::MemoryRange& range : memory_ranges)
   {
     if (range.m_length < sizeof(T))
@@ -260,17 +581,10 @@ Cheats::NextSearch(const Core::CPUThreadGuard& guard,
                    PowerPC::RequestedAddressSpace address_space,
                    const std::function<bool(const T& new_value, const T& old_value)>& validator)
 {
-  if (AchievementManager::GetInstance().IsHardcoreModeActive())
-    return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-  auto& system = guard.GetSystem();
+  const Cheats::SearchErrorCode error_code = CheckSearchPossible(guard, address_space);
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
   std::vector<Cheats::SearchResult<T>> results;
-  const Core::State core_state = Core::GetState(system);
-  if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    return Cheats::SearchErrorCode::NoEmulationActive;
-
-  const auto& ppc_state = system.GetPPCState();
-  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
-    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
   for (const auto& previous_result : previous_results)
   {
@@ -372,6 +686,11 @@ void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
   m_search_results.clear();
+  m_candidate_blocks.clear();
+  m_candidate_block_counts.clear();
+  m_snapshot = {};
+  m_valid_count = 0;
+  m_search_prepared = false;
 }
 
 template <typename T>
@@ -425,57 +744,283 @@ MakeCompareFunctionForLastValue(Cheats::CompareType op)
 template <typename T>
 Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPUThreadGuard& guard)
 {
-  if (AchievementManager::GetInstance().IsHardcoreModeActive())
-    return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
-      Cheats::SearchErrorCode::InvalidParameters;
-  if (m_filter_type == FilterType::CompareAgainstSpecificValue)
+  const SearchErrorCode error_code = PrepareSearch(guard);
+  if (error_code != SearchErrorCode::Success)
+    return error_code;
+  return FinishSearch();
+}
+
+template <typename T>
+Cheats::SearchErrorCode
+Cheats::CheatSearchSession<T>::PrepareSearch(const Core::CPUThreadGuard& guard)
+{
+  m_search_prepared = false;
+
+  const SearchErrorCode error_code = CheckSearchPossible(guard, m_address_space);
+  if (error_code != SearchErrorCode::Success)
+    return error_code;
+
+  return PrepareSearch(MMUMemoryReader(guard, m_address_space));
+}
+
+template <typename T>
+Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::PrepareSearch(const MemoryReader& reader)
+{
+  m_search_prepared = false;
+  m_pending_snapshot.reset();
+  m_pending_blocks.clear();
+  m_pending_values.clear();
+
+  if (m_filter_type == FilterType::CompareAgainstSpecificValue && !m_value)
+    return SearchErrorCode::InvalidParameters;
+  if (m_filter_type == FilterType::CompareAgainstLastValue && !m_first_search_done)
+    return SearchErrorCode::InvalidParameters;
+
+  if (m_first_search_done && !IsDense())
   {
-    if (!m_value)
-      return Cheats::SearchErrorCode::InvalidParameters;
+    m_pending_values.reserve(m_search_results.size());
+    for (const SearchResult<T>& result : m_search_results)
+      m_pending_values.push_back(TryReadValue<T>(reader, result.m_address));
+    m_search_prepared = true;
+    return SearchErrorCode::Success;
+  }
 
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
+  MemorySnapshot& snapshot = m_pending_snapshot.emplace();
+  if (m_first_search_done)
+  {
+    // Take the new snapshot in the same layout as the old one, so that values can be compared.
+    snapshot.blocks.reserve(m_snapshot.blocks.size());
+    for (const MemorySnapshot::Block& block : m_snapshot.blocks)
     {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
+      snapshot.blocks.push_back(
+          SnapshotBlock(reader, block.address, block.size, &snapshot.translated));
     }
-    else
+    m_search_prepared = true;
+    return SearchErrorCode::Success;
+  }
+
+  // For a new search, only the accessible parts of the memory ranges are copied.
+  constexpr u32 step = sizeof(T);
+  for (const MemoryRange& range : m_memory_ranges)
+  {
+    if (range.m_length < sizeof(T))
+      continue;
+
+    const u64 range_end = std::min<u64>(u64(range.m_start) + range.m_length, u64(1) << 32);
+
+    u64 address = range.m_start;
+    while (address < range_end)
     {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
+      const u64 page_end = std::min((address | PowerPC::HW_PAGE_MASK) + 1, range_end);
+      if (!reader.IsRAMAddress(static_cast<u32>(address)))
+      {
+        address = page_end;
+        continue;
+      }
+
+      u64 block_end = page_end;
+      while (block_end < range_end && reader.IsRAMAddress(static_cast<u32>(block_end)))
+      {
+        block_end = std::min(block_end + PowerPC::HW_PAGE_SIZE, range_end);
+      }
+
+      const u64 first_value_address = m_aligned ? Common::AlignUp(address, u64(step)) : address;
+      // Values must end in the block too, or they would read past the copied memory
+      const u64 values_end = block_end - sizeof(T) + 1;
+      if (first_value_address < values_end)
+      {
+        CandidateBlock& candidates = m_pending_blocks.emplace_back();
+        candidates.first_offset = static_cast<u32>(first_value_address - address);
+        candidates.slot_count =
+            static_cast<u32>((values_end - first_value_address + (m_aligned ? step : 1) - 1) /
+                             (m_aligned ? step : 1));
+        candidates.bits.assign((candidates.slot_count + 63) / 64, ~u64(0));
+        if (candidates.slot_count % 64 != 0)
+          candidates.bits.back() = (u64(1) << (candidates.slot_count % 64)) - 1;
+
+        snapshot.blocks.push_back(SnapshotBlock(reader, static_cast<u32>(address),
+                                                static_cast<u32>(block_end - address),
+                                                &snapshot.translated));
+      }
+
+      address = block_end;
     }
   }
-  else if (m_filter_type == FilterType::CompareAgainstLastValue)
+
+  m_search_prepared = true;
+  return SearchErrorCode::Success;
+}
+
+template <typename T>
+Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::FinishSearch()
+{
+  if (!m_search_prepared)
+    return SearchErrorCode::InvalidParameters;
+  m_search_prepared = false;
+
+  if (m_pending_snapshot)
+    FinishDenseSearch();
+  else
+    FinishSparseSearch();
+
+  m_pending_snapshot.reset();
+  m_pending_blocks.clear();
+  m_pending_values.clear();
+  m_first_search_done = true;
+
+  if (IsDense() && m_candidate_block_counts.back() <= SPARSE_RESULT_LIMIT)
+    MakeSparse();
+
+  return SearchErrorCode::Success;
+}
+
+template <typename T>
+void Cheats::CheatSearchSession<T>::FinishDenseSearch()
+{
+  const bool new_search = !m_first_search_done;
+  if (new_search)
+    m_candidate_blocks = std::move(m_pending_blocks);
+
+  const MemorySnapshot* old_snapshot = new_search ? nullptr : &m_snapshot;
+  if (m_aligned)
+  {
+    m_valid_count = FilterCandidates<T, sizeof(T)>(*m_pending_snapshot, old_snapshot,
+                                                   &m_candidate_blocks, m_filter_type,
+                                                   m_compare_type, m_value);
+  }
+  else
   {
-    if (!m_first_search_done)
-      return Cheats::SearchErrorCode::InvalidParameters;
+    m_valid_count = FilterCandidates<T, 1>(*m_pending_snapshot, old_snapshot, &m_candidate_blocks,
+                                           m_filter_type, m_compare_type, m_value);
+  }
+
+  m_snapshot = std::move(*m_pending_snapshot);
 
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
+  m_candidate_block_counts.resize(m_candidate_blocks.size());
+  size_t count = 0;
+  for (size_t i = 0; i < m_candidate_blocks.size(); ++i)
+  {
+    CountCandidates(&m_candidate_blocks[i]);
+    count += m_candidate_blocks[i].count;
+    m_candidate_block_counts[i] = count;
   }
-  else if (m_filter_type == FilterType::DoNotFilter)
+}
+
+template <typename T>
+void Cheats::CheatSearchSession<T>::FinishSparseSearch()
+{
+  std::function<bool(const T& new_value, const T& old_value)> validator;
+  if (m_filter_type == FilterType::CompareAgainstSpecificValue)
+  {
+    validator = [func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value)](
+                    const T& new_value, const T& old_value) { return func(new_value); };
+  }
+  else if (m_filter_type == FilterType::CompareAgainstLastValue)
+  {
+    validator = MakeCompareFunctionForLastValue<T>(m_compare_type);
+  }
+  else
   {
-    if (m_first_search_done)
+    validator = [](const T& new_value, const T& old_value) { return true; };
+  }
+
+  std::vector<SearchResult<T>> results;
+  for (size_t i = 0; i < m_search_results.size(); ++i)
+  {
+    const SearchResult<T>& previous_result = m_search_results[i];
+    const auto& current_value = m_pending_values[i];
+    if (!current_value)
     {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
+      auto& r = results.emplace_back();
+      r.m_address = previous_result.m_address;
+      r.m_value_state = SearchResultValueState::AddressNotAccessible;
+      continue;
     }
-    else
+
+    // if the previous state was invalid we always update the value to avoid getting stuck in an
+    // invalid state
+    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
     {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
+      auto& r = results.emplace_back();
+      r.m_value = current_value->value;
+      r.m_value_state = current_value->translated ?
+                            SearchResultValueState::ValueFromVirtualMemory :
+                            SearchResultValueState::ValueFromPhysicalMemory;
+      r.m_address = previous_result.m_address;
     }
   }
+  m_search_results = std::move(results);
+}
 
-  if (result.Succeeded())
+template <typename T>
+void Cheats::CheatSearchSession<T>::MakeSparse()
+{
+  std::vector<SearchResult<T>> results;
+  results.reserve(m_candidate_block_counts.back());
+  for (size_t i = 0; i < m_candidate_blocks.size(); ++i)
   {
-    m_search_results = std::move(*result);
-    m_first_search_done = true;
-    return Cheats::SearchErrorCode::Success;
+    const CandidateBlock& candidates = m_candidate_blocks[i];
+    for (size_t word = 0; word < candidates.bits.size(); ++word)
+    {
+      for (u64 bits = candidates.bits[word]; bits != 0; bits &= bits - 1)
+        results.push_back(GetDenseResult(i, static_cast<u32>(word * 64 + std::countr_zero(bits))));
+    }
   }
 
-  return result.Error();
+  m_search_results = std::move(results);
+  m_candidate_blocks = {};
+  m_candidate_block_counts = {};
+  m_snapshot = {};
+  m_valid_count = 0;
+}
+
+template <typename T>
+std::pair<size_t, u32> Cheats::CheatSearchSession<T>::LocateCandidate(size_t index) const
+{
+  const auto block_iter = std::ranges::upper_bound(m_candidate_block_counts, index);
+  const size_t block_index = block_iter - m_candidate_block_counts.begin();
+  const CandidateBlock& candidates = m_candidate_blocks[block_index];
+  u32 remaining = static_cast<u32>(index - (block_index == 0 ? 0 : *(block_iter - 1)));
+
+  const size_t group = std::ranges::upper_bound(candidates.group_counts, remaining) -
+                       candidates.group_counts.begin() - 1;
+  remaining -= candidates.group_counts[group];
+
+  for (size_t word = group * CandidateBlock::GROUP_WORDS;; ++word)
+  {
+    u64 bits = candidates.bits[word];
+    const u32 count = std::popcount(bits);
+    if (remaining < count)
+    {
+      for (; remaining != 0; --remaining)
+        bits &= bits - 1;
+      return {block_index, static_cast<u32>(word * 64 + std::countr_zero(bits))};
+    }
+    remaining -= count;
+  }
+}
+
+template <typename T>
+Cheats::SearchResult<T> Cheats::CheatSearchSession<T>::GetDenseResult(size_t block_index,
+                                                                      u32 slot) const
+{
+  const MemorySnapshot::Block& block = m_snapshot.blocks[block_index];
+  const u32 offset = m_candidate_blocks[block_index].first_offset +
+                     slot * static_cast<u32>(m_aligned ? sizeof(T) : 1);
+
+  SearchResult<T> result{};
+  result.m_address = block.address + offset;
+  if (block.IsAccessible(offset) && block.IsAccessible(offset + sizeof(T) - 1))
+  {
+    result.m_value = ReadSlot<T>(block.data.data() + offset);
+    result.m_value_state = m_snapshot.translated ? SearchResultValueState::ValueFromVirtualMemory :
+                                                   SearchResultValueState::ValueFromPhysicalMemory;
+  }
+  else
+  {
+    result.m_value_state = SearchResultValueState::AddressNotAccessible;
+  }
+  return result;
 }
 
 template <typename T>
@@ -523,12 +1068,17 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
+  if (IsDense())
+    return m_candidate_block_counts.back();
   return m_search_results.size();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
+  if (IsDense())
+    return m_valid_count;
+
   const auto& results = m_search_results;
   size_t count = 0;
   for (const auto& r : results)
@@ -542,19 +1092,29 @@ size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
+  if (IsDense())
+  {
+    const auto [block_index, slot] = LocateCandidate(index);
+    return GetDenseResult(block_index, slot).m_address;
+  }
   return m_search_results[index].m_address;
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
+  if (IsDense())
+  {
+    const auto [block_index, slot] = LocateCandidate(index);
+    return GetDenseResult(block_index, slot).m_value;
+  }
   return m_search_results[index].m_value;
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
@@ -567,27 +1127,32 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   {
     if constexpr (std::is_same_v<T, float>)
     {
-      return fmt::format("0x{0:08x}", std::bit_cast<s32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", std::bit_cast<s32>(GetResultValue(index)));
     }
     else if constexpr (std::is_same_v<T, double>)
     {
-      return fmt::format("0x{0:016x}", std::bit_cast<s64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", std::bit_cast<s64>(GetResultValue(index)));
     }
     else
     {
       return fmt::format("0x{0:0{1}x}",
-                         std::bit_cast<std::make_unsigned_t<T>>(m_search_results[index].m_value),
+                         std::bit_cast<std::make_unsigned_t<T>>(GetResultValue(index)),
                          sizeof(T) * 2);
     }
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", GetResultValue(index));
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
+  if (IsDense())
+  {
+    const auto [block_index, slot] = LocateCandidate(index);
+    return GetDenseResult(block_index, slot).m_value_state;
+  }
   return m_search_results[index].m_value_state;
 }
 
@@ -607,13 +1172,25 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size_t end_index) const
 {
-  if (begin_index == 0 && end_index >= m_search_results.size())
+  if (begin_index == 0 && end_index >= GetResultCount())
     return Clone();
 
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results.assign(m_search_results.begin() + begin_index,
-                             m_search_results.begin() + end_index);
+  if (IsDense())
+  {
+    c->m_search_results.reserve(end_index - begin_index);
+    for (size_t i = begin_index; i < end_index; ++i)
+    {
+      const auto [block_index, slot] = LocateCandidate(i);
+      c->m_search_results.push_back(GetDenseResult(block_index, slot));
+    }
+  }
+  else
+  {
+    c->m_search_results.assign(m_search_results.begin() + begin_index,
+                               m_search_results.begin() + end_index);
+  }
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
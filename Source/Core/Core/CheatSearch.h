@@ -6,7 +6,9 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -112,6 +114,60 @@ DataType GetDataType(const SearchValue& value);
 // patches or action replay codes.
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
+// Where a search session reads emulated memory from. Sessions normally read it through the MMU
+// while holding the CPU thread, but tests can provide memory of their own.
+class MemoryReader
+{
+public:
+  virtual ~MemoryReader();
+
+  // Whether the page containing the given address is RAM.
+  virtual bool IsRAMAddress(u32 address) const = 0;
+
+  // Copies memory that doesn't cross a page boundary into dest in guest byte order. Returns whether
+  // the address was translated, or std::nullopt if the memory isn't accessible.
+  virtual std::optional<bool> TryReadBlock(u32 address, std::span<u8> dest) const = 0;
+};
+
+// Copy of emulated memory taken while holding the CPU thread, so that searches can compare values
+// on other threads without blocking emulation.
+struct MemorySnapshot
+{
+  // A whole bitmap word of values can be read at the end of a block without bounds checks thanks
+  // to this many zero bytes after the data of every block.
+  static constexpr size_t PADDING = 64 * sizeof(u64);
+
+  struct Block
+  {
+    u32 address;
+    u32 size;
+    // Guest memory in big endian byte order. Bytes on inaccessible pages are zero.
+    std::vector<u8> data;
+    // One bit per page touched by the block, set if the page was accessible.
+    std::vector<u64> accessible_pages;
+
+    bool IsPageAccessible(u64 page) const;
+    bool IsAccessible(u32 offset) const;
+  };
+
+  std::vector<Block> blocks;
+  bool translated = false;
+};
+
+// Candidate addresses of a search while there are many of them, as a bitmap over the possible
+// addresses of one snapshot block.
+struct CandidateBlock
+{
+  // Offset of the first possible address in the snapshot block.
+  u32 first_offset;
+  u32 slot_count;
+  std::vector<u64> bits;
+  // Number of candidates before every group of GROUP_WORDS words of the bitmap, for index lookups.
+  static constexpr size_t GROUP_WORDS = 8;
+  std::vector<u32> group_counts;
+  u32 count = 0;
+};
+
 // Do a new search across the given memory region in the given address space, only keeping values
 // for which the given validator returns true.
 template <typename T>
@@ -148,6 +204,12 @@ public:
   // Run either a new search or a next search based on the current state of this session.
   virtual SearchErrorCode RunSearch(const Core::CPUThreadGuard& guard) = 0;
 
+  // Same as RunSearch, split into copying the values out of emulated memory, which needs the CPU
+  // thread, and filtering the copy, which doesn't. FinishSearch must follow a successful
+  // PrepareSearch before any other member function is called.
+  virtual SearchErrorCode PrepareSearch(const Core::CPUThreadGuard& guard) = 0;
+  virtual SearchErrorCode FinishSearch() = 0;
+
   virtual size_t GetMemoryRangeCount() const = 0;
   virtual MemoryRange GetMemoryRange(size_t index) const = 0;
   virtual PowerPC::RequestedAddressSpace GetAddressSpace() const = 0;
@@ -193,6 +255,12 @@ public:
 
   void ResetResults() override;
   SearchErrorCode RunSearch(const Core::CPUThreadGuard& guard) override;
+  SearchErrorCode PrepareSearch(const Core::CPUThreadGuard& guard) override;
+  SearchErrorCode FinishSearch() override;
+
+  // Same as PrepareSearch, but reads memory from the given reader. Doesn't check whether emulation
+  // is running.
+  SearchErrorCode PrepareSearch(const MemoryReader& reader);
 
   size_t GetMemoryRangeCount() const override;
   MemoryRange GetMemoryRange(size_t index) const override;
@@ -217,7 +285,32 @@ public:
                                                        size_t end_index) const override;
 
 private:
+  // Once a search leaves at most this many results, they are stored as a plain list instead of as
+  // bitmaps over a memory snapshot.
+  static constexpr size_t SPARSE_RESULT_LIMIT = 0x10000;
+
+  bool IsDense() const { return !m_candidate_blocks.empty(); }
+  std::pair<size_t, u32> LocateCandidate(size_t index) const;
+  SearchResult<T> GetDenseResult(size_t block_index, u32 slot) const;
+  void FinishDenseSearch();
+  void FinishSparseSearch();
+  void MakeSparse();
+
+  // Results while there are many of them. The values are in the snapshot of the last search.
+  std::vector<CandidateBlock> m_candidate_blocks;
+  std::vector<size_t> m_candidate_block_counts;
+  MemorySnapshot m_snapshot;
+  size_t m_valid_count = 0;
+
+  // Results once there are only few of them.
   std::vector<SearchResult<T>> m_search_results;
+
+  // Data read by PrepareSearch.
+  std::optional<MemorySnapshot> m_pending_snapshot;
+  std::vector<CandidateBlock> m_pending_blocks;
+  std::vector<std::optional<PowerPC::ReadResult<T>>> m_pending_values;
+  bool m_search_prepared = false;
+
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
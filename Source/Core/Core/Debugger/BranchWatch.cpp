@@ -4,8 +4,10 @@
 #include "Core/Debugger/BranchWatch.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
+#include <memory>
 
 #include <fmt/format.h>
 
@@ -27,6 +29,69 @@ void BranchWatch::Clear(const CPUThreadGuard&)
   m_collection_pf.clear();
   m_recording_phase = Phase::Blacklist;
   m_blacklist_size = 0;
+
+  // The counters stay assigned to their branches, since JIT code still refers to them.
+  const u32 counter_count = m_counter_count.load(std::memory_order_acquire);
+  for (u32 i = 0; i < counter_count; ++i)
+  {
+    m_counters[i].store(0, std::memory_order_relaxed);
+    m_counter_slots[i].folded = false;
+  }
+}
+
+std::size_t BranchWatch::GetCollectionSize() const
+{
+  std::size_t size = m_collection_vt.size() + m_collection_vf.size() + m_collection_pt.size() +
+                     m_collection_pf.size();
+
+  // Counters which have been hit but not folded yet are branches that will be added to the
+  // Collections by the next fold. A branch that was also recorded through one of the HitXX
+  // functions is counted twice until then.
+  const u32 counter_count = m_counter_count.load(std::memory_order_acquire);
+  for (u32 i = 0; i < counter_count; ++i)
+  {
+    if (!m_counter_slots[i].folded && m_counters[i].load(std::memory_order_relaxed) != 0)
+      ++size;
+  }
+  return size;
+}
+
+std::atomic<u64>* BranchWatch::GetCounter(u32 origin, u32 destination, UGeckoInstruction inst,
+                                          bool is_virtual, bool condition)
+{
+  auto& indices = m_counter_indices[(is_virtual << 1) | condition];
+  const BranchWatchCollectionKey key{{origin, destination}, inst};
+  if (const auto iter = indices.find(key); iter != indices.end())
+    return &m_counters[iter->second];
+
+  const u32 index = m_counter_count.load(std::memory_order_relaxed);
+  if (index == COUNTER_CAPACITY)
+    return nullptr;
+  if (!m_counters)
+  {
+    m_counters = std::make_unique<std::atomic<u64>[]>(COUNTER_CAPACITY);
+    m_counter_slots = std::make_unique<CounterSlot[]>(COUNTER_CAPACITY);
+  }
+
+  m_counter_slots[index] = {key, is_virtual, condition, false};
+  indices.emplace(key, index);
+  m_counter_count.store(index + 1, std::memory_order_release);
+  return &m_counters[index];
+}
+
+void BranchWatch::FoldCounters(const CPUThreadGuard&)
+{
+  const u32 counter_count = m_counter_count.load(std::memory_order_acquire);
+  for (u32 i = 0; i < counter_count; ++i)
+  {
+    CounterSlot& slot = m_counter_slots[i];
+    if (slot.folded || m_counters[i].load(std::memory_order_relaxed) == 0)
+      continue;
+    Collection::value_type& kv =
+        *GetCollection(slot.is_virtual, slot.condition).try_emplace(slot.key).first;
+    kv.second.counter = &m_counters[i];
+    slot.folded = true;
+  }
 }
 
 // This is a bitfield aggregate of metadata required to reconstruct a BranchWatch's Collections and
@@ -59,7 +124,7 @@ union USnapshotMetadata
   }
 };
 
-void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
+void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file)
 {
   if (!CanSave())
   {
@@ -69,6 +134,8 @@ void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
   if (file == nullptr)
     return;
 
+  FoldCounters(guard);
+
   const auto routine = [&](const Collection& collection, bool is_virtual, bool condition) {
     for (const Collection::value_type& kv : collection)
     {
@@ -76,7 +143,7 @@ void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
           m_selection.begin(), m_selection.end(),
           [&](const Selection::value_type& value) { return value.collection_ptr == &kv; });
       fmt::println(file, "{:08x} {:08x} {:08x} {} {} {:x}", kv.first.origin_addr,
-                   kv.first.destin_addr, kv.first.original_inst.hex, kv.second.total_hits,
+                   kv.first.destin_addr, kv.first.original_inst.hex, kv.second.GetTotalHits(),
                    kv.second.hits_snapshot,
                    iter == m_selection.end() ?
                        USnapshotMetadata(is_virtual, condition, false, {}).hex :
@@ -129,8 +196,9 @@ void BranchWatch::Load(const CPUThreadGuard& guard, std::FILE* file)
     m_recording_phase = Phase::Reduction;
 }
 
-void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
+void BranchWatch::IsolateHasExecuted(const CPUThreadGuard& guard)
 {
+  FoldCounters(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -144,7 +212,7 @@ void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
           // TODO C++20: Parenthesized initialization of aggregates has bad compiler support.
           m_selection.emplace_back(
               BranchWatchSelectionValueType{&kv, is_virtual, condition, SelectionInspection{}});
-          kv.second.hits_snapshot = kv.second.total_hits;
+          kv.second.hits_snapshot = kv.second.GetTotalHits();
         }
       }
     };
@@ -158,24 +226,25 @@ void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
   case Phase::Reduction:
     std::erase_if(m_selection, [](const Selection::value_type& value) -> bool {
       Collection::value_type* const kv = value.collection_ptr;
-      if (kv->second.total_hits == kv->second.hits_snapshot)
+      if (kv->second.GetTotalHits() == kv->second.hits_snapshot)
         return true;
-      kv->second.hits_snapshot = kv->second.total_hits;
+      kv->second.hits_snapshot = kv->second.GetTotalHits();
       return false;
     });
     return;
   }
 }
 
-void BranchWatch::IsolateNotExecuted(const CPUThreadGuard&)
+void BranchWatch::IsolateNotExecuted(const CPUThreadGuard& guard)
 {
+  FoldCounters(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
   {
     const auto routine = [&](Collection& collection) {
       for (Collection::value_type& kv : collection)
-        kv.second.hits_snapshot = kv.second.total_hits;
+        kv.second.hits_snapshot = kv.second.GetTotalHits();
     };
     routine(m_collection_vt);
     routine(m_collection_vf);
@@ -187,9 +256,9 @@ void BranchWatch::IsolateNotExecuted(const CPUThreadGuard&)
   case Phase::Reduction:
     std::erase_if(m_selection, [](const Selection::value_type& value) -> bool {
       Collection::value_type* const kv = value.collection_ptr;
-      if (kv->second.total_hits != kv->second.hits_snapshot)
+      if (kv->second.GetTotalHits() != kv->second.hits_snapshot)
         return true;
-      kv->second.hits_snapshot = kv->second.total_hits;
+      kv->second.hits_snapshot = kv->second.GetTotalHits();
       return false;
     });
     return;
@@ -203,6 +272,7 @@ void BranchWatch::IsolateWasOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+  FoldCounters(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -251,6 +321,7 @@ void BranchWatch::IsolateNotOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+  FoldCounters(guard);
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -294,7 +365,7 @@ void BranchWatch::UpdateHitsSnapshot()
   {
   case Phase::Reduction:
     for (Selection::value_type& value : m_selection)
-      value.collection_ptr->second.hits_snapshot = value.collection_ptr->second.total_hits;
+      value.collection_ptr->second.hits_snapshot = value.collection_ptr->second.GetTotalHits();
     return;
   case Phase::Blacklist:
     return;
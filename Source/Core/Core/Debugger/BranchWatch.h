@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <bit>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -36,6 +39,14 @@ struct BranchWatchCollectionValue
 {
   std::size_t total_hits = 0;
   std::size_t hits_snapshot = 0;
+  // Hits recorded by JIT code are counted here instead of in total_hits (see
+  // BranchWatch::GetCounter). This is read without locking, so it can be done while the CPU runs.
+  const std::atomic<u64>* counter = nullptr;
+
+  std::size_t GetTotalHits() const
+  {
+    return total_hits + (counter ? counter->load(std::memory_order_relaxed) : 0);
+  }
 };
 }  // namespace Core
 
@@ -122,7 +133,7 @@ public:
   void Pause() { SetRecordingActive(false); }
   void Clear(const CPUThreadGuard& guard);
 
-  void Save(const CPUThreadGuard& guard, std::FILE* file) const;
+  void Save(const CPUThreadGuard& guard, std::FILE* file);
   void Load(const CPUThreadGuard& guard, std::FILE* file);
 
   void IsolateHasExecuted(const CPUThreadGuard& guard);
@@ -136,11 +147,7 @@ public:
   Selection& GetSelection() { return m_selection; }
   const Selection& GetSelection() const { return m_selection; }
 
-  std::size_t GetCollectionSize() const
-  {
-    return m_collection_vt.size() + m_collection_vf.size() + m_collection_pt.size() +
-           m_collection_pf.size();
-  }
+  std::size_t GetCollectionSize() const;
   std::size_t GetBlacklistSize() const { return m_blacklist_size; }
   Phase GetRecordingPhase() const { return m_recording_phase; }
 
@@ -190,6 +197,13 @@ public:
 
   // HitVirtualFalse_fk_n and HitPhysicalFalse_fk_n are never used, so they are omitted here.
 
+  // For the JITs only. Returns a counter that JIT code can increment directly instead of calling
+  // one of the HitXX functions above, or nullptr if all counters are in use. There is one counter
+  // per branch and path; recompiling a block returns the same counters again. Counters are folded
+  // into the Collections lazily, whenever the Core code needs to know about every recorded branch.
+  std::atomic<u64>* GetCounter(u32 origin, u32 destination, UGeckoInstruction inst,
+                               bool is_virtual, bool condition);
+
   static void HitVirtualTrue(BranchWatch* branch_watch, u32 origin, u32 destination, u32 inst)
   {
     HitVirtualTrue_fk(branch_watch, FakeBranchWatchCollectionKey{origin, destination}, inst);
@@ -240,6 +254,19 @@ public:
   }
 
 private:
+  static constexpr std::size_t COUNTER_CAPACITY = 0x40000;
+
+  struct CounterSlot
+  {
+    BranchWatchCollectionKey key;
+    bool is_virtual;
+    bool condition;
+    // Whether the counter was attached to its Collection entry.
+    bool folded;
+  };
+
+  void FoldCounters(const CPUThreadGuard& guard);
+
   Collection& GetCollectionV(bool condition)
   {
     if (condition)
@@ -269,8 +296,19 @@ private:
   Collection m_collection_pt;  // physical address space | true path
   Collection m_collection_pf;  // physical address space | false path
   Selection m_selection;
+
+  // Everything below is only allocated once the JIT asks for the first counter, and the counters
+  // never move after that because JIT code refers to them directly.
+  std::unique_ptr<std::atomic<u64>[]> m_counters;
+  std::unique_ptr<CounterSlot[]> m_counter_slots;
+  std::atomic<u32> m_counter_count = 0;
+  // Indexed by (is_virtual << 1) | condition. Only used by the CPU thread.
+  std::array<std::unordered_map<BranchWatchCollectionKey, u32>, 4> m_counter_indices;
 };
 
+static_assert(sizeof(std::atomic<u64>) == sizeof(u64) && std::atomic<u64>::is_always_lock_free,
+              "JIT code increments BranchWatch counters as plain u64s.");
+
 #if _M_X86_64
 static_assert(BranchWatch::GetOffsetOfRecordingActive() < 0x80);  // Makes JIT code smaller.
 #endif
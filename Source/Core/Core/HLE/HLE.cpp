@@ -15,6 +15,7 @@
 #include "Core/GeckoCode.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
+#include "Core/HLE/HLE_SDK.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -27,7 +28,7 @@ namespace HLE
 static std::map<u32, u32> s_hooked_addresses;
 
 // clang-format off
-constexpr std::array<Hook, 23> os_patches{{
+constexpr std::array<Hook, 30> os_patches{{
     // Placeholder, os_patches[0] is the "non-existent function" index
     {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
 
@@ -57,6 +58,14 @@ constexpr std::array<Hook, 23> os_patches{{
     {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug}, // used for early init things (normally)
     {"__write_console",              HLE_OS::HLE_write_console,             HookType::Start,   HookFlag::Debug}, // used by sysmenu (+more?)
 
+    // SDK routines that dominate CPU time in many games
+    {"memcpy",                       HLE_SDK::HLE_memcpy,                   HookType::Replace, HookFlag::SDK},
+    {"memset",                       HLE_SDK::HLE_memset,                   HookType::Replace, HookFlag::SDK},
+    {"DCFlushRange",                 HLE_SDK::HLE_DCFlushRange,             HookType::Replace, HookFlag::SDK},
+    {"DCFlushRangeNoSync",           HLE_SDK::HLE_DCFlushRange,             HookType::Replace, HookFlag::SDK},
+    {"DCStoreRange",                 HLE_SDK::HLE_DCFlushRange,             HookType::Replace, HookFlag::SDK},
+    {"DCStoreRangeNoSync",           HLE_SDK::HLE_DCFlushRange,             HookType::Replace, HookFlag::SDK},
+
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
     {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Fixed} // apploader needs OSReport-like function
@@ -128,11 +137,14 @@ void PatchFunctions(Core::System& system)
     }
   }
 
+  const bool patch_sdk_functions = Config::Get(Config::MAIN_HLE_SDK_FUNCTIONS);
   for (u32 i = 1; i < os_patches.size(); ++i)
   {
     // Fixed hooks don't map to symbols
     if (os_patches[i].flags == HookFlag::Fixed)
       continue;
+    if (os_patches[i].flags == HookFlag::SDK && !patch_sdk_functions)
+      continue;
 
     for (const auto& symbol : ppc_symbol_db.GetSymbolsFromName(os_patches[i].name))
     {
@@ -163,6 +175,8 @@ void Execute(const Core::CPUThreadGuard& guard, u32 current_pc, u32 hook_index)
   hook_index &= 0xFFFFF;
   if (hook_index > 0 && hook_index < os_patches.size())
   {
+    // The JIT doesn't keep PC up to date, but hooks that fall back to the guest code need it
+    guard.GetSystem().GetPPCState().pc = current_pc;
     os_patches[hook_index].function(guard);
   }
   else
@@ -225,6 +239,12 @@ TryReplaceFunctionResult TryReplaceFunction(PPCSymbolDB& ppc_symbol_db, u32 addr
 
 bool IsEnabled(HookFlag flag, PowerPC::CoreMode mode)
 {
+  // The native SDK replacements only estimate how many cycles the guest code takes, so they
+  // can't be used when the emulation has to be deterministic. Changing whether determinism is
+  // wanted clears the JIT cache, so this is checked again for every block.
+  if (flag == HookFlag::SDK)
+    return !Core::WantsDeterminism() && !HLE_SDK::IsRunningGuestVersion();
+
   return flag != HLE::HookFlag::Debug || Config::IsDebuggingEnabled() ||
          mode == PowerPC::CoreMode::Interpreter;
 }
@@ -36,6 +36,7 @@ enum class HookFlag
   Generic,  // Miscellaneous function
   Debug,    // Debug output function
   Fixed,    // An arbitrary hook mapped to a fixed address instead of a symbol
+  SDK,      // Native replacement of an SDK routine, only patched in when enabled in the config
 };
 
 struct Hook
@@ -0,0 +1,242 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HLE/HLE_SDK.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace HLE_SDK
+{
+// Upper bound for the number of instructions a guest function may take when it's run for
+// validation. Anything beyond this is continued by the regular CPU core instead.
+constexpr u32 MAX_VALIDATION_INSTRUCTIONS = 0x1000000;
+
+static bool s_running_guest_version = false;
+
+bool IsRunningGuestVersion()
+{
+  return s_running_guest_version;
+}
+
+// Returns a host pointer to the given range of guest memory, or nullptr if the range isn't plain
+// RAM that is mapped contiguously by the BATs. Page table mappings, MMIO and memchecks all make
+// this fail.
+static u8* GetRAMPointer(Core::System& system, u32 address, u32 size)
+{
+  if (size == 0 || address + (size - 1) < address)
+    return nullptr;
+
+  auto& mmu = system.GetMMU();
+  const std::optional<u32> physical_address = mmu.GetTranslatedAddress(address);
+  if (!physical_address)
+    return nullptr;
+
+  const u32 last_address = address + (size - 1);
+  u32 page_address = address;
+  while (true)
+  {
+    if (!mmu.IsOptimizableRAMAddress(page_address, 8) ||
+        mmu.GetTranslatedAddress(page_address) != *physical_address + (page_address - address))
+    {
+      return nullptr;
+    }
+
+    const u32 next_page = (page_address & ~(PowerPC::BAT_PAGE_SIZE - 1)) + PowerPC::BAT_PAGE_SIZE;
+    if (next_page == 0 || next_page > last_address)
+      break;
+    page_address = next_page;
+  }
+
+  const std::span<u8> span = system.GetMemory().GetSpanForAddress(*physical_address);
+  return span.size() >= size ? span.data() : nullptr;
+}
+
+static void ReturnToCaller(PowerPC::PowerPCState& ppc_state, u32 result, s64 cycles)
+{
+  ppc_state.gpr[3] = result;
+  ppc_state.npc = LR(ppc_state);
+  ppc_state.downcount -= static_cast<s32>(cycles);
+}
+
+// Runs the first instruction of the guest function and leaves the rest to the CPU core. The HLE
+// hook is only checked at the start of the function, so execution continues with the guest code.
+static void RunGuestVersion(Core::System& system)
+{
+  auto& ppc_state = system.GetPPCState();
+  s_running_guest_version = true;
+  ppc_state.downcount -= system.GetInterpreter().SingleStepInner();
+  s_running_guest_version = false;
+}
+
+// Runs the whole guest function in the interpreter. Returns whether it returned to its caller.
+static bool RunGuestVersionToCompletion(Core::System& system, u32* cycles)
+{
+  auto& ppc_state = system.GetPPCState();
+  auto& interpreter = system.GetInterpreter();
+  const u32 return_address = LR(ppc_state);
+  const u32 stack_pointer = ppc_state.gpr[1];
+
+  s_running_guest_version = true;
+  *cycles = 0;
+  for (u32 i = 0; i < MAX_VALIDATION_INSTRUCTIONS; ++i)
+  {
+    *cycles += interpreter.SingleStepInner();
+    if (ppc_state.pc == return_address && ppc_state.gpr[1] == stack_pointer)
+      break;
+  }
+  s_running_guest_version = false;
+
+  ppc_state.downcount -= static_cast<s32>(*cycles);
+  return ppc_state.pc == return_address;
+}
+
+// Runs the guest version of a function whose only outputs are r3 and the given memory range, and
+// reports any difference from the result of the native version.
+static void Validate(Core::System& system, std::string_view function_name, u32 expected_result,
+                     u32 address, std::span<const u8> expected_data, s64 estimated_cycles)
+{
+  u32 cycles;
+  if (!RunGuestVersionToCompletion(system, &cycles))
+  {
+    WARN_LOG_FMT(OSHLE, "HLE {}: guest version did not return within {} instructions",
+                 function_name, MAX_VALIDATION_INSTRUCTIONS);
+    return;
+  }
+
+  auto& ppc_state = system.GetPPCState();
+  const u8* const data = GetRAMPointer(system, address, static_cast<u32>(expected_data.size()));
+  if (ppc_state.gpr[3] != expected_result)
+  {
+    ERROR_LOG_FMT(OSHLE, "HLE {}: returned {:08x}, the guest version returned {:08x}",
+                  function_name, expected_result, ppc_state.gpr[3]);
+  }
+  if (data && !std::equal(expected_data.begin(), expected_data.end(), data))
+  {
+    const auto mismatch = std::mismatch(expected_data.begin(), expected_data.end(), data);
+    ERROR_LOG_FMT(OSHLE, "HLE {}: memory at {:08x} differs from the guest version", function_name,
+                  address + static_cast<u32>(mismatch.first - expected_data.begin()));
+  }
+  DEBUG_LOG_FMT(OSHLE, "HLE {}: estimated {} cycles, the guest version took {}", function_name,
+                estimated_cycles, cycles);
+
+  ppc_state.npc = ppc_state.pc;
+}
+
+// The cycle estimates below follow the instruction counts of the SDK's (MSL) implementations:
+// a byte loop for short or misaligned copies, and an unrolled word loop otherwise.
+
+void HLE_memcpy(const Core::CPUThreadGuard& guard)
+{
+  auto& system = guard.GetSystem();
+  auto& ppc_state = system.GetPPCState();
+  const u32 dest = ppc_state.gpr[3];
+  const u32 src = ppc_state.gpr[4];
+  const u32 size = ppc_state.gpr[5];
+
+  if (size == 0)
+  {
+    ReturnToCaller(ppc_state, dest, 4);
+    return;
+  }
+
+  // The guest version copies backwards when the ranges overlap. Leave that case to it.
+  u8* const dest_ptr = GetRAMPointer(system, dest, size);
+  const u8* const src_ptr = GetRAMPointer(system, src, size);
+  if (!dest_ptr || !src_ptr || (dest < src + size && src < dest + size))
+  {
+    RunGuestVersion(system);
+    return;
+  }
+
+  const bool word_loop = size >= 32 && ((dest ^ src) & 3) == 0;
+  const s64 cycles = word_loop ? 20 + s64(size) * 9 / 16 : 10 + s64(size) * 3;
+
+  if (Config::Get(Config::MAIN_HLE_SDK_FUNCTIONS_VALIDATION))
+  {
+    const std::vector<u8> expected(src_ptr, src_ptr + size);
+    Validate(system, "memcpy", dest, dest, expected, cycles);
+    return;
+  }
+
+  std::memcpy(dest_ptr, src_ptr, size);
+  ReturnToCaller(ppc_state, dest, cycles);
+}
+
+void HLE_memset(const Core::CPUThreadGuard& guard)
+{
+  auto& system = guard.GetSystem();
+  auto& ppc_state = system.GetPPCState();
+  const u32 dest = ppc_state.gpr[3];
+  const u8 value = static_cast<u8>(ppc_state.gpr[4]);
+  const u32 size = ppc_state.gpr[5];
+
+  if (size == 0)
+  {
+    ReturnToCaller(ppc_state, dest, 4);
+    return;
+  }
+
+  u8* const dest_ptr = GetRAMPointer(system, dest, size);
+  if (!dest_ptr)
+  {
+    RunGuestVersion(system);
+    return;
+  }
+
+  const s64 cycles = size >= 32 ? 20 + s64(size) * 5 / 16 : 10 + s64(size) * 3;
+
+  if (Config::Get(Config::MAIN_HLE_SDK_FUNCTIONS_VALIDATION))
+  {
+    const std::vector<u8> expected(size, value);
+    Validate(system, "memset", dest, dest, expected, cycles);
+    return;
+  }
+
+  std::memset(dest_ptr, value, size);
+  ReturnToCaller(ppc_state, dest, cycles);
+}
+
+// DCFlushRange and DCStoreRange (and their NoSync variants) run dcbf or dcbst over every cache line
+// in the range. Without data cache emulation, both instructions just invalidate the JIT cache
+// for the line, which can be done for the whole range at once. The trailing sc that the SDK uses
+// as a sync barrier only clobbers volatile registers, so skipping it isn't observable.
+void HLE_DCFlushRange(const Core::CPUThreadGuard& guard)
+{
+  auto& system = guard.GetSystem();
+  auto& ppc_state = system.GetPPCState();
+  if (ppc_state.m_enable_dcache)
+  {
+    RunGuestVersion(system);
+    return;
+  }
+
+  // The length is unsigned, the guest version only returns early when it's 0
+  const u32 address = ppc_state.gpr[3];
+  const u32 size = ppc_state.gpr[4];
+  if (size == 0)
+  {
+    ReturnToCaller(ppc_state, address, 4);
+    return;
+  }
+
+  const u32 lines = static_cast<u32>((u64(address & 31) + u64(size) + 31) >> 5);
+  system.GetJitInterface().InvalidateICacheLines(address, lines);
+  ReturnToCaller(ppc_state, address + lines * 32, 10 + s64(lines) * 3);
+}
+}  // namespace HLE_SDK
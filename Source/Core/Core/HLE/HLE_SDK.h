@@ -0,0 +1,26 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+namespace Core
+{
+class CPUThreadGuard;
+}
+
+// Native replacements for hot SDK routines. These are only installed when enabled in the config,
+// and are not used while determinism is wanted (NetPlay, movies) since their timing differs.
+//
+// Whenever a call can't be handled natively (overlapping ranges, memory that isn't plain RAM,
+// accurate CPU cache emulation...), the guest version of the function runs instead, so the results
+// are always the same as without HLE.
+namespace HLE_SDK
+{
+void HLE_memcpy(const Core::CPUThreadGuard& guard);
+void HLE_memset(const Core::CPUThreadGuard& guard);
+void HLE_DCFlushRange(const Core::CPUThreadGuard& guard);
+
+// Whether the guest version of an SDK routine is currently being run, in which case the native
+// replacements must not be used
+bool IsRunningGuestVersion();
+}  // namespace HLE_SDK
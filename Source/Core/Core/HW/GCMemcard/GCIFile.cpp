@@ -3,6 +3,9 @@
 
 #include "Core/HW/GCMemcard/GCIFile.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -62,6 +65,9 @@ bool GCIFile::LoadSaveBlocks()
       m_save_data.clear();
       return false;
     }
+
+    m_dirty_blocks.clear();
+    m_allow_partial_flush = true;
   }
   return true;
 }
@@ -85,6 +91,80 @@ int GCIFile::UsesBlock(u16 block_num)
   return -1;
 }
 
+void GCIFile::MarkBlockDirty(int index)
+{
+  if (m_dirty)
+    return;
+
+  if (!m_allow_partial_flush)
+  {
+    m_dirty = true;
+    return;
+  }
+
+  if (m_dirty_blocks.size() < m_save_data.size())
+    m_dirty_blocks.resize(m_save_data.size());
+  m_dirty_blocks[index] = true;
+}
+
+void GCIFile::MarkHeaderDirty()
+{
+  if (m_allow_partial_flush)
+    m_header_dirty = true;
+  else
+    m_dirty = true;
+}
+
+bool GCIFile::HasPartialChanges() const
+{
+  return m_header_dirty ||
+         std::any_of(m_dirty_blocks.begin(), m_dirty_blocks.end(), [](bool b) { return b; });
+}
+
+bool GCIFile::FlushPartialChanges()
+{
+  if (m_filename.empty())
+    return false;
+
+  File::IOFile save_file(m_filename, "r+b");
+  const u64 expected_size = u64(m_gci_header.m_block_count) * BLOCK_SIZE + DENTRY_SIZE;
+  if (!save_file || save_file.GetSize() != expected_size ||
+      (!m_save_data.empty() && m_save_data.size() != m_gci_header.m_block_count))
+  {
+    return false;
+  }
+
+  if (m_header_dirty)
+    save_file.WriteBytes(&m_gci_header, DENTRY_SIZE);
+
+  for (size_t i = 0; i < m_dirty_blocks.size() && i < m_save_data.size(); ++i)
+  {
+    if (!m_dirty_blocks[i])
+      continue;
+
+    save_file.Seek(DENTRY_SIZE + i * BLOCK_SIZE, File::SeekOrigin::Begin);
+    save_file.WriteBytes(m_save_data[i].m_block.data(), BLOCK_SIZE);
+  }
+
+  m_dirty_blocks.clear();
+  m_header_dirty = false;
+  if (!save_file.IsGood())
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to update {} in place", m_filename);
+    return false;
+  }
+
+  INFO_LOG_FMT(EXPANSIONINTERFACE, "Updated {} in place", m_filename);
+  return true;
+}
+
+void GCIFile::OnFullyWritten(bool success)
+{
+  m_dirty_blocks.clear();
+  m_header_dirty = false;
+  m_allow_partial_flush = success;
+}
+
 void GCIFile::DoState(PointerWrap& p)
 {
   p.Do(m_gci_header);
@@ -92,5 +172,9 @@ void GCIFile::DoState(PointerWrap& p)
   p.Do(m_filename);
   p.Do(m_save_data);
   p.Do(m_used_blocks);
+
+  // The loaded save data may not match the file on disk anymore.
+  if (p.IsReadMode())
+    OnFullyWritten(false);
 }
 }  // namespace Memcard
@@ -22,10 +22,27 @@ public:
   void DoState(PointerWrap& p);
   int UsesBlock(u16 blocknum);
 
+  // Records a modification of the given block of m_save_data (or of the header) so that only
+  // that part of the file is rewritten on the next flush. Falls back to marking the whole file
+  // dirty if the file on disk can't be updated in place.
+  void MarkBlockDirty(int index);
+  void MarkHeaderDirty();
+  bool HasPartialChanges() const;
+  // Writes the dirty header and blocks into the existing file on disk.
+  bool FlushPartialChanges();
+  void OnFullyWritten(bool success);
+
   DEntry m_gci_header;
   std::vector<GCMBlock> m_save_data;
   std::vector<u16> m_used_blocks;
+  // When set, the whole file is rewritten on the next flush.
   bool m_dirty = false;
   std::string m_filename;
+
+private:
+  std::vector<bool> m_dirty_blocks;
+  bool m_header_dirty = false;
+  // Whether the file on disk is known to match m_save_data outside of the dirty blocks.
+  bool m_allow_partial_flush = false;
 };
 }  // namespace Memcard
@@ -269,6 +269,7 @@ void GCMemcardDirectory::FlushThread()
   Common::SetCurrentThreadName(fmt::format("Memcard {} flushing thread", m_card_slot).c_str());
 
   constexpr std::chrono::seconds flush_interval{1};
+  constexpr std::chrono::seconds max_flush_delay{5};
   while (true)
   {
     // no-op until signalled
@@ -276,8 +277,11 @@ void GCMemcardDirectory::FlushThread()
 
     if (m_exiting.TestAndClear())
       return;
-    // no-op as long as signalled within flush_interval
-    while (m_flush_trigger.WaitFor(flush_interval))
+    // no-op as long as signalled within flush_interval, but don't let a game that keeps writing
+    // put off the flush indefinitely
+    const auto flush_deadline = std::chrono::steady_clock::now() + max_flush_delay;
+    while (std::chrono::steady_clock::now() < flush_deadline &&
+           m_flush_trigger.WaitFor(flush_interval))
     {
       if (m_exiting.TestAndClear())
         return;
@@ -412,6 +416,8 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
   }
 
   memcpy(m_last_block_address + offset, src_address, length);
+  if (m_last_block >= static_cast<s32>(Memcard::MC_FST_BLOCKS) && m_last_save_index != -1)
+    m_saves[m_last_save_index].MarkBlockDirty(m_last_save_block_index);
 
   l.unlock();
   if (extra)
@@ -487,12 +493,23 @@ inline void GCMemcardDirectory::SyncSaves()
       if (added || memcmp((u8*)&(m_saves[i].m_gci_header), (u8*)&(current->m_dir_entries[i]),
                           Memcard::DENTRY_SIZE))
       {
-        m_saves[i].m_dirty = true;
         const u32 gamecode = Common::swap32(m_saves[i].m_gci_header.m_gamecode.data());
         const u32 new_gamecode = Common::swap32(current->m_dir_entries[i].m_gamecode.data());
         const u32 old_start = m_saves[i].m_gci_header.m_first_block;
         const u32 new_start = current->m_dir_entries[i].m_first_block;
 
+        // If only metadata like the modification time changed, the header can be rewritten in
+        // place. Anything that changes the layout of the file requires rewriting all of it.
+        if (!added && gamecode == new_gamecode && old_start == new_start &&
+            m_saves[i].m_gci_header.m_block_count == current->m_dir_entries[i].m_block_count)
+        {
+          m_saves[i].MarkHeaderDirty();
+        }
+        else
+        {
+          m_saves[i].m_dirty = true;
+        }
+
         if ((gamecode != 0xFFFFFFFF) && (gamecode != new_gamecode))
         {
           PanicAlertFmtT(
@@ -551,9 +568,11 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
 
         if (writing)
         {
-          m_saves[i].m_dirty = true;
+          m_saves[i].MarkBlockDirty(idx);
         }
 
+        m_last_save_index = i;
+        m_last_save_block_index = idx;
         m_last_block = block;
         m_last_block_address = m_saves[i].m_save_data[idx].m_block.data();
         return m_last_block;
@@ -624,6 +643,16 @@ void GCMemcardDirectory::FlushToFile()
   Memcard::DEntry invalid;
   for (Memcard::GCIFile& save : m_saves)
   {
+    if (!save.m_dirty && save.HasPartialChanges() &&
+        save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
+    {
+      // Only rewrite the blocks that changed if the file on disk allows it.
+      if (save.FlushPartialChanges())
+        Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
+      else
+        save.m_dirty = true;
+    }
+
     if (save.m_dirty)
     {
       if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
@@ -664,6 +693,7 @@ void GCMemcardDirectory::FlushToFile()
           for (const Memcard::GCMBlock& block : save.m_save_data)
             gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
 
+          save.OnFullyWritten(gci.IsGood());
           if (gci.IsGood())
           {
             Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
@@ -677,6 +707,7 @@ void GCMemcardDirectory::FlushToFile()
         }
         else
         {
+          save.OnFullyWritten(false);
           Core::DisplayMessage(
               fmt::format("Failed to open file at {} for writing", save.m_filename), 10000);
           ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing",
@@ -694,6 +725,7 @@ void GCMemcardDirectory::FlushToFile()
         save.m_filename.clear();
         save.m_save_data.clear();
         save.m_used_blocks.clear();
+        save.OnFullyWritten(false);
       }
     }
 
@@ -722,6 +754,8 @@ void GCMemcardDirectory::DoState(PointerWrap& p)
   std::unique_lock l(m_write_mutex);
   m_last_block = -1;
   m_last_block_address = nullptr;
+  m_last_save_index = -1;
+  m_last_save_block_index = -1;
   p.Do(m_save_directory);
   p.Do(m_hdr);
   p.Do(m_dir1);
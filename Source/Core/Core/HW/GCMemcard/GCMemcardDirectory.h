@@ -52,6 +52,9 @@ private:
   u32 m_game_id;
   s32 m_last_block;
   u8* m_last_block_address;
+  // The save and block index within that save that m_last_block belongs to, if any.
+  s32 m_last_save_index = -1;
+  s32 m_last_save_block_index = -1;
 
   Memcard::Header m_hdr;
   Memcard::Directory m_dir1;
@@ -23,6 +23,7 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/Config/SessionSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -45,11 +46,18 @@ MemoryCard::MemoryCard(const std::string& filename, ExpansionInterface::Slot car
     // Measure size of the existing memcard file.
     m_memory_card_size = (u32)file.GetSize();
     m_nintendo_card_id = m_memory_card_size / SIZE_TO_Mb;
-    m_memcard_data = std::make_unique<u8[]>(m_memory_card_size);
-    memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
 
     INFO_LOG_FMT(EXPANSIONINTERFACE, "Reading memory card {}", m_filename);
-    file.ReadBytes(&m_memcard_data[0], m_memory_card_size);
+    file.Close();
+    if (!MapFile())
+    {
+      m_memcard_buffer = std::make_unique<u8[]>(m_memory_card_size);
+      m_memcard_data = m_memcard_buffer.get();
+      memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+
+      file.Open(m_filename, "rb");
+      file.ReadBytes(&m_memcard_data[0], m_memory_card_size);
+    }
   }
   else
   {
@@ -57,7 +65,8 @@ MemoryCard::MemoryCard(const std::string& filename, ExpansionInterface::Slot car
     m_nintendo_card_id = size_mbits;
     m_memory_card_size = size_mbits * SIZE_TO_Mb;
 
-    m_memcard_data = std::make_unique<u8[]>(m_memory_card_size);
+    m_memcard_buffer = std::make_unique<u8[]>(m_memory_card_size);
+    m_memcard_data = m_memcard_buffer.get();
 
     // Fills in the first 5 blocks (MC_HDR_SIZE bytes)
     auto& sram = Core::System::GetInstance().GetSRAM();
@@ -73,15 +82,50 @@ MemoryCard::MemoryCard(const std::string& filename, ExpansionInterface::Slot car
     // Fills in the remaining blocks
     memset(&m_memcard_data[MC_HDR_SIZE], 0xFF, m_memory_card_size - MC_HDR_SIZE);
 
+    // The file doesn't exist yet, so the whole card has to be written on the first flush.
+    m_needs_full_flush = true;
+    if (MapFile())
+    {
+      memcpy(m_mapped_file.GetData(), &m_memcard_buffer[0], m_memory_card_size);
+      m_memcard_buffer.reset();
+    }
+
     INFO_LOG_FMT(EXPANSIONINTERFACE, "No memory card found. A new one was created instead.");
   }
 
+  m_dirty_blocks.resize(m_memory_card_size / Memcard::BLOCK_SIZE);
+
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
-  m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  if (!m_mapped_file.IsOpen())
+    m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
+bool MemoryCard::MapFile()
+{
+  if (!Config::Get(Config::MAIN_MEMCARD_MEMORY_MAPPED) ||
+      !Config::Get(Config::SESSION_SAVE_DATA_WRITABLE))
+  {
+    return false;
+  }
+
+  std::string dir;
+  SplitPath(m_filename, &dir, nullptr, nullptr);
+  if (!File::IsDirectory(dir))
+    File::CreateFullPath(dir);
+
+  if (!m_mapped_file.Open(m_filename, Common::MappedFile::Mode::ReadWrite, m_memory_card_size))
+  {
+    WARN_LOG_FMT(EXPANSIONINTERFACE, "Failed to map memory card {}, falling back to buffered I/O",
+                 m_filename);
+    return false;
+  }
+
+  m_memcard_data = m_mapped_file.GetData();
+  return true;
+}
+
 MemoryCard::~MemoryCard()
 {
   if (m_flush_thread.joinable())
@@ -117,41 +161,65 @@ void MemoryCard::FlushThread()
       }
     }
 
-    // Opening the file is purposefully done each iteration to ensure the
-    // file doesn't disappear out from under us after the first check.
-    File::IOFile file(m_filename, "r+b");
-
-    if (!file)
+    if (m_mapped_file.IsOpen())
     {
-      std::string dir;
-      SplitPath(m_filename, &dir, nullptr, nullptr);
-      if (!File::IsDirectory(dir))
+      // Writes already went straight to the mapped file, so only ask the OS to write back the
+      // pages that were touched since the last flush.
+      std::vector<std::pair<u32, u32>> ranges;
       {
-        File::CreateFullPath(dir);
+        std::unique_lock l(m_flush_mutex);
+        ranges = TakeDirtyRanges(m_needs_full_flush);
       }
-      file.Open(m_filename, "wb");
+      for (const auto& [offset, length] : ranges)
+        m_mapped_file.Flush(offset, length);
     }
-
-    // Note - file may have changed above, after ctor
-    if (!file)
+    else
     {
-      PanicAlertFmtT(
-          "Could not write memory card file {0}.\n\n"
-          "Are you running Dolphin from a CD/DVD, or is the save file maybe write protected?\n\n"
-          "Are you receiving this after moving the emulator directory?\nIf so, then you may "
-          "need to re-specify your memory card location in the options.",
-          m_filename);
-
-      // Exit the flushing thread - further flushes will be ignored unless
-      // the thread is recreated.
-      return;
-    }
+      // Opening the file is purposefully done each iteration to ensure the
+      // file doesn't disappear out from under us after the first check.
+      File::IOFile file(m_filename, "r+b");
+      bool full = !file || file.GetSize() != m_memory_card_size;
 
-    {
-      std::unique_lock l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      if (!file)
+      {
+        std::string dir;
+        SplitPath(m_filename, &dir, nullptr, nullptr);
+        if (!File::IsDirectory(dir))
+        {
+          File::CreateFullPath(dir);
+        }
+        file.Open(m_filename, "wb");
+      }
+
+      // Note - file may have changed above, after ctor
+      if (!file)
+      {
+        PanicAlertFmtT(
+            "Could not write memory card file {0}.\n\n"
+            "Are you running Dolphin from a CD/DVD, or is the save file maybe write protected?\n\n"
+            "Are you receiving this after moving the emulator directory?\nIf so, then you may "
+            "need to re-specify your memory card location in the options.",
+            m_filename);
+
+        // Exit the flushing thread - further flushes will be ignored unless
+        // the thread is recreated.
+        return;
+      }
+
+      // Only the blocks that were modified since the last flush are copied and written.
+      std::vector<std::pair<u32, u32>> ranges;
+      {
+        std::unique_lock l(m_flush_mutex);
+        ranges = TakeDirtyRanges(full || m_needs_full_flush);
+        for (const auto& [offset, length] : ranges)
+          memcpy(&m_flush_buffer[offset], &m_memcard_data[offset], length);
+      }
+      for (const auto& [offset, length] : ranges)
+      {
+        file.Seek(offset, File::SeekOrigin::Begin);
+        file.WriteBytes(&m_flush_buffer[offset], length);
+      }
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
 
     if (do_exit)
       return;
@@ -162,6 +230,44 @@ void MemoryCard::FlushThread()
   }
 }
 
+void MemoryCard::MarkBlocksDirty(u32 address, u32 length)
+{
+  if (length == 0)
+    return;
+
+  const u32 first = address / Memcard::BLOCK_SIZE;
+  const u32 last = (address + length - 1) / Memcard::BLOCK_SIZE;
+  for (u32 block = first; block <= last; ++block)
+    m_dirty_blocks[block] = true;
+}
+
+std::vector<std::pair<u32, u32>> MemoryCard::TakeDirtyRanges(bool full)
+{
+  std::vector<std::pair<u32, u32>> ranges;
+  if (full)
+    ranges.emplace_back(0, m_memory_card_size);
+
+  // Coalesce adjacent dirty blocks so that they can be written with a single call.
+  for (u32 block = 0; block < m_dirty_blocks.size(); ++block)
+  {
+    if (!m_dirty_blocks[block])
+      continue;
+
+    m_dirty_blocks[block] = false;
+    if (full)
+      continue;
+
+    const u32 offset = block * Memcard::BLOCK_SIZE;
+    if (!ranges.empty() && ranges.back().first + ranges.back().second == offset)
+      ranges.back().second += Memcard::BLOCK_SIZE;
+    else
+      ranges.emplace_back(offset, Memcard::BLOCK_SIZE);
+  }
+
+  m_needs_full_flush = false;
+  return ranges;
+}
+
 void MemoryCard::MakeDirty()
 {
   m_dirty.Set();
@@ -191,6 +297,7 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
   {
     std::unique_lock l(m_flush_mutex);
     memcpy(&m_memcard_data[dest_address], src_address, length);
+    MarkBlocksDirty(dest_address, length);
   }
   MakeDirty();
   return length;
@@ -207,6 +314,7 @@ void MemoryCard::ClearBlock(u32 address)
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[address], 0xFF, Memcard::BLOCK_SIZE);
+    MarkBlocksDirty(address, Memcard::BLOCK_SIZE);
   }
   MakeDirty();
 }
@@ -216,6 +324,7 @@ void MemoryCard::ClearAll()
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    m_needs_full_flush = true;
   }
   MakeDirty();
 }
@@ -225,4 +334,11 @@ void MemoryCard::DoState(PointerWrap& p)
   p.Do(m_card_slot);
   p.Do(m_memory_card_size);
   p.DoArray(&m_memcard_data[0], m_memory_card_size);
+
+  // The whole card may differ from what's on disk now, so write all of it on the next flush.
+  if (p.IsReadMode())
+  {
+    std::unique_lock l(m_flush_mutex);
+    m_needs_full_flush = true;
+  }
 }
@@ -7,8 +7,12 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
+
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "Common/MappedFile.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 #include "Core/HW/GCMemcard/GCMemcardBase.h"
 
@@ -36,9 +40,21 @@ private:
     return end_address <= static_cast<u64>(m_memory_card_size);
   }
 
+  bool MapFile();
+  // Must be called with m_flush_mutex held.
+  void MarkBlocksDirty(u32 address, u32 length);
+  // Returns the (offset, length) ranges that need to be written out and clears the dirty state.
+  // Must be called with m_flush_mutex held.
+  std::vector<std::pair<u32, u32>> TakeDirtyRanges(bool full);
+
   std::string m_filename;
-  std::unique_ptr<u8[]> m_memcard_data;
+  // Points to either m_memcard_buffer or the memory mapped file.
+  u8* m_memcard_data = nullptr;
+  std::unique_ptr<u8[]> m_memcard_buffer;
+  Common::MappedFile m_mapped_file;
   std::unique_ptr<u8[]> m_flush_buffer;
+  std::vector<bool> m_dirty_blocks;
+  bool m_needs_full_flush = false;
   std::thread m_flush_thread;
   std::mutex m_flush_mutex;
   Common::Event m_flush_trigger;
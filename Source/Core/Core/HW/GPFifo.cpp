@@ -8,6 +8,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
 #include "Common/Swap.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
@@ -32,6 +33,7 @@ GPFifoManager::GPFifoManager(Core::System& system) : m_system(system)
 //
 // Both of these should actually work! Only problem is that we have to decide at run time,
 // the same function could use both methods. Compile 2 different versions of each such block?
+// The burst statistics logged on shutdown show how many bursts are usually pending at once.
 
 size_t GPFifoManager::GetGatherPipeCount()
 {
@@ -56,6 +58,20 @@ void GPFifoManager::Init()
   ResetGatherPipe();
   m_system.GetPPCState().gather_pipe_base_ptr = m_gather_pipe;
   memset(m_gather_pipe, 0, sizeof(m_gather_pipe));
+  m_burst_stats = {};
+  m_init_time = std::chrono::steady_clock::now();
+}
+
+void GPFifoManager::Shutdown()
+{
+  if (m_burst_stats.bursts == 0)
+    return;
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(
+      std::chrono::steady_clock::now() - m_init_time);
+  INFO_LOG_FMT(GPFIFO, "Wrote {} bytes in {} bursts from {} updates ({:.2f} MB/s)",
+               m_burst_stats.bytes, m_burst_stats.bursts, m_burst_stats.updates,
+               m_burst_stats.bytes / elapsed.count() / (1024 * 1024));
 }
 
 bool GPFifoManager::IsBNE() const
@@ -106,6 +122,12 @@ void GPFifoManager::UpdateGatherPipe()
     system.GetCommandProcessor().GatherPipeBursted();
   }
 
+  // Bursts that are written by the same update could be handled together
+  m_burst_stats.bytes += processed;
+  m_burst_stats.bursts += processed / GATHER_PIPE_SIZE;
+  if (processed != 0)
+    m_burst_stats.updates++;
+
   // move back the spill bytes
   memmove(m_gather_pipe, m_gather_pipe + processed, pipe_count);
   SetGatherPipeCount(pipe_count);
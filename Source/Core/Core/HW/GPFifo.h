@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -24,12 +26,24 @@ constexpr u32 GATHER_PIPE_EXTRA_SIZE = GATHER_PIPE_SIZE * 16;
 class GPFifoManager final
 {
 public:
+  struct BurstStats
+  {
+    // Bytes written from the gather pipe to the CPU FIFO
+    u64 bytes = 0;
+    // Number of 32 byte bursts, and number of gather pipe updates that wrote any
+    u64 bursts = 0;
+    u64 updates = 0;
+  };
+
   explicit GPFifoManager(Core::System& system);
 
   // Init
   void Init();
+  void Shutdown();
   void DoState(PointerWrap& p);
 
+  const BurstStats& GetBurstStats() const { return m_burst_stats; }
+
   // ResetGatherPipe
   void ResetGatherPipe();
   void UpdateGatherPipe();
@@ -59,6 +73,9 @@ private:
   // More room for the fastmodes
   alignas(GATHER_PIPE_SIZE) u8 m_gather_pipe[GATHER_PIPE_EXTRA_SIZE]{};
 
+  BurstStats m_burst_stats;
+  std::chrono::steady_clock::time_point m_init_time;
+
   Core::System& m_system;
 };
 
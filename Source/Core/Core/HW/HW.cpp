@@ -68,6 +68,7 @@ void Shutdown(Core::System& system)
 
   system.GetSystemTimers().Shutdown();
   system.GetCPU().Shutdown();
+  system.GetGPFifo().Shutdown();
   system.GetDVDInterface().Shutdown();
   system.GetDSP().Shutdown();
   system.GetMemoryInterface().Shutdown();
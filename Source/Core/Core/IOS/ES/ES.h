@@ -5,6 +5,7 @@
 
 #include <array>
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -64,7 +65,9 @@ public:
     {
       bool valid = false;
       u32 id = 0;
+      // The IV for the next encrypted block, which is updated as data is decrypted
       std::array<u8, 16> iv{};
+      // Encrypted data that doesn't fill a whole AES block yet
       std::vector<u8> buffer;
     };
     ContentContext content;
@@ -195,6 +198,8 @@ private:
   // Finish stale imports and clear the import directory.
   void FinishStaleImport(u64 title_id);
   void FinishAllStaleImports();
+  // Decrypt whole AES blocks of the content being imported and append them to its temporary file.
+  ReturnCode DecryptAndWriteContent(Context& context, std::span<const u8> encrypted_data);
 
   std::string GetContentPath(u64 title_id, const ES::Content& content, Ticks ticks = {}) const;
 
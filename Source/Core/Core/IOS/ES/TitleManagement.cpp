@@ -4,13 +4,18 @@
 #include "Core/IOS/ES/ES.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <future>
+#include <span>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 
 #include "Common/Align.h"
+#include "Common/Crypto/AES.h"
 #include "Common/Crypto/SHA1.h"
 #include "Common/EnumUtils.h"
 #include "Common/Logging/Log.h"
@@ -24,6 +29,13 @@
 
 namespace IOS::HLE
 {
+constexpr size_t AES_BLOCK_SIZE = Common::AES::Context::BLOCK_SIZE;
+
+static std::string GetImportContentTempPath(u32 content_id)
+{
+  return fmt::format("/tmp/{:08x}.app", content_id);
+}
+
 static ReturnCode WriteTicket(FS::FileSystem* fs, const ES::TicketReader& ticket)
 {
   const u64 title_id = ticket.GetTitleId();
@@ -328,6 +340,19 @@ ReturnCode ESCore::ImportContentBegin(Context& context, u64 title_id, u32 conten
   context.title_import_export.content.iv[0] = (content_info.index >> 8) & 0xFF;
   context.title_import_export.content.iv[1] = content_info.index & 0xFF;
 
+  // Decrypted data is streamed into a temporary file as it arrives (see ImportContentData)
+  const auto fs = m_ios.GetFS();
+  const std::string temp_path = GetImportContentTempPath(content_info.id);
+  fs->Delete(PID_KERNEL, PID_KERNEL, temp_path);
+  constexpr FS::Modes content_modes{FS::Mode::ReadWrite, FS::Mode::ReadWrite, FS::Mode::None};
+  const FS::ResultCode create_result =
+      fs->CreateFile(PID_KERNEL, PID_KERNEL, temp_path, 0, content_modes);
+  if (create_result != FS::ResultCode::Success)
+  {
+    ERROR_LOG_FMT(IOS_ES, "ImportContentBegin: Failed to create {}", temp_path);
+    return FS::ConvertResult(create_result);
+  }
+
   context.title_import_export.content.valid = true;
 
   // We're supposed to return a "content file descriptor" here, which is
@@ -355,8 +380,116 @@ ReturnCode ESCore::ImportContentData(Context& context, u32 content_fd, const u8*
                                      u32 data_size)
 {
   INFO_LOG_FMT(IOS_ES, "ImportContentData: content fd {:08x}, size {}", content_fd, data_size);
-  context.title_import_export.content.buffer.insert(
-      context.title_import_export.content.buffer.end(), data, data + data_size);
+
+  if (!context.title_import_export.valid || !context.title_import_export.content.valid)
+    return ES_EINVAL;
+
+  // Only whole AES blocks can be decrypted. Whatever is left over is kept in the buffer until the
+  // next call, so the buffer never holds more than one block.
+  std::vector<u8>& pending = context.title_import_export.content.buffer;
+  std::span<const u8> input(data, data_size);
+  if (!pending.empty())
+  {
+    const size_t missing = Common::AlignUp(pending.size(), AES_BLOCK_SIZE) - pending.size();
+    const size_t fill = std::min(missing, input.size());
+    pending.insert(pending.end(), input.begin(), input.begin() + fill);
+    input = input.subspan(fill);
+    if (pending.size() % AES_BLOCK_SIZE != 0)
+      return IPC_SUCCESS;
+
+    const ReturnCode ret = DecryptAndWriteContent(context, pending);
+    pending.clear();
+    if (ret != IPC_SUCCESS)
+      return ret;
+  }
+
+  const size_t aligned_size = Common::AlignDown(input.size(), AES_BLOCK_SIZE);
+  const ReturnCode ret = DecryptAndWriteContent(context, input.first(aligned_size));
+  if (ret != IPC_SUCCESS)
+    return ret;
+
+  pending.assign(input.begin() + aligned_size, input.end());
+  return IPC_SUCCESS;
+}
+
+// CBC decryption of a block only depends on the ciphertext, so large inputs are split into slices
+// that are decrypted concurrently, each using the last ciphertext block before it as its IV.
+static ReturnCode DecryptContent(const IOSC& iosc, IOSC::Handle key_handle,
+                                 std::array<u8, 16>& iv, std::span<const u8> input, u8* output)
+{
+  constexpr size_t MIN_SLICE_SIZE = 0x100000;
+  const size_t block_count = input.size() / AES_BLOCK_SIZE;
+  const size_t thread_count = std::clamp<size_t>(
+      std::thread::hardware_concurrency(), 1, std::max<size_t>(input.size() / MIN_SLICE_SIZE, 1));
+  if (thread_count == 1)
+    return iosc.Decrypt(key_handle, iv.data(), input.data(), input.size(), output, PID_ES);
+
+  const auto decrypt_slice = [&](size_t slice) {
+    const size_t begin = block_count * slice / thread_count * AES_BLOCK_SIZE;
+    const size_t end = block_count * (slice + 1) / thread_count * AES_BLOCK_SIZE;
+    std::array<u8, 16> slice_iv = iv;
+    if (slice != 0)
+      std::copy_n(input.data() + begin - AES_BLOCK_SIZE, AES_BLOCK_SIZE, slice_iv.begin());
+    return iosc.Decrypt(key_handle, slice_iv.data(), input.data() + begin, end - begin,
+                        output + begin, PID_ES);
+  };
+
+  std::vector<std::future<ReturnCode>> futures(thread_count - 1);
+  for (size_t i = 0; i < futures.size(); ++i)
+    futures[i] = std::async(std::launch::async, decrypt_slice, i + 1);
+
+  ReturnCode ret = decrypt_slice(0);
+  for (auto& future : futures)
+  {
+    const ReturnCode slice_ret = future.get();
+    if (ret == IPC_SUCCESS)
+      ret = slice_ret;
+  }
+
+  std::copy_n(input.end() - AES_BLOCK_SIZE, AES_BLOCK_SIZE, iv.begin());
+  return ret;
+}
+
+ReturnCode ESCore::DecryptAndWriteContent(Context& context, std::span<const u8> encrypted_data)
+{
+  if (encrypted_data.empty())
+    return IPC_SUCCESS;
+
+  auto& content = context.title_import_export.content;
+  ES::Content content_info;
+  if (!context.title_import_export.tmd.FindContentById(content.id, &content_info))
+    return ES_EINVAL;
+
+  std::vector<u8> decrypted_data(encrypted_data.size());
+  const ReturnCode decrypt_ret =
+      DecryptContent(m_ios.GetIOSC(), context.title_import_export.key_handle, content.iv,
+                     encrypted_data, decrypted_data.data());
+  if (decrypt_ret != IPC_SUCCESS)
+    return decrypt_ret;
+
+  const std::string temp_path = GetImportContentTempPath(content.id);
+  constexpr FS::Modes content_modes{FS::Mode::ReadWrite, FS::Mode::ReadWrite, FS::Mode::None};
+  const auto file =
+      m_ios.GetFS()->CreateAndOpenFile(PID_KERNEL, PID_KERNEL, temp_path, content_modes);
+  if (!file)
+  {
+    ERROR_LOG_FMT(IOS_ES, "ImportContentData: Failed to open {}", temp_path);
+    return FS::ConvertResult(file.Error());
+  }
+  const auto status = file->GetStatus();
+  if (!status)
+    return FS::ConvertResult(status.Error());
+
+  // The encrypted content is padded, but only the actual content is stored
+  const u64 written = std::min<u64>(status->size, content_info.size);
+  const u64 size = std::min<u64>(decrypted_data.size(), content_info.size - written);
+  if (size != 0 &&
+      (!file->Seek(status->size, FS::SeekMode::Set) || !file->Write(decrypted_data.data(), size)))
+  {
+    ERROR_LOG_FMT(IOS_ES, "ImportContentData: Failed to write to {}", temp_path);
+    return ES_EIO;
+  }
+
   return IPC_SUCCESS;
 }
 
@@ -374,9 +507,31 @@ IPCReply ESDevice::ImportContentData(Context& context, const IOCtlVRequest& requ
   return IPCReply(m_core.ImportContentData(context, content_fd, data_start, data_size));
 }
 
-static bool CheckIfContentHashMatches(const std::vector<u8>& content, const ES::Content& info)
+// Reads the file back in chunks and hashes each chunk on another thread while the next one is
+// being read, so that memory usage does not depend on the size of the content.
+static std::optional<Common::SHA1::Digest> CalculateFileDigest(const FS::FileHandle& file,
+                                                               u32 size)
 {
-  return Common::SHA1::CalculateDigest(content.data(), info.size) == info.sha1;
+  constexpr u32 CHUNK_SIZE = 0x100000;
+  const auto context = Common::SHA1::CreateContext();
+  std::array<std::vector<u8>, 2> buffers;
+  std::future<void> hash_result;
+
+  for (u32 offset = 0, i = 0; offset < size; offset += CHUNK_SIZE, ++i)
+  {
+    std::vector<u8>& buffer = buffers[i % buffers.size()];
+    buffer.resize(std::min(CHUNK_SIZE, size - offset));
+    const bool read_success = file.Read(buffer.data(), buffer.size()).Succeeded();
+    if (hash_result.valid())
+      hash_result.wait();
+    if (!read_success)
+      return std::nullopt;
+    hash_result = std::async(std::launch::async, [&context, &buffer] { context->Update(buffer); });
+  }
+
+  if (hash_result.valid())
+    hash_result.wait();
+  return context->Finish();
 }
 
 static std::string GetImportContentPath(u64 title_id, u32 content_id)
@@ -391,25 +546,44 @@ ReturnCode ESCore::ImportContentEnd(Context& context, u32 content_fd)
   if (!context.title_import_export.valid || !context.title_import_export.content.valid)
     return ES_EINVAL;
 
-  std::vector<u8> decrypted_data(context.title_import_export.content.buffer.size());
-  const ReturnCode decrypt_ret = m_ios.GetIOSC().Decrypt(
-      context.title_import_export.key_handle, context.title_import_export.content.iv.data(),
-      context.title_import_export.content.buffer.data(),
-      context.title_import_export.content.buffer.size(), decrypted_data.data(), PID_ES);
-  if (decrypt_ret != IPC_SUCCESS)
-    return decrypt_ret;
+  // The encrypted content is always padded to a multiple of the AES block size. The buffer can
+  // still hold whole blocks when the import was started before a savestate from older versions,
+  // which kept the entire content in the buffer.
+  std::vector<u8>& pending = context.title_import_export.content.buffer;
+  if (pending.size() % AES_BLOCK_SIZE != 0)
+  {
+    ERROR_LOG_FMT(IOS_ES, "ImportContentEnd: Content {:08x} is not a multiple of the block size",
+                  context.title_import_export.content.id);
+    return ES_EINVAL;
+  }
+  const ReturnCode write_ret = DecryptAndWriteContent(context, pending);
+  pending.clear();
+  if (write_ret != IPC_SUCCESS)
+    return write_ret;
 
   ES::Content content_info;
   context.title_import_export.tmd.FindContentById(context.title_import_export.content.id,
                                                   &content_info);
-  if (!CheckIfContentHashMatches(decrypted_data, content_info))
+
+  const auto fs = m_ios.GetFS();
+  const std::string temp_path = GetImportContentTempPath(content_info.id);
+  const bool hash_matches = [&] {
+    const auto file = fs->OpenFile(PID_KERNEL, PID_KERNEL, temp_path, FS::Mode::Read);
+    if (!file)
+      return false;
+    const auto status = file->GetStatus();
+    if (!status || status->size != content_info.size)
+      return false;
+    return CalculateFileDigest(*file, status->size) == content_info.sha1;
+  }();
+  if (!hash_matches)
   {
     ERROR_LOG_FMT(IOS_ES, "ImportContentEnd: Hash for content {:08x} doesn't match",
                   content_info.id);
+    fs->Delete(PID_KERNEL, PID_KERNEL, temp_path);
     return ES_HASH_MISMATCH;
   }
 
-  const auto fs = m_ios.GetFS();
   std::string content_path;
   if (content_info.IsShared())
   {
@@ -422,19 +596,6 @@ ReturnCode ESCore::ImportContentEnd(Context& context, u32 content_fd)
                                         context.title_import_export.content.id);
   }
 
-  const std::string temp_path =
-      "/tmp/" + content_path.substr(content_path.find_last_of('/') + 1, std::string::npos);
-
-  {
-    constexpr FS::Modes content_modes{FS::Mode::ReadWrite, FS::Mode::ReadWrite, FS::Mode::None};
-    const auto file = fs->CreateAndOpenFile(PID_KERNEL, PID_KERNEL, temp_path, content_modes);
-    if (!file || !file->Write(decrypted_data.data(), content_info.size))
-    {
-      ERROR_LOG_FMT(IOS_ES, "ImportContentEnd: Failed to write to {}", temp_path);
-      return ES_EIO;
-    }
-  }
-
   const FS::ResultCode rename_result = fs->Rename(PID_KERNEL, PID_KERNEL, temp_path, content_path);
   if (rename_result != FS::ResultCode::Success)
   {
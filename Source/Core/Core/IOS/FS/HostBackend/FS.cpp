@@ -402,16 +402,10 @@ void HostFileSystem::DoState(PointerWrap& p)
   if (!p.IsReadMode())
   {
     DoStateWriteOrMeasure(p, "/tmp");
-    u8* previous_position = p.ReserveU32();
+    const size_t size_of_nand_position = p.ReserveU32();
     if (original_save_state_made_during_movie_recording)
-    {
       DoStateWriteOrMeasure(p, "/");
-      if (p.IsWriteMode())
-      {
-        u32 size_of_nand = p.GetOffsetFromPreviousPosition(previous_position) - sizeof(u32);
-        memcpy(previous_position, &size_of_nand, sizeof(u32));
-      }
-    }
+    p.SetReservedU32(size_of_nand_position, p.GetOffsetFromReservedU32(size_of_nand_position));
   }
   else  // case where we're in read mode.
   {
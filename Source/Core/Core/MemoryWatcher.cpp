@@ -3,13 +3,19 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <fstream>
-#include <iostream>
+#include <iterator>
 #include <sstream>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 
@@ -18,8 +24,22 @@ MemoryWatcher::MemoryWatcher()
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+
+  bool has_output = false;
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_SOCKET) &&
+      OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  {
+    has_output = true;
+  }
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY) &&
+      OpenSharedMemory(File::GetUserPath(F_MEMORYWATCHERVALUES_IDX)))
+  {
+    has_output = true;
+  }
+  if (!has_output)
     return;
+
+  m_poll_interval = std::max(Config::Get(Config::MAIN_MEMORY_WATCHER_POLL_INTERVAL), 1);
   m_running = true;
 }
 
@@ -29,7 +49,9 @@ MemoryWatcher::~MemoryWatcher()
     return;
 
   m_running = false;
-  close(m_fd);
+  if (m_fd >= 0)
+    close(m_fd);
+  m_shared_memory.Close();
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -43,19 +65,24 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
+  m_values.assign(m_labels.size(), 0);
+  m_changed.assign(m_labels.size(), 0);
   return !m_values.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
-
   std::istringstream offsets(line);
   offsets >> std::hex;
-  u32 offset;
-  while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+  std::copy(std::istream_iterator<u32>(offsets), std::istream_iterator<u32>(),
+            std::back_inserter(m_offsets));
+
+  // Lines without any address would never change, so they aren't watched
+  if (m_offsets.size() == (m_offsets_end.empty() ? 0 : m_offsets_end.back()))
+    return;
+
+  m_labels.push_back(line);
+  m_offsets_end.push_back(static_cast<u32>(m_offsets.size()));
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,38 +94,77 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  const std::size_t size = sizeof(SharedHeader) + m_values.size() * sizeof(u32);
+  if (!m_shared_memory.Open(path, Common::MappedFile::Mode::ReadWrite, size))
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Failed to map '{}'", path);
+    return false;
+  }
+
+  SharedHeader header{};
+  header.magic = SHARED_MAGIC;
+  header.version = SHARED_VERSION;
+  header.value_count = static_cast<u32>(m_values.size());
+  std::memcpy(m_shared_memory.GetData(), &header, sizeof(header));
+  std::memset(m_shared_memory.GetData() + sizeof(header), 0, size - sizeof(header));
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, std::size_t index) const
 {
+  const u32 begin = index == 0 ? 0 : m_offsets_end[index - 1];
+  const u32 end = m_offsets_end[index];
+
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 i = begin; i < end; ++i)
   {
-    value = PowerPC::MMU::HostRead_U32(guard, value + offset);
+    value = PowerPC::MMU::HostRead_U32(guard, value + m_offsets[i]);
     if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
       break;
   }
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
+bool MemoryWatcher::UpdateValues(const Core::CPUThreadGuard& guard)
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  bool any_changed = false;
+  for (std::size_t i = 0; i < m_values.size(); ++i)
+  {
+    const u32 new_value = ChasePointer(guard, i);
+    m_changed[i] = new_value != m_values[i];
+    any_changed |= m_changed[i] != 0;
+    m_values[i] = new_value;
+  }
+  return any_changed;
+}
 
-  for (auto& entry : m_values)
+void MemoryWatcher::SendMessages()
+{
+  m_message.clear();
+  for (std::size_t i = 0; i < m_values.size(); ++i)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
-    {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
-    }
+    if (m_changed[i])
+      fmt::format_to(std::back_inserter(m_message), "{}\n{:x}\n", m_labels[i], m_values[i]);
   }
 
-  return message_stream.str();
+  sendto(m_fd, m_message.c_str(), m_message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+         sizeof(m_addr));
+}
+
+void MemoryWatcher::ExportValues()
+{
+  u8* const data = m_shared_memory.GetData();
+  std::atomic_ref<u64> sequence(reinterpret_cast<SharedHeader*>(data)->sequence);
+
+  // All values are written in one go between two sequence increments (a seqlock), so readers
+  // never see a mix of old and new values.
+  const u64 start = sequence.load(std::memory_order_relaxed);
+  sequence.store(start + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(data + sizeof(SharedHeader), m_values.data(), m_values.size() * sizeof(u32));
+  sequence.store(start + 2, std::memory_order_release);
 }
 
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
@@ -106,7 +172,18 @@ void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-         sizeof(m_addr));
+  if (m_frames_until_poll > 0)
+  {
+    --m_frames_until_poll;
+    return;
+  }
+  m_frames_until_poll = m_poll_interval - 1;
+
+  const bool any_changed = UpdateValues(guard);
+
+  if (m_fd >= 0)
+    SendMessages();
+
+  if (any_changed && m_shared_memory.IsOpen())
+    ExportValues();
 }
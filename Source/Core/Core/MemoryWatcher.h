@@ -4,8 +4,8 @@
 #pragma once
 
 #include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
 
-#include <map>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -24,9 +24,28 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// Optionally, the values are also exported to a memory-mapped file, which lets tools watching
+// many addresses read them without parsing messages. The file starts with a SharedHeader,
+// followed by one u32 per non-empty line of the input file, in file order. The sequence number
+// is odd while the values are being written and is incremented again once they are consistent;
+// readers should retry if it was odd or changed while they copied the values.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 SHARED_MAGIC = 0x5657444D;  // "MDWV"
+  static constexpr u32 SHARED_VERSION = 1;
+
+  struct SharedHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 value_count;
+    u32 padding;
+    u64 sequence;
+  };
+  static_assert(sizeof(SharedHeader) == 24);
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step(const Core::CPUThreadGuard& guard);
@@ -34,18 +53,35 @@ public:
 private:
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
-  std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  u32 ChasePointer(const Core::CPUThreadGuard& guard, std::size_t index) const;
+  // Re-reads all watched values. Returns whether any of them changed.
+  bool UpdateValues(const Core::CPUThreadGuard& guard);
+  void SendMessages();
+  void ExportValues();
 
   bool m_running = false;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  Common::MappedFile m_shared_memory;
+
+  int m_poll_interval = 1;
+  int m_frames_until_poll = 0;
+
+  // Address as stored in the file, for every watch in file order
+  std::vector<std::string> m_labels;
+  // Offsets to follow of all watches, back to back
+  std::vector<u32> m_offsets;
+  // End of the offsets of every watch in m_offsets; a watch starts where the previous one ends
+  std::vector<u32> m_offsets_end;
+  // Current value of every watch
+  std::vector<u32> m_values;
+  // Whether the value of every watch changed during the last update
+  std::vector<u8> m_changed;
+
+  std::string m_message;
 };
@@ -220,7 +220,8 @@ void BreakPoints::ClearTemporary()
   }
 }
 
-MemChecks::MemChecks(Core::System& system) : m_system(system)
+MemChecks::MemChecks(Core::System& system)
+    : m_watched_pages(WATCHED_PAGE_COUNT / 64), m_system(system)
 {
 }
 
@@ -287,8 +288,6 @@ void MemChecks::AddFromStrings(const TMemChecksStr& mc_strings)
 
 void MemChecks::Add(TMemCheck memory_check)
 {
-  bool had_any = HasAny();
-
   const Core::CPUThreadGuard guard(m_system);
   // Check for existing breakpoint, and overwrite with new info.
   // This is assuming we usually want the new breakpoint over an old one.
@@ -306,11 +305,7 @@ void MemChecks::Add(TMemCheck memory_check)
   {
     m_mem_checks.emplace_back(std::move(memory_check));
   }
-  // If this is the first one, clear the JIT cache so it can switch to
-  // watchpoint-compatible code.
-  if (!had_any)
-    m_system.GetJitInterface().ClearCache(guard);
-  m_system.GetMMU().DBATUpdated();
+  OnMemChecksChanged(guard);
 }
 
 bool MemChecks::ToggleEnable(u32 address)
@@ -336,9 +331,7 @@ bool MemChecks::Remove(u32 address)
 
   const Core::CPUThreadGuard guard(m_system);
   m_mem_checks.erase(iter);
-  if (!HasAny())
-    m_system.GetJitInterface().ClearCache(guard);
-  m_system.GetMMU().DBATUpdated();
+  OnMemChecksChanged(guard);
   return true;
 }
 
@@ -346,12 +339,38 @@ void MemChecks::Clear()
 {
   const Core::CPUThreadGuard guard(m_system);
   m_mem_checks.clear();
+  OnMemChecksChanged(guard);
+}
+
+void MemChecks::OnMemChecksChanged(const Core::CPUThreadGuard& guard)
+{
+  UpdateWatchedPages();
+
+  // Only the pages overlapping memchecks lose their fastmem mappings, and the JIT only skips
+  // address checks for accesses to pages without memchecks, so any change to the set of watched
+  // pages requires recompiling.
   m_system.GetJitInterface().ClearCache(guard);
   m_system.GetMMU().DBATUpdated();
 }
 
+void MemChecks::UpdateWatchedPages()
+{
+  std::fill(m_watched_pages.begin(), m_watched_pages.end(), 0);
+
+  for (const TMemCheck& mc : m_mem_checks)
+  {
+    const u32 first_page = mc.start_address >> WATCHED_PAGE_SHIFT;
+    const u32 last_page = std::max(mc.start_address, mc.end_address) >> WATCHED_PAGE_SHIFT;
+    for (u32 page = first_page; page <= last_page; ++page)
+      m_watched_pages[page / 64] |= u64(1) << (page % 64);
+  }
+}
+
 TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
 {
+  if (!OverlapsMemcheck(address, static_cast<u32>(std::clamp<size_t>(size, 1, UINT32_MAX))))
+    return nullptr;
+
   const auto iter =
       std::find_if(m_mem_checks.begin(), m_mem_checks.end(), [address, size](const auto& mc) {
         return mc.end_address >= address && address + size - 1 >= mc.start_address;
@@ -366,18 +385,24 @@ TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
 
 bool MemChecks::OverlapsMemcheck(u32 address, u32 length) const
 {
-  if (!HasAny())
+  if (!HasAny() || length == 0)
     return false;
 
-  const u32 page_end_suffix = length - 1;
-  const u32 page_end_address = address | page_end_suffix;
-
-  return std::any_of(m_mem_checks.cbegin(), m_mem_checks.cend(), [&](const auto& mc) {
-    return ((mc.start_address | page_end_suffix) == page_end_address ||
-            (mc.end_address | page_end_suffix) == page_end_address) ||
-           ((mc.start_address | page_end_suffix) < page_end_address &&
-            (mc.end_address | page_end_suffix) > page_end_address);
-  });
+  const u32 first_page = address >> WATCHED_PAGE_SHIFT;
+  const u32 last_address = address + (length - 1) < address ? UINT32_MAX : address + (length - 1);
+  const u32 last_page = last_address >> WATCHED_PAGE_SHIFT;
+  for (u32 page = first_page; page <= last_page; ++page)
+  {
+    // Skip over whole words of unwatched pages.
+    if (page % 64 == 0 && last_page - page >= 63 && m_watched_pages[page / 64] == 0)
+    {
+      page += 63;
+      continue;
+    }
+    if (IsPageWatched(page))
+      return true;
+  }
+  return false;
 }
 
 bool TMemCheck::Action(Core::System& system, u64 value, u32 addr, bool write, size_t size, u32 pc)
@@ -13,6 +13,7 @@
 
 namespace Core
 {
+class CPUThreadGuard;
 class System;
 }
 
@@ -120,6 +121,8 @@ public:
   bool ToggleEnable(u32 address);
 
   TMemCheck* GetMemCheck(u32 address, size_t size = 1);
+  // Returns whether any memcheck overlaps the range. This only looks at the page index, so it's
+  // cheap, but it may report overlaps for addresses that share a page with a memcheck.
   bool OverlapsMemcheck(u32 address, u32 length) const;
   // Remove Breakpoint. Returns whether it was removed.
   bool Remove(u32 address);
@@ -128,6 +131,17 @@ public:
   bool HasAny() const { return !m_mem_checks.empty(); }
 
 private:
+  // Granularity of the page index. Fastmem is disabled at BAT page granularity, which is larger.
+  static constexpr u32 WATCHED_PAGE_SHIFT = 12;
+  static constexpr u32 WATCHED_PAGE_COUNT = 1 << (32 - WATCHED_PAGE_SHIFT);
+
+  void UpdateWatchedPages();
+  bool IsPageWatched(u32 page) const { return (m_watched_pages[page / 64] >> (page % 64)) & 1; }
+  void OnMemChecksChanged(const Core::CPUThreadGuard& guard);
+
   TMemChecks m_mem_checks;
+  // One bit per page of the effective address space, set if any memcheck overlaps the page.
+  // Lets loads and stores on unwatched pages skip the search through m_mem_checks.
+  std::vector<u64> m_watched_pages;
   Core::System& m_system;
 };
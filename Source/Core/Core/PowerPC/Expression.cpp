@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <fmt/format.h>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -399,6 +400,419 @@ Expression::Expression(std::string_view text, ExprPointer ex, ExprVarListPointer
     else
       m_binds.emplace_back();
   }
+
+  if (!Compile())
+    m_program.clear();
+}
+
+bool Expression::Compile()
+{
+  // Variables that aren't registers are temporaries and start out as zero on every evaluation.
+  auto bind = m_binds.begin();
+  for (auto* v = m_vars->head; v != nullptr; v = v->next, ++bind)
+  {
+    if (bind->type == VarBindingType::Zero)
+    {
+      m_program.push_back({Opcode::PushConst});
+      m_program.push_back({.opcode = Opcode::StoreVar, .var = &v->value});
+      m_program.push_back({Opcode::Pop});
+    }
+  }
+
+  size_t depth = 0;
+  m_max_depth = 1;
+  return CompileNode(m_expr.get(), &depth) && depth == 1 && m_max_depth <= MAX_STACK_DEPTH;
+}
+
+bool Expression::CompileNode(const expr* e, size_t* depth)
+{
+  static constexpr auto opcode_for_op = [](expr_type type) -> std::optional<Opcode> {
+    switch (type)
+    {
+    case OP_UNARY_MINUS:
+      return Opcode::Negate;
+    case OP_UNARY_LOGICAL_NOT:
+      return Opcode::LogicalNot;
+    case OP_UNARY_BITWISE_NOT:
+      return Opcode::BitwiseNot;
+    case OP_POWER:
+      return Opcode::Power;
+    case OP_DIVIDE:
+      return Opcode::Divide;
+    case OP_MULTIPLY:
+      return Opcode::Multiply;
+    case OP_REMAINDER:
+      return Opcode::Remainder;
+    case OP_PLUS:
+      return Opcode::Plus;
+    case OP_MINUS:
+      return Opcode::Minus;
+    case OP_SHL:
+      return Opcode::ShiftLeft;
+    case OP_SHR:
+      return Opcode::ShiftRight;
+    case OP_LT:
+      return Opcode::Less;
+    case OP_LE:
+      return Opcode::LessEqual;
+    case OP_GT:
+      return Opcode::Greater;
+    case OP_GE:
+      return Opcode::GreaterEqual;
+    case OP_EQ:
+      return Opcode::Equal;
+    case OP_NE:
+      return Opcode::NotEqual;
+    case OP_BITWISE_AND:
+      return Opcode::BitwiseAnd;
+    case OP_BITWISE_OR:
+      return Opcode::BitwiseOr;
+    case OP_BITWISE_XOR:
+      return Opcode::BitwiseXor;
+    default:
+      return std::nullopt;
+    }
+  };
+
+  static constexpr auto opcode_for_func = [](std::string_view name) -> std::optional<Opcode> {
+    using enum Opcode;
+    static constexpr std::array<std::pair<std::string_view, Opcode>, 14> funcs{{
+        {"read_u8", ReadU8},
+        {"read_s8", ReadS8},
+        {"read_u16", ReadU16},
+        {"read_s16", ReadS16},
+        {"read_u32", ReadU32},
+        {"read_s32", ReadS32},
+        {"read_f32", ReadF32},
+        {"read_f64", ReadF64},
+        {"u8", CastU8},
+        {"s8", CastS8},
+        {"u16", CastU16},
+        {"s16", CastS16},
+        {"u32", CastU32},
+        {"s32", CastS32},
+    }};
+    const auto iter = std::ranges::find(funcs, name, &std::pair<std::string_view, Opcode>::first);
+    if (iter == funcs.end())
+      return std::nullopt;
+    return iter->second;
+  };
+
+  const auto push = [&](Instruction instruction) {
+    m_program.push_back(instruction);
+    m_max_depth = std::max(m_max_depth, ++*depth);
+  };
+
+  const auto op_args = [e] {
+    return std::span<const expr>(e->param.op.args.buf, e->param.op.args.len);
+  };
+
+  switch (e->type)
+  {
+  case OP_CONST:
+    push({.opcode = Opcode::PushConst, .value = e->param.num.value});
+    return true;
+
+  case OP_VAR:
+  {
+    auto bind = m_binds.begin();
+    for (auto* v = m_vars->head; v != nullptr; v = v->next, ++bind)
+    {
+      if (&v->value != e->param.var.value)
+        continue;
+
+      const u32 index = static_cast<u32>(bind->index);
+      switch (bind->type)
+      {
+      case VarBindingType::Zero:
+        push({.opcode = Opcode::PushVar, .var = &v->value});
+        break;
+      case VarBindingType::GPR:
+        push({.opcode = Opcode::PushGPR, .index = index});
+        break;
+      case VarBindingType::FPR:
+        push({.opcode = Opcode::PushFPR, .index = index});
+        m_program_may_have_nan_vars = true;
+        break;
+      case VarBindingType::SPR:
+        push({.opcode = Opcode::PushSPR, .index = index});
+        break;
+      case VarBindingType::PCtr:
+        push({Opcode::PushPC});
+        break;
+      case VarBindingType::MSR:
+        push({Opcode::PushMSR});
+        break;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  case OP_ASSIGN:
+  {
+    // Assignments to registers are left to the interpreter, which writes them back after the
+    // evaluation has finished.
+    const std::span<const expr> args = op_args();
+    if (args[0].type != OP_VAR)
+      return false;
+    auto bind = m_binds.begin();
+    for (auto* v = m_vars->head; v != nullptr; v = v->next, ++bind)
+    {
+      if (&v->value != args[0].param.var.value)
+        continue;
+      if (bind->type != VarBindingType::Zero || !CompileNode(&args[1], depth))
+        return false;
+      m_program.push_back({.opcode = Opcode::StoreVar, .var = &v->value});
+      m_program_may_have_nan_vars = true;
+      return true;
+    }
+    return false;
+  }
+
+  case OP_COMMA:
+  {
+    const std::span<const expr> args = op_args();
+    if (!CompileNode(&args[0], depth))
+      return false;
+    m_program.push_back({Opcode::Pop});
+    --*depth;
+    return CompileNode(&args[1], depth);
+  }
+
+  case OP_LOGICAL_AND:
+  case OP_LOGICAL_OR:
+  {
+    const std::span<const expr> args = op_args();
+    if (!CompileNode(&args[0], depth))
+      return false;
+    const size_t jump = m_program.size();
+    m_program.push_back(
+        {e->type == OP_LOGICAL_AND ? Opcode::JumpIfZero : Opcode::JumpIfNonZero});
+    --*depth;
+    if (!CompileNode(&args[1], depth))
+      return false;
+    // A zero left-hand side of && is normalized as well.
+    if (e->type == OP_LOGICAL_AND)
+      m_program[jump].index = static_cast<u32>(m_program.size());
+    m_program.push_back({Opcode::NormalizeZero});
+    if (e->type == OP_LOGICAL_OR)
+      m_program[jump].index = static_cast<u32>(m_program.size());
+    return true;
+  }
+
+  case OP_FUNC:
+  {
+    const std::optional<Opcode> opcode = opcode_for_func(e->param.func.f->name);
+    const std::span<const expr> func_args(e->param.func.args.buf, e->param.func.args.len);
+    if (!opcode || func_args.size() != 1 || !CompileNode(&func_args[0], depth))
+      return false;
+    m_program.push_back({*opcode});
+    if (*opcode >= Opcode::ReadU8 && *opcode <= Opcode::ReadF64)
+      m_program_reads_memory = true;
+    return true;
+  }
+
+  default:
+  {
+    const std::optional<Opcode> opcode = opcode_for_op(e->type);
+    if (!opcode)
+      return false;
+    const std::span<const expr> args = op_args();
+    if (args.empty())
+      return false;
+    for (const expr& arg : args)
+    {
+      if (!CompileNode(&arg, depth))
+        return false;
+    }
+    m_program.push_back({*opcode});
+    *depth -= args.size() - 1;
+    return true;
+  }
+  }
+}
+
+double Expression::RunProgram(Core::System& system) const
+{
+  const auto& ppc_state = system.GetPPCState();
+
+  std::optional<Core::CPUThreadGuard> guard;
+  if (m_program_reads_memory)
+    guard.emplace(system);
+
+  std::array<double, MAX_STACK_DEPTH> stack;
+  size_t sp = 0;
+
+  const auto unary = [&](auto op) { stack[sp - 1] = op(stack[sp - 1]); };
+  const auto binary = [&](auto op) {
+    --sp;
+    stack[sp - 1] = op(stack[sp - 1], stack[sp]);
+  };
+  const auto read = [&]<typename T, typename U = T>() {
+    stack[sp - 1] = std::bit_cast<T>(HostRead<U>(*guard, static_cast<u32>(stack[sp - 1])));
+  };
+  const auto cast = [&]<typename T, typename U = T>() {
+    stack[sp - 1] = std::bit_cast<T>(static_cast<U>(stack[sp - 1]));
+  };
+
+  for (size_t pc = 0; pc < m_program.size(); ++pc)
+  {
+    const Instruction& instruction = m_program[pc];
+    switch (instruction.opcode)
+    {
+    case Opcode::PushConst:
+      stack[sp++] = instruction.value;
+      break;
+    case Opcode::PushVar:
+      stack[sp++] = *instruction.var;
+      break;
+    case Opcode::PushGPR:
+      stack[sp++] = static_cast<double>(ppc_state.gpr[instruction.index]);
+      break;
+    case Opcode::PushFPR:
+      stack[sp++] = ppc_state.ps[instruction.index].PS0AsDouble();
+      break;
+    case Opcode::PushSPR:
+      stack[sp++] = static_cast<double>(ppc_state.spr[instruction.index]);
+      break;
+    case Opcode::PushPC:
+      stack[sp++] = static_cast<double>(ppc_state.pc);
+      break;
+    case Opcode::PushMSR:
+      stack[sp++] = static_cast<double>(ppc_state.msr.Hex);
+      break;
+    case Opcode::StoreVar:
+      *instruction.var = stack[sp - 1];
+      break;
+    case Opcode::Pop:
+      --sp;
+      break;
+
+    case Opcode::Negate:
+      unary([](double a) { return -a; });
+      break;
+    case Opcode::LogicalNot:
+      unary([](double a) { return static_cast<double>(!a); });
+      break;
+    case Opcode::BitwiseNot:
+      unary([](double a) { return static_cast<double>(~to_int(a)); });
+      break;
+    case Opcode::Power:
+      binary([](double a, double b) { return std::pow(a, b); });
+      break;
+    case Opcode::Divide:
+      binary([](double a, double b) { return a / b; });
+      break;
+    case Opcode::Multiply:
+      binary([](double a, double b) { return a * b; });
+      break;
+    case Opcode::Remainder:
+      binary([](double a, double b) { return std::fmod(a, b); });
+      break;
+    case Opcode::Plus:
+      binary([](double a, double b) { return a + b; });
+      break;
+    case Opcode::Minus:
+      binary([](double a, double b) { return a - b; });
+      break;
+    case Opcode::ShiftLeft:
+      binary([](double a, double b) { return static_cast<double>(to_int(a) << to_int(b)); });
+      break;
+    case Opcode::ShiftRight:
+      binary([](double a, double b) { return static_cast<double>(to_int(a) >> to_int(b)); });
+      break;
+    case Opcode::Less:
+      binary([](double a, double b) { return static_cast<double>(a < b); });
+      break;
+    case Opcode::LessEqual:
+      binary([](double a, double b) { return static_cast<double>(a <= b); });
+      break;
+    case Opcode::Greater:
+      binary([](double a, double b) { return static_cast<double>(a > b); });
+      break;
+    case Opcode::GreaterEqual:
+      binary([](double a, double b) { return static_cast<double>(a >= b); });
+      break;
+    case Opcode::Equal:
+      binary([](double a, double b) { return static_cast<double>(a == b); });
+      break;
+    case Opcode::NotEqual:
+      binary([](double a, double b) { return static_cast<double>(a != b); });
+      break;
+    case Opcode::BitwiseAnd:
+      binary([](double a, double b) { return static_cast<double>(to_int(a) & to_int(b)); });
+      break;
+    case Opcode::BitwiseOr:
+      binary([](double a, double b) { return static_cast<double>(to_int(a) | to_int(b)); });
+      break;
+    case Opcode::BitwiseXor:
+      binary([](double a, double b) { return static_cast<double>(to_int(a) ^ to_int(b)); });
+      break;
+
+    case Opcode::JumpIfZero:
+      if (stack[sp - 1] == 0)
+        pc = instruction.index - 1;
+      else
+        --sp;
+      break;
+    case Opcode::JumpIfNonZero:
+      if (stack[sp - 1] != 0 && !std::isnan(stack[sp - 1]))
+        pc = instruction.index - 1;
+      else
+        --sp;
+      break;
+    case Opcode::NormalizeZero:
+      if (stack[sp - 1] == 0)
+        stack[sp - 1] = 0;
+      break;
+
+    case Opcode::ReadU8:
+      read.operator()<u8>();
+      break;
+    case Opcode::ReadS8:
+      read.operator()<s8, u8>();
+      break;
+    case Opcode::ReadU16:
+      read.operator()<u16>();
+      break;
+    case Opcode::ReadS16:
+      read.operator()<s16, u16>();
+      break;
+    case Opcode::ReadU32:
+      read.operator()<u32>();
+      break;
+    case Opcode::ReadS32:
+      read.operator()<s32, u32>();
+      break;
+    case Opcode::ReadF32:
+      read.operator()<float, u32>();
+      break;
+    case Opcode::ReadF64:
+      read.operator()<double, u64>();
+      break;
+    case Opcode::CastU8:
+      cast.operator()<u8>();
+      break;
+    case Opcode::CastS8:
+      cast.operator()<s8, u8>();
+      break;
+    case Opcode::CastU16:
+      cast.operator()<u16>();
+      break;
+    case Opcode::CastS16:
+      cast.operator()<s16, u16>();
+      break;
+    case Opcode::CastU32:
+      cast.operator()<u32>();
+      break;
+    case Opcode::CastS32:
+      cast.operator()<s32, u32>();
+      break;
+    }
+  }
+
+  return stack[0];
 }
 
 std::optional<Expression> Expression::TryParse(std::string_view text)
@@ -413,6 +827,26 @@ std::optional<Expression> Expression::TryParse(std::string_view text)
 
 double Expression::Evaluate(Core::System& system) const
 {
+  if (!m_program.empty())
+  {
+    const double result = RunProgram(system);
+
+    // Only gather the variables when there could be something to report.
+    if (result != 0.0 || std::isnan(result) || m_program_may_have_nan_vars)
+    {
+      auto& ppc_state = system.GetPPCState();
+      auto bind = m_binds.begin();
+      for (auto* v = m_vars->head; v != nullptr; v = v->next, ++bind)
+      {
+        if (bind->type != VarBindingType::Zero)
+          v->value = GetBindingValue(ppc_state, *bind);
+      }
+      Reporting(result);
+    }
+
+    return result;
+  }
+
   SynchronizeBindings(system, SynchronizeDirection::From);
 
   double result = expr_eval(m_expr.get());
@@ -424,6 +858,26 @@ double Expression::Evaluate(Core::System& system) const
   return result;
 }
 
+double Expression::GetBindingValue(const PowerPC::PowerPCState& ppc_state, VarBinding bind)
+{
+  switch (bind.type)
+  {
+  case VarBindingType::GPR:
+    return static_cast<double>(ppc_state.gpr[bind.index]);
+  case VarBindingType::FPR:
+    return ppc_state.ps[bind.index].PS0AsDouble();
+  case VarBindingType::SPR:
+    return static_cast<double>(ppc_state.spr[bind.index]);
+  case VarBindingType::PCtr:
+    return static_cast<double>(ppc_state.pc);
+  case VarBindingType::MSR:
+    return static_cast<double>(ppc_state.msr.Hex);
+  case VarBindingType::Zero:
+    break;
+  }
+  return 0;
+}
+
 void Expression::SynchronizeBindings(Core::System& system, SynchronizeDirection dir) const
 {
   auto& ppc_state = system.GetPPCState();
@@ -438,29 +892,29 @@ void Expression::SynchronizeBindings(Core::System& system, SynchronizeDirection
       break;
     case VarBindingType::GPR:
       if (dir == SynchronizeDirection::From)
-        v->value = static_cast<double>(ppc_state.gpr[bind->index]);
+        v->value = GetBindingValue(ppc_state, *bind);
       else
         ppc_state.gpr[bind->index] = static_cast<u32>(static_cast<s64>(v->value));
       break;
     case VarBindingType::FPR:
       if (dir == SynchronizeDirection::From)
-        v->value = ppc_state.ps[bind->index].PS0AsDouble();
+        v->value = GetBindingValue(ppc_state, *bind);
       else
         ppc_state.ps[bind->index].SetPS0(v->value);
       break;
     case VarBindingType::SPR:
       if (dir == SynchronizeDirection::From)
-        v->value = static_cast<double>(ppc_state.spr[bind->index]);
+        v->value = GetBindingValue(ppc_state, *bind);
       else
         ppc_state.spr[bind->index] = static_cast<u32>(static_cast<s64>(v->value));
       break;
     case VarBindingType::PCtr:
       if (dir == SynchronizeDirection::From)
-        v->value = static_cast<double>(ppc_state.pc);
+        v->value = GetBindingValue(ppc_state, *bind);
       break;
     case VarBindingType::MSR:
       if (dir == SynchronizeDirection::From)
-        v->value = static_cast<double>(ppc_state.msr.Hex);
+        v->value = GetBindingValue(ppc_state, *bind);
       else
         ppc_state.msr.Hex = static_cast<u32>(static_cast<s64>(v->value));
       break;
@@ -9,6 +9,8 @@
 #include <string_view>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 struct expr;
 struct expr_var_list;
 
@@ -17,6 +19,10 @@ namespace Core
 class CPUThreadGuard;
 class System;
 }  // namespace Core
+namespace PowerPC
+{
+struct PowerPCState;
+}
 
 struct ExprDeleter
 {
@@ -64,8 +70,81 @@ private:
     int index = -1;
   };
 
+  // Conditions are compiled into a small stack machine program when possible, so that evaluating
+  // them doesn't need to walk the expr AST or copy every variable in and out of the register state.
+  enum class Opcode : u8
+  {
+    PushConst,
+    PushVar,
+    PushGPR,
+    PushFPR,
+    PushSPR,
+    PushPC,
+    PushMSR,
+    StoreVar,
+    Pop,
+
+    Negate,
+    LogicalNot,
+    BitwiseNot,
+    Power,
+    Divide,
+    Multiply,
+    Remainder,
+    Plus,
+    Minus,
+    ShiftLeft,
+    ShiftRight,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+
+    // Short-circuiting for && and ||. Jumps to target keeping the top of the stack, or pops it.
+    JumpIfZero,
+    JumpIfNonZero,
+    // Replaces -0.0 by 0.0, matching the result expr gives for && and ||.
+    NormalizeZero,
+
+    ReadU8,
+    ReadS8,
+    ReadU16,
+    ReadS16,
+    ReadU32,
+    ReadS32,
+    ReadF32,
+    ReadF64,
+    CastU8,
+    CastS8,
+    CastU16,
+    CastS16,
+    CastU32,
+    CastS32,
+  };
+
+  struct Instruction
+  {
+    Opcode opcode;
+    // Register index or jump target
+    u32 index = 0;
+    double value = 0;
+    double* var = nullptr;
+  };
+
+  static constexpr size_t MAX_STACK_DEPTH = 32;
+
   Expression(std::string_view text, ExprPointer ex, ExprVarListPointer vars);
 
+  bool Compile();
+  bool CompileNode(const expr* e, size_t* depth);
+  double RunProgram(Core::System& system) const;
+
+  static double GetBindingValue(const PowerPC::PowerPCState& ppc_state, VarBinding bind);
   void SynchronizeBindings(Core::System& system, SynchronizeDirection dir) const;
   void Reporting(const double result) const;
 
@@ -73,6 +152,12 @@ private:
   ExprPointer m_expr;
   ExprVarListPointer m_vars;
   std::vector<VarBinding> m_binds;
+
+  std::vector<Instruction> m_program;
+  size_t m_max_depth = 0;
+  bool m_program_reads_memory = false;
+  // Whether a variable could be NaN even if the result isn't, which has to be reported.
+  bool m_program_may_have_nan_vars = false;
 };
 
 inline bool EvaluateCondition(Core::System& system, const std::optional<Expression>& condition)
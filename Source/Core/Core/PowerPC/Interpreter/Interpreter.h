@@ -36,6 +36,10 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Executes instructions up to and including the next branch or exception and returns the number
+  // of cycles they took. The caller is responsible for subtracting them from the downcount.
+  int SingleStepBlock();
+  u32 GetLastPC() const { return m_last_pc; }
 
   void Run() override;
   void ClearCache() override;
@@ -280,6 +280,7 @@ void Jit64::Init()
   m_stack_guard = nullptr;
 
   blocks.Init();
+  blocks.InitCodeRegions(region, region + region_size);
   asm_routines.Init();
 
   // important: do this *after* generating the global asm routines, because we can't use farcode in
@@ -291,6 +292,8 @@ void Jit64::Init()
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
   code_block.m_fpa = &js.fpa;
+  analyzer.SetBranchProfile(&blocks.GetBranchProfile());
+  analyzer.SetLivenessCache(&blocks.GetLivenessCache());
   EnableOptimization();
 
   ResetFreeMemoryRanges();
@@ -628,6 +631,20 @@ void Jit64::WriteBLRExit()
   }
   MOV(32, R(RSCRATCH2), Imm32(js.downcountAmount));
   CMP(64, R(RSCRATCH), MDisp(RSP, 8));
+  if (IsProfilingEnabled())
+  {
+    // RSCRATCH is free on both paths after the comparison, and MOV leaves the flags alone
+    MOV(64, R(RSCRATCH), ImmPtr(&m_blr_prediction_stats));
+    FixupBranch mispredicted = J_CC(CC_NE);
+    ADD(64, MDisp(RSCRATCH, offsetof(BLRPredictionStats, hits)), Imm8(1));
+    SUB(32, PPCSTATE(downcount), R(RSCRATCH2));
+    RET();
+
+    SetJumpTarget(mispredicted);
+    ADD(64, MDisp(RSCRATCH, offsetof(BLRPredictionStats, misses)), Imm8(1));
+    JMP(asm_routines.dispatcher_mispredicted_blr, Jump::Near);
+    return;
+  }
   J_CC(CC_NE, asm_routines.dispatcher_mispredicted_blr);
   SUB(32, PPCSTATE(downcount), R(RSCRATCH2));
   RET();
@@ -743,6 +760,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     if (!SConfig::GetInstance().bJITNoBlockCache)
     {
       WARN_LOG_FMT(DYNA_REC, "flushing trampoline code cache, please report if this happens a lot");
+      m_code_eviction_stats.full_clears++;
     }
     ClearCache();
   }
@@ -776,6 +794,8 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_PROFILED_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_EXIT_LIVENESS);
       }
       Trace();
     }
@@ -825,13 +845,27 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    blocks.DiscardBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Make room by evicting the blocks of the least recently used region and retry. Only if that
+    // doesn't help, clear the entire JIT cache.
+    if (const std::size_t evicted = blocks.EvictColdestCodeRegion(); evicted != 0)
+    {
+      m_code_eviction_stats.evictions++;
+      m_code_eviction_stats.blocks_evicted += evicted;
+      m_code_eviction_stats.blocks_kept += blocks.GetBlockCount();
+      DEBUG_LOG_FMT(DYNA_REC, "Evicted {} blocks to make room for {:08x}", evicted, em_address);
+      Jit(em_address, true);
+      return;
+    }
+
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
+    m_code_eviction_stats.full_clears++;
     ClearCache();
     Jit(em_address, false);
     return;
@@ -879,6 +913,13 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   // TODO: Test if this or AlignCode16 make a difference from GetCodePtr
   b->normalEntry = AlignCode4();
 
+  // Let the block cache know that this code is still in use when it picks a region to evict
+  if (u8* const code_region_use_flag = blocks.GetCodeRegionUseFlag(b->normalEntry))
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(code_region_use_flag));
+    MOV(8, MatR(RSCRATCH), Imm8(1));
+  }
+
   // Used to get a trace of the last few blocks before a crash, sometimes VERY useful
   if (m_im_here_debug)
   {
@@ -1223,6 +1264,8 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_PROFILED_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_EXIT_LIVENESS);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -143,6 +143,11 @@ public:
                   std::optional<Gen::OpArg> Ra, std::optional<Gen::OpArg> Rb,
                   std::optional<Gen::OpArg> Rc);
 
+  // Expects the masked GQR in RSCRATCH2. Leaves the emitter in far code until
+  // EndSpecializedQuantizedLoadStore.
+  void BeginSpecializedQuantizedLoadStore(bool load, bool single, GQRSiteProfile* profile);
+  void EndSpecializedQuantizedLoadStore();
+
   void MultiplyImmediate(u32 imm, int a, int d, bool overflow);
 
   typedef u32 (*Operation)(u32 a, u32 b);
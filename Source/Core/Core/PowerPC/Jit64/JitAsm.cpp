@@ -222,10 +222,12 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
-  // If jitting triggered an ISI exception, MSR.DR may have changed
+  // If jitting triggered an ISI exception or the block was interpreted, MSR.DR may have changed
   MOV(64, R(RMEM), PPCSTATE(mem_ptr));
 
-  JMP(dispatcher_no_check, Jump::Near);
+  // If the block was interpreted, it used up some of the downcount
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  JMP(dispatcher, Jump::Near);
 
   SetJumpTarget(bail);
   do_timing = GetCodePtr();
@@ -79,17 +79,26 @@ void Jit64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction inst
   SwitchToFarCode();
   SetJumpTarget(branch_in);
 
-  ABI_PushRegistersAndAdjustStack(caller_save, 0);
-  // Some call sites have an optimization to use ABI_PARAM1 as a scratch register.
-  if (reg_a != ABI_PARAM1)
-    MOV(64, R(ABI_PARAM1), R(reg_a));
-  MOV(64, R(ABI_PARAM2), Imm64(Core::FakeBranchWatchCollectionKey{origin, destination}));
-  MOV(32, R(ABI_PARAM3), Imm32(inst.hex));
-  ABI_CallFunction(m_ppc_state.msr.IR ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
-                                                     &Core::BranchWatch::HitVirtualFalse_fk) :
-                                        (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
-                                                     &Core::BranchWatch::HitPhysicalFalse_fk));
-  ABI_PopRegistersAndAdjustStack(caller_save, 0);
+  if (std::atomic<u64>* const counter =
+          m_branch_watch.GetCounter(origin, destination, inst, m_ppc_state.msr.IR, condition))
+  {
+    MOV(64, R(reg_a), ImmPtr(counter));
+    ADD(64, MatR(reg_a), Imm8(1));
+  }
+  else
+  {
+    ABI_PushRegistersAndAdjustStack(caller_save, 0);
+    // Some call sites have an optimization to use ABI_PARAM1 as a scratch register.
+    if (reg_a != ABI_PARAM1)
+      MOV(64, R(ABI_PARAM1), R(reg_a));
+    MOV(64, R(ABI_PARAM2), Imm64(Core::FakeBranchWatchCollectionKey{origin, destination}));
+    MOV(32, R(ABI_PARAM3), Imm32(inst.hex));
+    ABI_CallFunction(m_ppc_state.msr.IR ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
+                                                       &Core::BranchWatch::HitVirtualFalse_fk) :
+                                          (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
+                                                       &Core::BranchWatch::HitPhysicalFalse_fk));
+    ABI_PopRegistersAndAdjustStack(caller_save, 0);
+  }
 
   FixupBranch branch_out = J(Jump::Near);
   SwitchToNearCode();
@@ -211,6 +220,25 @@ void Jit64::bcx(UGeckoInstruction inst)
   if (inst.LK)
     MOV(32, PPCSTATE_LR, Imm32(js.compilerPC + 4));
 
+  if (js.op->branchIsFollowed)
+  {
+    // The block continues at the branch target, so it's the untaken path that leaves the block.
+    FixupBranch taken = J(Jump::Near);
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+    {
+      RCForkGuard gpr_guard = gpr.Fork();
+      RCForkGuard fpr_guard = fpr.Fork();
+      gpr.Flush();
+      fpr.Flush();
+      WriteExit(js.compilerPC + 4);
+    }
+    SetJumpTarget(taken);
+    return;
+  }
+
   // If this is not the last instruction of a block
   // and an unconditional branch, we will skip the rest process.
   // Because PPCAnalyst::Flatten() merged the blocks.
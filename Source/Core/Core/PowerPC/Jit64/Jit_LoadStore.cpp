@@ -316,20 +316,31 @@ void Jit64::dcbx(UGeckoInstruction inst)
       SwitchToFarCode();
       SetJumpTarget(branch_in);
 
-      // Assert RSCRATCH2 won't be clobbered before it is moved from.
-      static_assert(RSCRATCH2 != ABI_PARAM1);
-
-      ABI_PushRegistersAndAdjustStack(bw_caller_save, 0);
-      MOV(64, R(ABI_PARAM1), R(bw_reg_a));
-      // RSCRATCH2 holds the amount of faked branch watch hits. Move RSCRATCH2 first, because
-      // ABI_PARAM2 clobbers RSCRATCH2 on Windows and ABI_PARAM3 clobbers RSCRATCH2 on Linux!
-      MOV(32, R(ABI_PARAM4), R(RSCRATCH2));
       const PPCAnalyst::CodeOp& op = js.op[2];
-      MOV(64, R(ABI_PARAM2), Imm64(Core::FakeBranchWatchCollectionKey{op.address, op.branchTo}));
-      MOV(32, R(ABI_PARAM3), Imm32(op.inst.hex));
-      ABI_CallFunction(m_ppc_state.msr.IR ? &Core::BranchWatch::HitVirtualTrue_fk_n :
-                                            &Core::BranchWatch::HitPhysicalTrue_fk_n);
-      ABI_PopRegistersAndAdjustStack(bw_caller_save, 0);
+      if (std::atomic<u64>* const counter = m_branch_watch.GetCounter(
+              op.address, op.branchTo, op.inst, m_ppc_state.msr.IR, true))
+      {
+        // RSCRATCH2 holds the amount of faked branch watch hits.
+        MOV(64, R(bw_reg_a), ImmPtr(counter));
+        MOV(32, R(bw_reg_b), R(RSCRATCH2));
+        ADD(64, MatR(bw_reg_a), R(bw_reg_b));
+      }
+      else
+      {
+        // Assert RSCRATCH2 won't be clobbered before it is moved from.
+        static_assert(RSCRATCH2 != ABI_PARAM1);
+
+        ABI_PushRegistersAndAdjustStack(bw_caller_save, 0);
+        MOV(64, R(ABI_PARAM1), R(bw_reg_a));
+        // RSCRATCH2 holds the amount of faked branch watch hits. Move RSCRATCH2 first, because
+        // ABI_PARAM2 clobbers RSCRATCH2 on Windows and ABI_PARAM3 clobbers RSCRATCH2 on Linux!
+        MOV(32, R(ABI_PARAM4), R(RSCRATCH2));
+        MOV(64, R(ABI_PARAM2), Imm64(Core::FakeBranchWatchCollectionKey{op.address, op.branchTo}));
+        MOV(32, R(ABI_PARAM3), Imm32(op.inst.hex));
+        ABI_CallFunction(m_ppc_state.msr.IR ? &Core::BranchWatch::HitVirtualTrue_fk_n :
+                                              &Core::BranchWatch::HitPhysicalTrue_fk_n);
+        ABI_PopRegistersAndAdjustStack(bw_caller_save, 0);
+      }
 
       FixupBranch branch_out = J(Jump::Near);
       SwitchToNearCode();
@@ -56,41 +56,28 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   if (gqrIsConstant)
   {
     const u32 gqrValue = js.constantGqr[i] & 0xffff;
-    int type = gqrValue & 0x7;
-
-    // Paired stores (other than w/type zero) don't yield any real change in
-    // performance right now, but if we can improve fastmem support this might change
-    if (gqrValue == 0)
-    {
-      if (w)
-        GenQuantizedStore(true, static_cast<EQuantizeType>(type), (gqrValue & 0x3F00) >> 8);
-      else
-        GenQuantizedStore(false, static_cast<EQuantizeType>(type), (gqrValue & 0x3F00) >> 8);
-    }
-    else
-    {
-      // Stash PC in case asm routine needs to call into C++
-      MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
-      // We know what GQR is here, so we can load RSCRATCH2 and call into the store method directly
-      // with just the scale bits.
-      MOV(32, R(RSCRATCH2), Imm32(gqrValue & 0x3F00));
-
-      if (w)
-        CALL(asm_routines.single_store_quantized[type]);
-      else
-        CALL(asm_routines.paired_store_quantized[type]);
-    }
+    GenQuantizedStore(w == 1, static_cast<EQuantizeType>(gqrValue & 0x7),
+                      (gqrValue & 0x3F00) >> 8);
   }
   else
   {
-    // Stash PC in case asm routine needs to call into C++
-    MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
     // Some games (e.g. Dirt 2) incorrectly set the unused bits which breaks the lookup table code.
     // Hence, we need to mask out the unused bits. The layout of the GQR register is
     // UU[SCALE]UUUUU[TYPE] where SCALE is 6 bits and TYPE is 3 bits, so we have to AND with
     // 0b0011111100000111, or 0x3F07.
     MOV(32, R(RSCRATCH2), Imm32(0x3F07));
     AND(32, R(RSCRATCH2), PPCSTATE_SPR(SPR_GQR0 + i));
+
+    // The GQR value at compile time says nothing about the value here if the block changes it
+    GQRSiteProfile* const profile =
+        jo.memcheck || js.op->gqrModifiedBefore ?
+            nullptr :
+            GetGQRSiteProfile(js.compilerPC, GQR(m_ppc_state, i) & 0x3F07);
+    if (profile)
+      BeginSpecializedQuantizedLoadStore(false, w == 1, profile);
+
+    // Stash PC in case asm routine needs to call into C++
+    MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
     LEA(64, RSCRATCH,
         M(w ? asm_routines.single_store_quantized : asm_routines.paired_store_quantized));
     // 8-bit operations do not zero upper 32-bits of 64-bit registers.
@@ -98,6 +85,9 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
     OR(8, R(RSCRATCH), R(RSCRATCH2));
     SHL(8, R(RSCRATCH), Imm8(3));
     CALLptr(MatR(RSCRATCH));
+
+    if (profile)
+      EndSpecializedQuantizedLoadStore();
   }
 
   if (update && jo.memcheck)
@@ -106,6 +96,36 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   }
 }
 
+// When a quantized load or store doesn't use a GQR that is constant for the whole block, but the
+// GQR isn't written earlier in the block either, the conversion for the GQR value it has been seen
+// with is inlined anyway, behind a check of the masked GQR in RSCRATCH2. On a mismatch, the code
+// between this and EndSpecializedQuantizedLoadStore runs in far code instead.
+void Jit64::BeginSpecializedQuantizedLoadStore(bool load, bool single, GQRSiteProfile* profile)
+{
+  const EQuantizeType type = static_cast<EQuantizeType>(profile->value & 0x7);
+  const int scale = (profile->value & 0x3F00) >> 8;
+
+  CMP_or_TEST(32, R(RSCRATCH2), Imm32(profile->value));
+  const FixupBranch mismatch = J_CC(CC_NZ, Jump::Near);
+  if (load)
+    GenQuantizedLoad(single, type, scale);
+  else
+    GenQuantizedStore(single, type, scale);
+
+  SwitchToFarCode();
+  SetJumpTarget(mismatch);
+  // Makes the next compilation of this block specialize for the new value
+  MOV(64, R(RSCRATCH), ImmPtr(&profile->mismatches));
+  ADD(32, MatR(RSCRATCH), Imm8(1));
+}
+
+void Jit64::EndSpecializedQuantizedLoadStore()
+{
+  const FixupBranch done = J(Jump::Near);
+  SwitchToNearCode();
+  SetJumpTarget(done);
+}
+
 void Jit64::psq_lXX(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -144,13 +164,22 @@ void Jit64::psq_lXX(UGeckoInstruction inst)
   }
   else
   {
-    // Stash PC in case asm routine needs to call into C++
-    MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
     // Get the high part of the GQR register
     OpArg gqr = PPCSTATE_SPR(SPR_GQR0 + i);
     gqr.AddMemOffset(2);
     MOV(32, R(RSCRATCH2), Imm32(0x3F07));
     AND(32, R(RSCRATCH2), gqr);
+
+    // The GQR value at compile time says nothing about the value here if the block changes it
+    GQRSiteProfile* const profile =
+        jo.memcheck || js.op->gqrModifiedBefore ?
+            nullptr :
+            GetGQRSiteProfile(js.compilerPC, (GQR(m_ppc_state, i) >> 16) & 0x3F07);
+    if (profile)
+      BeginSpecializedQuantizedLoadStore(true, w == 1, profile);
+
+    // Stash PC in case asm routine needs to call into C++
+    MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
     LEA(64, RSCRATCH,
         M(w ? asm_routines.single_load_quantized : asm_routines.paired_load_quantized));
     // 8-bit operations do not zero upper 32-bits of 64-bit registers.
@@ -158,6 +187,9 @@ void Jit64::psq_lXX(UGeckoInstruction inst)
     OR(8, R(RSCRATCH), R(RSCRATCH2));
     SHL(8, R(RSCRATCH), Imm8(3));
     CALLptr(MatR(RSCRATCH));
+
+    if (profile)
+      EndSpecializedQuantizedLoadStore();
   }
 
   CVTPS2PD(Rs, R(XMM0));
@@ -410,7 +410,10 @@ void RegCache::Flush(BitSet32 pregs)
     case PPCCachedReg::LocationType::Default:
       break;
     case PPCCachedReg::LocationType::Discarded:
-      ASSERT_MSG(DYNA_REC, false, "Attempted to flush discarded PPC reg {}", i);
+      // Registers that are dead after a block exit get discarded before it, so flushing everything
+      // at the exit skips them, like on JitArm64
+      ASSERT_MSG(DYNA_REC, pregs == BitSet32::AllTrue(32),
+                 "Attempted to flush discarded PPC reg {}", i);
       break;
     case PPCCachedReg::LocationType::SpeculativeImmediate:
       // We can have a cached value without a host register through speculative constants.
@@ -420,9 +420,25 @@ void QuantizedMemoryRoutines::GenQuantizedStore(bool single, EQuantizeType type,
     return;
   }
 
+  GenQuantize(single, type, quantize);
+
+  int flags = isInline ? 0 :
+                         SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_PROLOG |
+                             SAFE_LOADSTORE_DR_ON | SAFE_LOADSTORE_NO_UPDATE_PC;
+  if (!single)
+    flags |= SAFE_LOADSTORE_NO_SWAP;
+
+  SafeWriteRegToReg(RSCRATCH, RSCRATCH_EXTRA, size, 0, QUANTIZED_REGS_TO_SAVE, flags);
+}
+
+void QuantizedMemoryRoutines::GenQuantize(bool single, EQuantizeType type, int quantize)
+{
+  // In: one or two single floats in XMM0, if quantize is -1, a quantization factor in RSCRATCH2
+  // Out: the value to write in RSCRATCH, already byteswapped if it's a pair
+
   if (type == QUANTIZE_FLOAT)
   {
-    GenQuantizedStoreFloat(single, isInline);
+    GenQuantizedStoreFloat(single, quantize != -1);
   }
   else if (single)
   {
@@ -533,14 +549,6 @@ void QuantizedMemoryRoutines::GenQuantizedStore(bool single, EQuantizeType type,
       break;
     }
   }
-
-  int flags = isInline ? 0 :
-                         SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_PROLOG |
-                             SAFE_LOADSTORE_DR_ON | SAFE_LOADSTORE_NO_UPDATE_PC;
-  if (!single)
-    flags |= SAFE_LOADSTORE_NO_SWAP;
-
-  SafeWriteRegToReg(RSCRATCH, RSCRATCH_EXTRA, size, 0, QUANTIZED_REGS_TO_SAVE, flags);
 }
 
 void QuantizedMemoryRoutines::GenQuantizedStoreFloat(bool single, bool isInline)
@@ -596,6 +604,30 @@ void QuantizedMemoryRoutines::GenQuantizedLoad(bool single, EQuantizeType type,
                          SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_PROLOG |
                              SAFE_LOADSTORE_DR_ON | SAFE_LOADSTORE_NO_UPDATE_PC;
   SafeLoadToReg(RSCRATCH_EXTRA, R(RSCRATCH_EXTRA), size, 0, regsToSave, extend, flags);
+  GenDequantize(single, type, quantize);
+}
+
+void QuantizedMemoryRoutines::GenDequantize(bool single, EQuantizeType type, int quantize)
+{
+  // In: the value read from memory in RSCRATCH_EXTRA, sign extended for single S8 and S16, and if
+  // quantize is -1, a quantization factor in RSCRATCH2
+  // Out: one or two single floats in XMM0
+
+  if (type == QUANTIZE_FLOAT)
+  {
+    if (single)
+    {
+      MOVD_xmm(XMM0, R(RSCRATCH_EXTRA));
+      UNPCKLPS(XMM0, MConst(m_one));
+    }
+    else
+    {
+      ROL(64, R(RSCRATCH_EXTRA), Imm8(32));
+      MOVQ_xmm(XMM0, R(RSCRATCH_EXTRA));
+    }
+    return;
+  }
+
   if (!single && (type == QUANTIZE_U8 || type == QUANTIZE_S8))
   {
     // TODO: Support not swapping in safeLoadToReg to avoid bswapping twice
@@ -704,15 +736,5 @@ void QuantizedMemoryRoutines::GenQuantizedLoadFloat(bool single, bool isInline)
                          SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_PROLOG |
                              SAFE_LOADSTORE_DR_ON | SAFE_LOADSTORE_NO_UPDATE_PC;
   SafeLoadToReg(RSCRATCH_EXTRA, R(RSCRATCH_EXTRA), size, 0, regsToSave, extend, flags);
-
-  if (single)
-  {
-    MOVD_xmm(XMM0, R(RSCRATCH_EXTRA));
-    UNPCKLPS(XMM0, MConst(m_one));
-  }
-  else
-  {
-    ROL(64, R(RSCRATCH_EXTRA), Imm8(32));
-    MOVQ_xmm(XMM0, R(RSCRATCH_EXTRA));
-  }
+  GenDequantize(single, QUANTIZE_FLOAT, 0);
 }
@@ -18,6 +18,11 @@ public:
   void GenQuantizedLoad(bool single, EQuantizeType type, int quantize);
   void GenQuantizedStore(bool single, EQuantizeType type, int quantize);
 
+  // The conversions done by the above, without the memory access. A quantize of -1 takes the
+  // scale from RSCRATCH2 instead.
+  void GenQuantize(bool single, EQuantizeType type, int quantize);
+  void GenDequantize(bool single, EQuantizeType type, int quantize);
+
 private:
   void GenQuantizedLoadFloat(bool single, bool isInline);
   void GenQuantizedStoreFloat(bool single, bool isInline);
@@ -74,6 +74,8 @@ void JitArm64::Init()
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
   code_block.m_fpa = &js.fpa;
+  analyzer.SetBranchProfile(&blocks.GetBranchProfile());
+  analyzer.SetLivenessCache(&blocks.GetLivenessCache());
 
   InitBLROptimization();
 
@@ -92,12 +94,16 @@ void JitArm64::SetOptimizationEnabled(bool enabled)
     analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE);
     analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
     analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_PROFILED_BRANCH_FOLLOW);
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_EXIT_LIVENESS);
   }
   else
   {
     analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE);
     analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
     analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_PROFILED_BRANCH_FOLLOW);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_EXIT_LIVENESS);
   }
 }
 
@@ -700,6 +706,14 @@ void JitArm64::FakeLKExit(u32 exit_address_after_return, ARM64Reg exit_address_a
   SetJumpTarget(skip_exit);
 }
 
+void JitArm64::EmitIncrementCounter(u64* counter)
+{
+  MOVP2R(ARM64Reg::X0, counter);
+  LDR(IndexType::Unsigned, ARM64Reg::X1, ARM64Reg::X0, 0);
+  ADD(ARM64Reg::X1, ARM64Reg::X1, 1);
+  STR(IndexType::Unsigned, ARM64Reg::X1, ARM64Reg::X0, 0);
+}
+
 void JitArm64::WriteBLRExit(Arm64Gen::ARM64Reg dest)
 {
   if (!m_enable_blr_optimization)
@@ -732,12 +746,18 @@ void JitArm64::WriteBLRExit(Arm64Gen::ARM64Reg dest)
   }
   FixupBranch no_match = B(CC_NEQ);
 
+  if (IsProfilingEnabled())
+    EmitIncrementCounter(&m_blr_prediction_stats.hits);
+
   DoDownCount();  // overwrites X0 + X1
 
   RET(ARM64Reg::X2);
 
   SetJumpTarget(no_match);
 
+  if (IsProfilingEnabled())
+    EmitIncrementCounter(&m_blr_prediction_stats.misses);
+
   ResetStack();
 
   DoDownCount();
@@ -1101,25 +1121,37 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunction(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
-  if (code_block.m_gqr_used.Count() == 1 && !js.pairedQuantizeAddresses.contains(js.blockStart))
+  // If every GQR used by the block is zero (plain floats) and isn't set in the block, check that
+  // once at the start of the block, so that the loads and stores can skip the lookup table.
+  const BitSet8 gqr_used = code_block.m_gqr_used;
+  bool gqrs_are_zero = gqr_used && !(gqr_used & code_block.m_gqr_modified) &&
+                       !js.pairedQuantizeAddresses.contains(js.blockStart);
+  for (int gqr : gqr_used)
+    gqrs_are_zero &= GQR(m_ppc_state, gqr) == 0;
+
+  if (gqrs_are_zero)
   {
-    int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(m_ppc_state, gqr))
+    bool first = true;
+    for (int gqr : gqr_used)
     {
-      LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
-      FixupBranch no_fail = CBZ(ARM64Reg::W0);
-      FixupBranch fail = B();
-      SwitchToFarCode();
-      SetJumpTarget(fail);
-      MOVI2R(DISPATCHER_PC, js.blockStart);
-      STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-      ABI_CallFunction(&JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
-                       static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
-      B(dispatcher_no_check);
-      SwitchToNearCode();
-      SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+      const ARM64Reg reg = first ? ARM64Reg::W0 : ARM64Reg::W1;
+      LDR(IndexType::Unsigned, reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
+      if (!first)
+        ORR(ARM64Reg::W0, ARM64Reg::W0, ARM64Reg::W1);
+      first = false;
     }
+    FixupBranch no_fail = CBZ(ARM64Reg::W0);
+    FixupBranch fail = B();
+    SwitchToFarCode();
+    SetJumpTarget(fail);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    ABI_CallFunction(&JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
+                     static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(no_fail);
+    js.assumeNoPairedQuantize = true;
   }
 
   gpr.Start(js.gpa);
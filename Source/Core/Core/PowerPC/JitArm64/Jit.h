@@ -291,6 +291,8 @@ protected:
   std::optional<size_t> SetEmitterStateToFreeCodeRegion();
 
   void DoDownCount();
+  // Overwrites X0 + X1
+  void EmitIncrementCounter(u64* counter);
   void Cleanup();
   void ResetStack();
 
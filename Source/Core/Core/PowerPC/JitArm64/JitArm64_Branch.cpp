@@ -88,16 +88,29 @@ void JitArm64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction i
   SwitchToFarCode();
   SetJumpTarget(branch_in);
 
-  const ARM64Reg float_emit_tmp = EncodeRegTo64(reg_b);
-  ABI_PushRegisters(gpr_caller_save);
-  m_float_emit.ABI_PushRegisters(fpr_caller_save, float_emit_tmp);
-  ABI_CallFunction(m_ppc_state.msr.IR ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
-                                                     &Core::BranchWatch::HitVirtualFalse_fk) :
-                                        (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
-                                                     &Core::BranchWatch::HitPhysicalFalse_fk),
-                   branch_watch, Core::FakeBranchWatchCollectionKey{origin, destination}, inst.hex);
-  m_float_emit.ABI_PopRegisters(fpr_caller_save, float_emit_tmp);
-  ABI_PopRegisters(gpr_caller_save);
+  if (std::atomic<u64>* const counter =
+          m_branch_watch.GetCounter(origin, destination, inst, m_ppc_state.msr.IR, condition))
+  {
+    const ARM64Reg hits = EncodeRegTo64(reg_b);
+    MOVP2R(branch_watch, counter);
+    LDR(IndexType::Unsigned, hits, branch_watch, 0);
+    ADD(hits, hits, 1);
+    STR(IndexType::Unsigned, hits, branch_watch, 0);
+  }
+  else
+  {
+    const ARM64Reg float_emit_tmp = EncodeRegTo64(reg_b);
+    ABI_PushRegisters(gpr_caller_save);
+    m_float_emit.ABI_PushRegisters(fpr_caller_save, float_emit_tmp);
+    ABI_CallFunction(m_ppc_state.msr.IR ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
+                                                       &Core::BranchWatch::HitVirtualFalse_fk) :
+                                          (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
+                                                       &Core::BranchWatch::HitPhysicalFalse_fk),
+                     branch_watch, Core::FakeBranchWatchCollectionKey{origin, destination},
+                     inst.hex);
+    m_float_emit.ABI_PopRegisters(fpr_caller_save, float_emit_tmp);
+    ABI_PopRegisters(gpr_caller_save);
+  }
 
   FixupBranch branch_out = B();
   SwitchToNearCode();
@@ -255,6 +268,29 @@ void JitArm64::bcx(UGeckoInstruction inst)
     STR(IndexType::Unsigned, WA, PPC_REG, PPCSTATE_OFF_SPR(SPR_LR));
   }
 
+  if (js.op->branchIsFollowed)
+  {
+    // The block continues at the branch target, so it's the untaken path that leaves the block.
+    FixupBranch taken = B();
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+
+    gpr.Flush(FlushMode::MaintainState, WA);
+    fpr.Flush(FlushMode::MaintainState, ARM64Reg::INVALID_REG);
+    WriteExit(js.compilerPC + 4);
+
+    SetJumpTarget(taken);
+
+    gpr.Unlock(WA);
+    if (WB != WA)
+      gpr.Unlock(WB);
+    if (WC != ARM64Reg::INVALID_REG)
+      gpr.Unlock(WC);
+    return;
+  }
+
   gpr.Flush(FlushMode::MaintainState, WB);
   fpr.Flush(FlushMode::MaintainState, ARM64Reg::INVALID_REG);
 
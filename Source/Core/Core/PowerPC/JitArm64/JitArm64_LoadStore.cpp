@@ -835,20 +835,33 @@ void JitArm64::dcbx(UGeckoInstruction inst)
       SwitchToFarCode();
       SetJumpTarget(branch_in);
 
-      const BitSet32 gpr_caller_save =
-          gpr.GetCallerSavedUsed() &
-          ~BitSet32{DecodeReg(WB), DecodeReg(reg_cycle_count), DecodeReg(reg_downcount)};
-      ABI_PushRegisters(gpr_caller_save);
-      const ARM64Reg float_emit_tmp = EncodeRegTo64(WB);
-      const BitSet32 fpr_caller_save = fpr.GetCallerSavedUsed();
-      m_float_emit.ABI_PushRegisters(fpr_caller_save, float_emit_tmp);
       const PPCAnalyst::CodeOp& op = js.op[2];
-      ABI_CallFunction(m_ppc_state.msr.IR ? &Core::BranchWatch::HitVirtualTrue_fk_n :
-                                            &Core::BranchWatch::HitPhysicalTrue_fk_n,
-                       branch_watch, Core::FakeBranchWatchCollectionKey{op.address, op.branchTo},
-                       op.inst.hex, WA);
-      m_float_emit.ABI_PopRegisters(fpr_caller_save, float_emit_tmp);
-      ABI_PopRegisters(gpr_caller_save);
+      if (std::atomic<u64>* const counter = m_branch_watch.GetCounter(
+              op.address, op.branchTo, op.inst, m_ppc_state.msr.IR, true))
+      {
+        // WA holds the amount of faked branch watch hits.
+        const ARM64Reg hits = EncodeRegTo64(WB);
+        MOVP2R(branch_watch, counter);
+        LDR(IndexType::Unsigned, hits, branch_watch, 0);
+        ADD(hits, hits, EncodeRegTo64(WA));
+        STR(IndexType::Unsigned, hits, branch_watch, 0);
+      }
+      else
+      {
+        const BitSet32 gpr_caller_save =
+            gpr.GetCallerSavedUsed() &
+            ~BitSet32{DecodeReg(WB), DecodeReg(reg_cycle_count), DecodeReg(reg_downcount)};
+        ABI_PushRegisters(gpr_caller_save);
+        const ARM64Reg float_emit_tmp = EncodeRegTo64(WB);
+        const BitSet32 fpr_caller_save = fpr.GetCallerSavedUsed();
+        m_float_emit.ABI_PushRegisters(fpr_caller_save, float_emit_tmp);
+        ABI_CallFunction(m_ppc_state.msr.IR ? &Core::BranchWatch::HitVirtualTrue_fk_n :
+                                              &Core::BranchWatch::HitPhysicalTrue_fk_n,
+                         branch_watch, Core::FakeBranchWatchCollectionKey{op.address, op.branchTo},
+                         op.inst.hex, WA);
+        m_float_emit.ABI_PopRegisters(fpr_caller_save, float_emit_tmp);
+        ABI_PopRegisters(gpr_caller_save);
+      }
 
       FixupBranch branch_out = B();
       SwitchToNearCode();
@@ -182,10 +182,13 @@ void JitArm64::GenerateAsm()
 
   LDR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
 
-  // If jitting triggered an ISI exception, MSR.DR may have changed
+  // If jitting triggered an ISI exception or the block was interpreted, MSR.DR may have changed
   EmitUpdateMembase();
 
-  B(dispatcher_no_check);
+  // If the block was interpreted, it used up some of the downcount
+  LDR(IndexType::Unsigned, ARM64Reg::W8, PPC_REG, PPCSTATE_OFF(downcount));
+  CMP(ARM64Reg::W8, 0);
+  B(dispatcher);
 
   SetJumpTarget(bail);
   do_timing = GetCodePtr();
@@ -19,6 +19,7 @@
 #include "Core/CoreTiming.h"
 #include "Core/HW/CPU.h"
 #include "Core/MemTools.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -90,7 +91,7 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
-  jit.Jit(em_address);
+  jit.HandleBlockMiss(em_address);
 }
 
 JitBase::JitBase(Core::System& system)
@@ -103,6 +104,7 @@ JitBase::JitBase(Core::System& system)
       ClearCache();
   });
   // The JIT is responsible for calling RefreshConfig on Init and ClearCache
+  analyzer.SetIdleLoopReport(&m_idle_loop_report);
 }
 
 JitBase::~JitBase()
@@ -112,15 +114,17 @@ JitBase::~JitBase()
 
 bool JitBase::DoesConfigNeedRefresh()
 {
-  return std::any_of(JIT_SETTINGS.begin(), JIT_SETTINGS.end(), [this](const auto& pair) {
-    return this->*pair.first != Config::Get(*pair.second);
-  });
+  return m_compile_threshold != Config::Get(Config::MAIN_JIT_COMPILE_THRESHOLD) ||
+         std::any_of(JIT_SETTINGS.begin(), JIT_SETTINGS.end(), [this](const auto& pair) {
+           return this->*pair.first != Config::Get(*pair.second);
+         });
 }
 
 void JitBase::RefreshConfig()
 {
   for (const auto& [member, config_info] : JIT_SETTINGS)
     this->*member = Config::Get(*config_info);
+  m_compile_threshold = Config::Get(Config::MAIN_JIT_COMPILE_THRESHOLD);
 
   if (m_accurate_cpu_cache_enabled)
   {
@@ -133,6 +137,9 @@ void JitBase::RefreshConfig()
   analyzer.SetBranchFollowingEnabled(m_enable_branch_following);
   analyzer.SetFloatExceptionsEnabled(m_enable_float_exceptions);
   analyzer.SetDivByZeroExceptionsEnabled(m_enable_div_by_zero_exceptions);
+  // Changing which loops count as idle changes when events happen relative to the CPU, which
+  // NetPlay and movies can't allow, so those only get the basic detection.
+  analyzer.SetGeneralizedIdleLoopsEnabled(!Core::WantsDeterminism());
 
   bool any_watchpoints = m_system.GetPowerPC().GetMemChecks().HasAny();
   jo.fastmem = m_fastmem_enabled && jo.fastmem_arena && (m_ppc_state.msr.DR || !any_watchpoints) &&
@@ -260,6 +267,56 @@ void JitBase::CleanUpAfterStackFault()
   }
 }
 
+void JitBase::HandleBlockMiss(u32 em_address)
+{
+  // Most code that misses the block cache only ever runs a few times, like the code that sets up
+  // a freshly loaded overlay. Interpreting it is cheaper than compiling it, and it avoids stalling
+  // the CPU thread on compiling many blocks at once, so only blocks that keep missing get compiled.
+  if (CanDeferCompilation() && !GetBlockCache()->RegisterBlockMiss(em_address, m_compile_threshold))
+  {
+    InterpretBlock();
+    ++m_compile_stats.blocks_interpreted;
+    return;
+  }
+
+  const auto start = CompileStats::Clock::now();
+  Jit(em_address);
+  m_compile_stats.compile_time += CompileStats::Clock::now() - start;
+  ++m_compile_stats.blocks_compiled;
+}
+
+bool JitBase::CanDeferCompilation() const
+{
+  // The interpreter doesn't know about breakpoints and stepping in the JIT, and without a block
+  // cache no block would ever be seen often enough to be compiled. Which blocks get interpreted
+  // depends on the threshold, which NetPlay and movies don't sync, and the interpreter doesn't
+  // time everything exactly like the JIT does, so determinism requires compiling right away.
+  return m_compile_threshold > 0 && !IsDebuggingEnabled() &&
+         !SConfig::GetInstance().bJITNoBlockCache && !Core::WantsDeterminism();
+}
+
+void JitBase::InterpretBlock()
+{
+  // All guest state is in m_ppc_state when the dispatcher misses, so the interpreter can take over
+  // until the next branch. The dispatcher checks the downcount before looking up the new PC.
+  Interpreter& interpreter = m_system.GetInterpreter();
+  m_ppc_state.downcount -= interpreter.SingleStepBlock();
+
+  // Remember which way the branch that ended the block went, so that the analyzer can keep the
+  // usual path in one block once this code gets compiled.
+  const u32 branch_address = interpreter.GetLastPC();
+  const auto result = m_mmu.TryReadInstruction(branch_address);
+  const UGeckoInstruction inst{result.hex};
+  if (!result.valid || inst.OPCD != 16 || inst.LK)
+    return;
+
+  const u32 target = (inst.AA ? 0 : branch_address) + SignExt16(inst.BD << 2);
+  if (m_ppc_state.pc == target)
+    GetBlockCache()->RecordBranch(branch_address, true);
+  else if (m_ppc_state.pc == branch_address + 4)
+    GetBlockCache()->RecordBranch(branch_address, false);
+}
+
 bool JitBase::CanMergeNextInstructions(int count) const
 {
   if (m_system.GetCPU().IsStepping() || js.instructionsLeft < count)
@@ -276,6 +333,26 @@ bool JitBase::CanMergeNextInstructions(int count) const
   return true;
 }
 
+JitBase::GQRSiteProfile* JitBase::GetGQRSiteProfile(u32 address, u32 gqr_value)
+{
+  // How many times an instruction gets specialized for a new GQR value before it's left generic
+  constexpr u32 MAX_GQR_RESPECIALIZATIONS = 2;
+
+  const auto [it, inserted] = js.gqrSiteProfiles.try_emplace(address, GQRSiteProfile{gqr_value});
+  GQRSiteProfile& profile = it->second;
+  if (inserted || profile.mismatches == 0)
+    return &profile;
+
+  if (profile.respecializations >= MAX_GQR_RESPECIALIZATIONS)
+    return nullptr;
+
+  // The block is being recompiled right before running it, so the current value is the best guess.
+  profile.value = gqr_value;
+  profile.mismatches = 0;
+  profile.respecializations++;
+  return &profile;
+}
+
 bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op)
 {
   if (jo.fp_exceptions)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <map>
 #include <unordered_set>
@@ -56,6 +57,46 @@ class PPCSymbolDB;
 
 class JitBase : public CPUCoreBase
 {
+public:
+  struct CompileStats
+  {
+    using Clock = std::chrono::steady_clock;
+
+    // Time the CPU thread has spent waiting for blocks to be compiled
+    Clock::duration compile_time{};
+    u64 blocks_compiled = 0;
+    // Block cache misses that were handled by the interpreter instead of compiling the block
+    u64 blocks_interpreted = 0;
+  };
+
+  // Outcomes of the return address prediction of the BLR optimization. These are only counted
+  // while block profiling is enabled.
+  struct BLRPredictionStats
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+  };
+
+  // How code space was reclaimed when the JIT ran out of it
+  struct CodeEvictionStats
+  {
+    // Evictions of the least recently used code region
+    u64 evictions = 0;
+    u64 blocks_evicted = 0;
+    // Sum of the blocks that survived each eviction, which a full clear would have thrown away
+    u64 blocks_kept = 0;
+    u64 full_clears = 0;
+  };
+
+  // The GQR value that a psq_l or psq_st instruction was last specialized for. The emitted code
+  // counts how often the GQR turned out to hold something else.
+  struct GQRSiteProfile
+  {
+    u32 value;
+    u32 mismatches = 0;
+    u32 respecializations = 0;
+  };
+
 protected:
   enum class CarryFlag
   {
@@ -127,6 +168,8 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Emitted code holds pointers to these, so they're only removed when the cache is cleared.
+    std::map<u32, GQRSiteProfile> gqrSiteProfiles;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -158,6 +201,14 @@ protected:
   bool m_fastmem_enabled = false;
   bool m_accurate_cpu_cache_enabled = false;
 
+  // How many times a block has to miss the block cache before it gets compiled
+  int m_compile_threshold = 0;
+  CompileStats m_compile_stats;
+  BLRPredictionStats m_blr_prediction_stats;
+  CodeEvictionStats m_code_eviction_stats;
+  // Every idle loop the analyzer has found since the JIT was started, for the log on shutdown
+  PPCAnalyst::IdleLoopReport m_idle_loop_report;
+
   bool m_enable_blr_optimization = false;
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
@@ -174,8 +225,15 @@ protected:
   void UnprotectStack();
   void CleanUpAfterStackFault();
 
+  bool CanDeferCompilation() const;
+  void InterpretBlock();
+
   bool CanMergeNextInstructions(int count) const;
 
+  // Returns the profile of the quantized load or store at address, with the value it should be
+  // specialized for, or nullptr if its GQR changes too often to specialize it at all.
+  GQRSiteProfile* GetGQRSiteProfile(u32 address, u32 gqr_value);
+
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
 public:
@@ -194,6 +252,14 @@ public:
 
   virtual void Jit(u32 em_address) = 0;
 
+  // Called by the dispatcher when there is no block for em_address. Either compiles the block or,
+  // if it hasn't run often enough yet to be worth compiling, interprets it.
+  void HandleBlockMiss(u32 em_address);
+  const CompileStats& GetCompileStats() const { return m_compile_stats; }
+  const BLRPredictionStats& GetBLRPredictionStats() const { return m_blr_prediction_stats; }
+  const CodeEvictionStats& GetCodeEvictionStats() const { return m_code_eviction_stats; }
+  const PPCAnalyst::IdleLoopReport& GetIdleLoopReport() const { return m_idle_loop_report; }
+
   virtual const CommonAsmRoutinesBase* GetAsmRoutines() = 0;
 
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
@@ -80,6 +80,7 @@ void JitBaseBlockCache::Clear()
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
+  m_jit.js.gqrSiteProfiles.clear();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -87,6 +88,16 @@ void JitBaseBlockCache::Clear()
   block_map.clear();
   links_to.clear();
   block_range_map.clear();
+  {
+    std::lock_guard lk(m_host_code_map_mutex);
+    m_host_code_map.clear();
+  }
+  m_block_miss_counts.clear();
+  m_branch_profile.clear();
+  m_liveness_cache.clear();
+  m_code_regions.fill({});
+  m_code_region_use_flags.fill(0);
+  m_code_region_clock = 0;
 
   valid_block.ClearAll();
 
@@ -163,6 +174,15 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     LinkBlock(block);
   }
 
+  AddHostCodeRanges(block);
+
+  SampleCodeRegionUse();
+  if (const std::optional<std::size_t> region = GetCodeRegion(block.near_begin))
+  {
+    m_code_regions[*region].block_count++;
+    m_code_regions[*region].last_use = ++m_code_region_clock;
+  }
+
   Common::Symbol* symbol = nullptr;
   if (Common::JitRegister::IsEnabled() &&
       (symbol = m_jit.m_ppc_symbol_db.GetSymbolFromAddr(block.effectiveAddress)) != nullptr)
@@ -177,6 +197,103 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   }
 }
 
+void JitBaseBlockCache::DiscardBlock(JitBlock& block)
+{
+  auto iter = block_map.equal_range(block.physicalAddress);
+  for (; iter.first != iter.second; iter.first++)
+  {
+    if (&iter.first->second == &block)
+    {
+      block_map.erase(iter.first);
+      return;
+    }
+  }
+}
+
+void JitBaseBlockCache::InitCodeRegions(const u8* begin, const u8* end)
+{
+  m_code_regions_begin = begin;
+  m_code_region_size = (end - begin + NUM_CODE_REGIONS - 1) / NUM_CODE_REGIONS;
+  m_code_regions.fill({});
+  m_code_region_use_flags.fill(0);
+}
+
+u8* JitBaseBlockCache::GetCodeRegionUseFlag(const u8* near_code)
+{
+  const std::optional<std::size_t> region = GetCodeRegion(near_code);
+  return region ? &m_code_region_use_flags[*region] : nullptr;
+}
+
+std::size_t JitBaseBlockCache::EvictColdestCodeRegion()
+{
+  SampleCodeRegionUse();
+
+  std::optional<std::size_t> coldest;
+  for (std::size_t i = 0; i < NUM_CODE_REGIONS; ++i)
+  {
+    if (m_code_regions[i].block_count != 0 &&
+        (!coldest || m_code_regions[i].last_use < m_code_regions[*coldest].last_use))
+    {
+      coldest = i;
+    }
+  }
+  if (!coldest)
+    return 0;
+
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  std::size_t evicted = 0;
+  for (auto iter = block_map.begin(); iter != block_map.end();)
+  {
+    JitBlock& block = iter->second;
+    if (GetCodeRegion(block.near_begin) != coldest)
+    {
+      ++iter;
+      continue;
+    }
+
+    for (u32 addr : block.physical_addresses)
+    {
+      const auto range = block_range_map.find(addr & range_mask);
+      if (range == block_range_map.end())
+        continue;
+      range->second.erase(&block);
+      if (range->second.empty())
+        block_range_map.erase(range);
+    }
+
+    DestroyBlock(block);
+    iter = block_map.erase(iter);
+    ++evicted;
+  }
+
+  return evicted;
+}
+
+std::optional<std::size_t> JitBaseBlockCache::GetCodeRegion(const u8* near_code) const
+{
+  if (m_code_region_size == 0 || near_code < m_code_regions_begin)
+    return std::nullopt;
+
+  const std::size_t region = (near_code - m_code_regions_begin) / m_code_region_size;
+  if (region >= NUM_CODE_REGIONS)
+    return std::nullopt;
+  return region;
+}
+
+// Regions that ran since the last sample count as used now. Since this happens on every compile,
+// which is also the only time code space runs out, this orders the regions by their last use
+// closely enough without having to count anything in the generated code.
+void JitBaseBlockCache::SampleCodeRegionUse()
+{
+  for (std::size_t i = 0; i < NUM_CODE_REGIONS; ++i)
+  {
+    if (m_code_region_use_flags[i] == 0)
+      continue;
+    m_code_region_use_flags[i] = 0;
+    m_code_regions[i].last_use = ++m_code_region_clock;
+  }
+}
+
 JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, CPUEmuFeatureFlags feature_flags)
 {
   u32 translated_addr = addr;
@@ -238,6 +355,25 @@ const u8* JitBaseBlockCache::Dispatch()
   return block->normalEntry;
 }
 
+bool JitBaseBlockCache::RegisterBlockMiss(u32 em_address, u32 threshold)
+{
+  const auto iter = m_block_miss_counts.try_emplace(em_address, 0).first;
+  if (++iter->second <= threshold)
+    return false;
+
+  m_block_miss_counts.erase(iter);
+  return true;
+}
+
+void JitBaseBlockCache::RecordBranch(u32 address, bool taken)
+{
+  PPCAnalyst::BranchCounts& counts = m_branch_profile[address];
+  if (taken)
+    ++counts.taken;
+  else
+    ++counts.not_taken;
+}
+
 void JitBaseBlockCache::InvalidateICacheLine(u32 address)
 {
   const u32 cache_line_address = address & ~0x1f;
@@ -278,6 +414,11 @@ void JitBaseBlockCache::InvalidateICache(u32 initial_address, u32 initial_length
 void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 address, u32 length,
                                                  bool forced)
 {
+  // This has to happen even if no block overlaps the range, since later blocks would use the
+  // stale liveness otherwise. Blocks that already used it contain the code it was derived from in
+  // their physical addresses, so they get destroyed below.
+  PPCAnalyst::InvalidateLiveness(&m_liveness_cache, physical_address, length);
+
   // Optimization for the case of invalidating a single cache line, which is used by the dcb*
   // instructions. If the valid_block bit for that cacheline is not set, we can safely skip
   // the remaining invalidation logic.
@@ -317,6 +458,12 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
         m_jit.js.pairedQuantizeAddresses.erase(i);
         m_jit.js.noSpeculativeConstantsAddresses.erase(i);
       }
+
+      // Start counting from scratch for whatever code gets written here instead
+      m_block_miss_counts.erase(m_block_miss_counts.lower_bound(address),
+                                m_block_miss_counts.upper_bound(address + (length - 1)));
+      m_branch_profile.erase(m_branch_profile.lower_bound(address),
+                             m_branch_profile.upper_bound(address + (length - 1)));
     }
   }
 }
@@ -462,6 +609,9 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 
   UnlinkBlock(block);
 
+  if (const std::optional<std::size_t> region = GetCodeRegion(block.near_begin))
+    m_code_regions[*region].block_count--;
+
   // Delete linking addresses
   for (const auto& e : block.linkData)
   {
@@ -473,10 +623,54 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
       links_to.erase(it);
   }
 
+  RemoveHostCodeRanges(block);
+
   // Raise an signal if we are going to call this block again
   WriteDestroyBlock(block);
 }
 
+void JitBaseBlockCache::AddHostCodeRanges(const JitBlock& block)
+{
+  std::lock_guard lk(m_host_code_map_mutex);
+  if (block.near_begin != block.near_end)
+  {
+    m_host_code_map.insert_or_assign(block.near_begin,
+                                     HostCodeRange{block.near_end, block.effectiveAddress});
+  }
+  if (block.far_begin != block.far_end)
+  {
+    m_host_code_map.insert_or_assign(block.far_begin,
+                                     HostCodeRange{block.far_end, block.effectiveAddress});
+  }
+}
+
+void JitBaseBlockCache::RemoveHostCodeRanges(const JitBlock& block)
+{
+  std::lock_guard lk(m_host_code_map_mutex);
+  const auto remove = [this, &block](const u8* begin, const u8* end) {
+    const auto it = m_host_code_map.find(begin);
+    if (it != m_host_code_map.end() && it->second.end == end &&
+        it->second.effective_address == block.effectiveAddress)
+    {
+      m_host_code_map.erase(it);
+    }
+  };
+  remove(block.near_begin, block.near_end);
+  remove(block.far_begin, block.far_end);
+}
+
+std::optional<u32> JitBaseBlockCache::GetBlockAddressFromHostCode(const u8* host_address) const
+{
+  std::lock_guard lk(m_host_code_map_mutex);
+  auto it = m_host_code_map.upper_bound(host_address);
+  if (it == m_host_code_map.begin())
+    return std::nullopt;
+  --it;
+  if (host_address >= it->second.end)
+    return std::nullopt;
+  return it->second.effective_address;
+}
+
 JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, CPUEmuFeatureFlags feature_flags)
 {
   JitBlock* block = GetBlockFromStartAddress(addr, feature_flags);
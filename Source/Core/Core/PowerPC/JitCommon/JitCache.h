@@ -10,6 +10,8 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <type_traits>
 #include <unordered_map>
@@ -19,6 +21,7 @@
 #include "Common/CommonTypes.h"
 #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/PPCAnalyst.h"
 
 class JitBase;
 
@@ -148,6 +151,8 @@ public:
   static constexpr u64 FAST_BLOCK_MAP_SIZE = 0x10'0000'0000;
   static constexpr u32 FAST_BLOCK_MAP_FALLBACK_ELEMENTS = 0x10000;
   static constexpr u32 FAST_BLOCK_MAP_FALLBACK_MASK = FAST_BLOCK_MAP_FALLBACK_ELEMENTS - 1;
+  // The number of regions the near code space is split into for eviction
+  static constexpr std::size_t NUM_CODE_REGIONS = 16;
 
   explicit JitBaseBlockCache(JitBase& jit);
   virtual ~JitBaseBlockCache();
@@ -164,18 +169,50 @@ public:
 
   JitBlock* AllocateBlock(u32 em_address);
   void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
+  // Removes a block returned by AllocateBlock that couldn't be compiled
+  void DiscardBlock(JitBlock& block);
+  std::size_t GetBlockCount() const { return block_map.size(); }
+
+  // Splits the near code space [begin, end) into NUM_CODE_REGIONS regions. Blocks are assigned to
+  // the region their near code starts in, and a region counts as used whenever one of its blocks
+  // is compiled or its use flag is found set.
+  void InitCodeRegions(const u8* begin, const u8* end);
+  // Returns the flag that code at near_code sets whenever it runs, or nullptr if it isn't in a
+  // region. The flags are sampled and cleared whenever a block is compiled or a region is evicted.
+  u8* GetCodeRegionUseFlag(const u8* near_code);
+  // Destroys all blocks of the least recently used region that has any blocks, so that its code
+  // space can be reused. Returns the number of blocks destroyed.
+  std::size_t EvictColdestCodeRegion();
+  // Number of blocks whose near code starts in the given region
+  u32 GetCodeRegionBlockCount(std::size_t region) const
+  {
+    return m_code_regions[region].block_count;
+  }
 
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
   // This might return nullptr if there is no such block.
   JitBlock* GetBlockFromStartAddress(u32 em_address, CPUEmuFeatureFlags feature_flags);
 
+  // Returns the effective address of the block whose near or far code contains host_address.
+  // Unlike the other lookups, this is safe to call from any thread.
+  std::optional<u32> GetBlockAddressFromHostCode(const u8* host_address) const;
+
   // Get the normal entry for the block associated with the current program
   // counter. This will JIT code if necessary. (This is the reference
   // implementation; high-performance JITs will want to use a custom
   // assembly version.)
   const u8* Dispatch();
 
+  // Counts a block cache miss at em_address. Returns true once the address has missed more than
+  // threshold times, which means the block should be compiled instead of interpreted.
+  bool RegisterBlockMiss(u32 em_address, u32 threshold);
+  // Records which way a conditional branch went while its code was being interpreted
+  void RecordBranch(u32 address, bool taken);
+  const PPCAnalyst::BranchProfile& GetBranchProfile() const { return m_branch_profile; }
+  // Register liveness of the functions that block exits lead into, filled in by the analyzer
+  PPCAnalyst::LivenessCache& GetLivenessCache() { return m_liveness_cache; }
+
   void InvalidateICache(u32 address, u32 length, bool forced);
   void InvalidateICacheLine(u32 address);
   void ErasePhysicalRange(u32 address, u32 length);
@@ -196,8 +233,14 @@ private:
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
 
+  void AddHostCodeRanges(const JitBlock& block);
+  void RemoveHostCodeRanges(const JitBlock& block);
+
   JitBlock* MoveBlockIntoFastCache(u32 em_address, CPUEmuFeatureFlags feature_flags);
 
+  std::optional<std::size_t> GetCodeRegion(const u8* near_code) const;
+  void SampleCodeRegionUse();
+
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
@@ -215,6 +258,34 @@ private:
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
   std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
 
+  // Near and far code ranges of all finalized blocks, indexed by their first host address.
+  // This is used to map host PCs back to guest code, e.g. by the sampling profiler, which runs on
+  // its own thread and is the reason this map has a lock.
+  struct HostCodeRange
+  {
+    const u8* end;
+    u32 effective_address;
+  };
+  std::map<const u8*, HostCodeRange> m_host_code_map;
+  mutable std::mutex m_host_code_map_mutex;
+
+  // Block cache misses of code that hasn't been compiled yet, indexed by effective address
+  std::map<u32, u32> m_block_miss_counts;
+  PPCAnalyst::BranchProfile m_branch_profile;
+  PPCAnalyst::LivenessCache m_liveness_cache;
+
+  struct CodeRegion
+  {
+    u64 last_use = 0;
+    u32 block_count = 0;
+  };
+  const u8* m_code_regions_begin = nullptr;
+  std::size_t m_code_region_size = 0;
+  std::array<CodeRegion, NUM_CODE_REGIONS> m_code_regions{};
+  // Set by the generated code at the start of every block
+  std::array<u8, NUM_CODE_REGIONS> m_code_region_use_flags{};
+  u64 m_code_region_clock = 0;
+
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
@@ -4,6 +4,7 @@
 #include "Core/PowerPC/JitInterface.h"
 
 #include <algorithm>
+#include <chrono>
 #include <string>
 #include <unordered_set>
 
@@ -12,8 +13,10 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
@@ -21,6 +24,7 @@
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/System.h"
 
 #ifdef _M_X86_64
@@ -50,6 +54,9 @@ void JitInterface::DoState(PointerWrap& p)
 
 CPUCoreBase* JitInterface::InitJitCore(PowerPC::CPUCore core)
 {
+  // The profiler looks up blocks in the current JIT from its own thread
+  StopSamplingProfiler();
+
   switch (core)
   {
 #ifdef _M_X86_64
@@ -224,6 +231,45 @@ JitInterface::GetHostCode(u32 address) const
   return result;
 }
 
+std::optional<u32> JitInterface::GetBlockAddressFromHostCode(const u8* host_code) const
+{
+  if (!m_jit)
+    return std::nullopt;
+
+  return m_jit->GetBlockCache()->GetBlockAddressFromHostCode(host_code);
+}
+
+bool JitInterface::StartSamplingProfiler(std::chrono::microseconds interval)
+{
+  if (!m_jit)
+    return false;
+
+  if (!m_sampling_profiler)
+    m_sampling_profiler = std::make_unique<PowerPC::SamplingProfiler>(m_system);
+
+  // The profiler needs to know which thread to interrupt
+  bool started = false;
+  Core::RunOnCPUThread(
+      m_system, [&] { started = m_sampling_profiler->Start(interval); }, true);
+  return started;
+}
+
+void JitInterface::StopSamplingProfiler()
+{
+  if (m_sampling_profiler)
+    m_sampling_profiler->Stop();
+}
+
+bool JitInterface::IsSamplingProfilerRunning() const
+{
+  return m_sampling_profiler && m_sampling_profiler->IsRunning();
+}
+
+bool JitInterface::WriteSamplingProfile(const std::string& path) const
+{
+  return m_sampling_profiler && m_sampling_profiler->WriteFoldedStacks(path);
+}
+
 bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
 {
   // Prevent nullptr dereference on a crash with no JIT present
@@ -344,8 +390,53 @@ void JitInterface::CompileExceptionCheckFromJIT(JitInterface& jit_interface, Exc
 
 void JitInterface::Shutdown()
 {
+  StopSamplingProfiler();
+
   if (m_jit)
   {
+    const JitBase::CompileStats& stats = m_jit->GetCompileStats();
+    INFO_LOG_FMT(DYNA_REC, "Spent {} ms compiling {} blocks, interpreted {} block cache misses",
+                 std::chrono::duration_cast<std::chrono::milliseconds>(stats.compile_time).count(),
+                 stats.blocks_compiled, stats.blocks_interpreted);
+    const JitBase::CodeEvictionStats& eviction_stats = m_jit->GetCodeEvictionStats();
+    if (eviction_stats.evictions != 0 || eviction_stats.full_clears != 0)
+    {
+      // Estimate what recompiling the blocks that survived the evictions would have cost
+      JitBase::CompileStats::Clock::duration avoided_compile_time{};
+      if (stats.blocks_compiled != 0)
+      {
+        avoided_compile_time =
+            stats.compile_time / stats.blocks_compiled * eviction_stats.blocks_kept;
+      }
+      INFO_LOG_FMT(DYNA_REC,
+                   "Evicted {} code regions ({} blocks) and cleared the code cache {} times, "
+                   "avoiding recompiling {} blocks (~{} ms)",
+                   eviction_stats.evictions, eviction_stats.blocks_evicted,
+                   eviction_stats.full_clears, eviction_stats.blocks_kept,
+                   std::chrono::duration_cast<std::chrono::milliseconds>(avoided_compile_time)
+                       .count());
+    }
+    const PPCAnalyst::IdleLoopReport& idle_loops = m_jit->GetIdleLoopReport();
+    if (!idle_loops.empty())
+    {
+      const auto generalized = std::ranges::count_if(
+          idle_loops, [](const auto& pair) { return pair.second.generalized; });
+      INFO_LOG_FMT(DYNA_REC, "Detected {} idle loops in {}, {} of them by generalized detection",
+                   idle_loops.size(), SConfig::GetInstance().GetGameID(), generalized);
+      for (const auto& [branch_address, loop] : idle_loops)
+      {
+        DEBUG_LOG_FMT(DYNA_REC, "Idle loop {:08x}-{:08x} ({} instructions){}", loop.start_address,
+                      branch_address, loop.num_instructions,
+                      loop.generalized ? ", generalized" : "");
+      }
+    }
+    if (m_jit->IsProfilingEnabled())
+    {
+      const JitBase::BLRPredictionStats& blr_stats = m_jit->GetBLRPredictionStats();
+      INFO_LOG_FMT(DYNA_REC, "Return address prediction: {} hits, {} misses", blr_stats.hits,
+                   blr_stats.misses);
+    }
+
     m_jit->Shutdown();
     m_jit.reset();
   }
@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <variant>
 
@@ -25,7 +27,8 @@ class System;
 namespace PowerPC
 {
 enum class CPUCore;
-}
+class SamplingProfiler;
+}  // namespace PowerPC
 
 class JitInterface
 {
@@ -59,6 +62,16 @@ public:
   void JitBlockLogDump(const Core::CPUThreadGuard& guard, std::FILE* file) const;
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
 
+  // Returns the start address of the JIT block containing the given host code, if any.
+  // This may be called from any thread.
+  std::optional<u32> GetBlockAddressFromHostCode(const u8* host_code) const;
+
+  // Sampling profiler
+  bool StartSamplingProfiler(std::chrono::microseconds interval);
+  void StopSamplingProfiler();
+  bool IsSamplingProfilerRunning() const;
+  bool WriteSamplingProfile(const std::string& path) const;
+
   // Memory Utilities
   bool HandleFault(uintptr_t access_address, SContext* ctx);
   bool HandleStackFault();
@@ -94,5 +107,6 @@ public:
 
 private:
   std::unique_ptr<JitBase> m_jit;
+  std::unique_ptr<PowerPC::SamplingProfiler> m_sampling_profiler;
   Core::System& m_system;
 };
@@ -918,11 +918,58 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
   return ReadResult<std::string>(c->translated, std::move(s));
 }
 
-bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) const
+std::optional<ReadResult<u32>> MMU::HostTryReadBlock(const Core::CPUThreadGuard& guard,
+                                                     const u32 address, std::span<u8> dest,
+                                                     RequestedAddressSpace space)
 {
-  if (m_power_pc.GetMemChecks().HasAny())
-    return false;
+  ASSERT(!dest.empty());
+  ASSERT((address & ~HW_PAGE_MASK) == ((address + dest.size() - 1) & ~HW_PAGE_MASK));
+
+  if (!HostIsRAMAddress(guard, address, space))
+    return std::nullopt;
+
+  auto& mmu = guard.GetSystem().GetMMU();
+  const bool translate = space == RequestedAddressSpace::Virtual ||
+                         (space == RequestedAddressSpace::Effective && mmu.m_ppc_state.msr.DR);
+  u32 physical_address = address;
+  if (translate)
+  {
+    const auto translated_address = mmu.TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!translated_address.Success())
+      return std::nullopt;
+    physical_address = translated_address.address;
+  }
+
+  // Without dcache emulation, RAM can be copied directly. Everything else goes through the
+  // regular read path, which knows about all the other kinds of memory.
+  auto& memory = mmu.m_memory;
+  if (!mmu.m_ppc_state.m_enable_dcache)
+  {
+    if (memory.GetRAM() && (physical_address & 0xF8000000) == 0x00000000)
+    {
+      std::memcpy(dest.data(), &memory.GetRAM()[physical_address & memory.GetRamMask()],
+                  dest.size());
+      return ReadResult<u32>(translate, physical_address);
+    }
+
+    if (memory.GetEXRAM() && (physical_address >> 28) == 0x1 &&
+        (physical_address & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+    {
+      std::memcpy(dest.data(), &memory.GetEXRAM()[physical_address & 0x0FFFFFFF], dest.size());
+      return ReadResult<u32>(translate, physical_address);
+    }
+  }
 
+  for (size_t i = 0; i < dest.size(); ++i)
+  {
+    dest[i] = mmu.ReadFromHardware<XCheckTLBFlag::NoException, u8, true>(
+        physical_address + static_cast<u32>(i));
+  }
+  return ReadResult<u32>(translate, physical_address);
+}
+
+bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) const
+{
   if (!m_ppc_state.msr.DR)
     return false;
 
@@ -930,7 +977,7 @@ bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) cons
     return false;
 
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. Pages overlapping memchecks are never marked as optimizable.
   const u32 last_byte_address = address + (access_size >> 3) - 1;
   const u32 bat_result_1 = m_dbat_table[address >> BAT_INDEX_SHIFT];
   const u32 bat_result_2 = m_dbat_table[last_byte_address >> BAT_INDEX_SHIFT];
@@ -1212,7 +1259,7 @@ void MMU::TouchDCacheLine(u32 address, bool store)
 
 u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address, access_size >> 3))
     return 0;
 
   if (!m_ppc_state.msr.DR)
@@ -1238,7 +1285,7 @@ u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 
 bool MMU::IsOptimizableGatherPipeWrite(u32 address) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(address, sizeof(u64)))
     return false;
 
   if (!m_ppc_state.msr.DR)
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <map>
+#include <optional>
 #include <queue>
 #include <string>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HLE/HLE.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -44,6 +46,16 @@ namespace PPCAnalyst
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
+// 0 does not follow any conditional branches
+constexpr u32 PROFILED_BRANCH_FOLLOWING_THRESHOLD = 4;
+// How many times a conditional branch must have been taken, and how many times more often it must
+// have been taken than not, for the analyzer to continue the block at its target
+constexpr u32 PROFILED_BRANCH_MIN_TAKEN = 2;
+constexpr u32 PROFILED_BRANCH_TAKEN_RATIO = 4;
+
+// Functions larger than this are assumed to need every register at all of their instructions
+constexpr u32 MAX_LIVENESS_FUNCTION_INSTRUCTIONS = 0x1000;
+
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
@@ -790,6 +802,332 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
   return false;
 }
 
+bool PPCAnalyzer::IsGeneralizedBusyWaitLoop(CodeBlock* block, CodeOp* code,
+                                            size_t instructions) const
+{
+  // Polling loops for hardware registers and OS state are often a bit bigger than what
+  // IsBusyWaitLoop accepts. This also allows CR logic, mfcr, memory barriers and floating point
+  // loads. Branches other than the one back to the start of the loop must leave the block (or be
+  // followed calls), so every iteration that gets back to the start ran exactly these
+  // instructions.
+  //
+  // None of the instructions may write to memory, and no register, CR field or carry flag may
+  // carry a value from one iteration to the next. Then every iteration computes the same result
+  // from the same memory, so the loop can't end before something outside of the CPU changes
+  // memory, which only happens in scheduled events.
+  BitSet32 gprs_read;
+  BitSet32 gprs_written;
+  BitSet8 crs_read;
+  BitSet8 crs_written;
+  bool ca_read = false;
+  bool ca_written = false;
+
+  for (size_t i = 0; i <= instructions; ++i)
+  {
+    const CodeOp& op = code[i];
+    if (op.skip)
+      continue;
+
+    const UGeckoInstruction inst = op.inst;
+    switch (op.opinfo->type)
+    {
+    case OpType::Integer:
+    case OpType::Load:
+    case OpType::LoadFP:
+    case OpType::CR:
+    case OpType::Branch:
+      break;
+    case OpType::System:
+      // sync, eieio and mfcr
+      if (inst.OPCD == 31 && (inst.SUBOP10 == 598 || inst.SUBOP10 == 854 || inst.SUBOP10 == 19))
+        break;
+      return false;
+    case OpType::InstructionCache:
+      // isync
+      if (inst.OPCD == 19 && inst.SUBOP10 == 150)
+        break;
+      return false;
+    default:
+      return false;
+    }
+
+    if (op.opinfo->type == OpType::Branch && op.branchUsesCtr)
+      return false;
+
+    gprs_read |= op.regsIn & ~gprs_written;
+    crs_read |= op.crIn & ~crs_written;
+    ca_read |= (op.opinfo->flags & FL_READ_CA) && !ca_written;
+
+    if (op.regsOut & gprs_read || op.crOut & crs_read ||
+        ((op.opinfo->flags & FL_SET_CA) && ca_read))
+    {
+      return false;
+    }
+    gprs_written |= op.regsOut;
+    crs_written |= op.crOut;
+    ca_written |= (op.opinfo->flags & FL_SET_CA) != 0;
+  }
+
+  return code[instructions].branchTo == block->m_address;
+}
+
+bool PPCAnalyzer::IsBranchLikelyTaken(u32 address) const
+{
+  if (!m_branch_profile)
+    return false;
+
+  const auto iter = m_branch_profile->find(address);
+  if (iter == m_branch_profile->end())
+    return false;
+
+  const BranchCounts& counts = iter->second;
+  return counts.taken >= PROFILED_BRANCH_MIN_TAKEN &&
+         counts.taken >= u64{counts.not_taken} * PROFILED_BRANCH_TAKEN_RATIO;
+}
+
+void InvalidateLiveness(LivenessCache* cache, u32 physical_address, u32 length)
+{
+  // Functions in the cache don't overlap, so only the ones right before the end of the range can
+  // overlap it
+  auto iter = cache->lower_bound(physical_address + length);
+  while (iter != cache->begin())
+  {
+    --iter;
+    if (iter->first + iter->second.instructions.size() * 4 <= physical_address)
+      break;
+    iter = cache->erase(iter);
+  }
+}
+
+// Translates the address of an instruction if it's mapped by an IBAT. Unlike the translation done
+// for instruction fetches, this never touches the TLB.
+static std::optional<u32> TranslateInstructionAddress(Core::System& system, u32 address)
+{
+  if (!system.GetPPCState().msr.IR)
+    return address;
+
+  const u32 bat_result = system.GetMMU().GetIBATTable()[address >> PowerPC::BAT_INDEX_SHIFT];
+  if ((bat_result & PowerPC::BAT_MAPPED_BIT) == 0)
+    return std::nullopt;
+  return (bat_result & PowerPC::BAT_RESULT_MASK) | (address & (PowerPC::BAT_PAGE_SIZE - 1));
+}
+
+static bool IsConditionalBranch(UGeckoInstruction inst)
+{
+  return inst.OPCD == 16 &&
+         ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0 || (inst.BO & BO_DONT_CHECK_CONDITION) == 0);
+}
+
+FunctionLiveness PPCAnalyzer::ComputeFunctionLiveness(u32 address, u32 physical_address,
+                                                      u32 num_instructions) const
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+
+  FunctionLiveness function;
+  function.address = address;
+  function.instructions.resize(num_instructions);
+
+  // SetInstructionStats needs a block to record FPU usage in
+  BlockRegStats fpa;
+  CodeBlock block;
+  block.m_fpa = &fpa;
+
+  const auto get_index = [&](u32 target) -> s32 {
+    if (target < address || target - address >= num_instructions * 4)
+      return -1;
+    return static_cast<s32>((target - address) / 4);
+  };
+
+  CodeBuffer code(num_instructions);
+  for (u32 i = 0; i < num_instructions; ++i)
+  {
+    FunctionLiveness::Instruction& instruction = function.instructions[i];
+    instruction.physical_address = physical_address + i * 4;
+    instruction.barrier = true;
+
+    // The instructions are read from memory rather than through the instruction cache, so that
+    // looking ahead doesn't change what the emulated CPU fetches later.
+    if (memory.GetSpanForAddress(instruction.physical_address).size() < 4)
+      continue;
+
+    CodeOp& op = code[i];
+    op.address = address + i * 4;
+    op.inst = UGeckoInstruction(memory.Read_U32(instruction.physical_address));
+    op.opinfo = PPCTables::GetOpInfo(op.inst, op.address);
+
+    // Any FPU instruction could be the first one of a block, where FP unavailable is checked
+    fpa.any = false;
+    SetInstructionStats(&block, &op, op.opinfo);
+
+    if (op.canCauseException || HLE::GetHookByAddress(op.address) != 0)
+      continue;
+
+    if (!op.canEndBlock)
+    {
+      instruction.successors[0] = get_index(op.address + 4);
+      instruction.barrier = instruction.successors[0] < 0;
+    }
+    else if ((op.inst.OPCD == 18 || op.inst.OPCD == 16) && !op.inst.LK)
+    {
+      // Everything else that ends blocks (calls, returns, indirect branches...) stays a barrier,
+      // as does leaving the function
+      const bool conditional = IsConditionalBranch(op.inst);
+      instruction.successors[0] = get_index(op.branchTo);
+      if (conditional)
+        instruction.successors[1] = get_index(op.address + 4);
+      instruction.barrier =
+          instruction.successors[0] < 0 || (conditional && instruction.successors[1] < 0);
+    }
+  }
+
+  // Iterate backwards until nothing changes. Barriers need everything, and liveness only ever grows
+  // from there, so this terminates.
+  for (auto& instruction : function.instructions)
+  {
+    if (instruction.barrier)
+      instruction.live_in = RegisterLiveness::All();
+  }
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (u32 i = num_instructions; i-- > 0;)
+    {
+      FunctionLiveness::Instruction& instruction = function.instructions[i];
+      if (instruction.barrier)
+        continue;
+
+      RegisterLiveness live_out;
+      for (const s32 successor : instruction.successors)
+      {
+        if (successor >= 0)
+          live_out |= function.instructions[successor].live_in;
+      }
+
+      const CodeOp& op = code[i];
+      RegisterLiveness live_in;
+      live_in.gprs = op.regsIn | (live_out.gprs & ~op.regsOut);
+      live_in.fprs = op.fregsIn | (live_out.fprs & ~op.GetFregsOut());
+      live_in.crs = op.crIn | (live_out.crs & ~op.crOut);
+      live_in.ca = op.wantsCA || (live_out.ca && !op.outputCA);
+      live_in.fprf = op.wantsFPRF || (live_out.fprf && !op.outputFPRF);
+      if (live_in != instruction.live_in)
+      {
+        instruction.live_in = live_in;
+        changed = true;
+      }
+    }
+  }
+
+  return function;
+}
+
+const FunctionLiveness* PPCAnalyzer::GetFunctionLiveness(const Common::Symbol& symbol) const
+{
+  const u32 num_instructions = symbol.size / 4;
+  if (num_instructions == 0 || num_instructions > MAX_LIVENESS_FUNCTION_INSTRUCTIONS)
+    return nullptr;
+
+  // Only functions that are contiguous in physical memory are handled, so that invalidating a
+  // range of physical memory can find them
+  auto& system = Core::System::GetInstance();
+  const u32 last_address = symbol.address + (num_instructions - 1) * 4;
+  const std::optional<u32> physical_address = TranslateInstructionAddress(system, symbol.address);
+  const std::optional<u32> last_physical_address =
+      TranslateInstructionAddress(system, last_address);
+  if (!physical_address || !last_physical_address ||
+      *last_physical_address - *physical_address != last_address - symbol.address)
+  {
+    return nullptr;
+  }
+
+  // The same physical code may have been analyzed at a different effective address, or the
+  // symbol may have changed since
+  const auto iter = m_liveness_cache->find(*physical_address);
+  if (iter != m_liveness_cache->end() && iter->second.address == symbol.address &&
+      iter->second.instructions.size() == num_instructions)
+  {
+    return &iter->second;
+  }
+
+  InvalidateLiveness(m_liveness_cache, *physical_address, num_instructions * 4);
+  const auto result = m_liveness_cache->emplace(
+      *physical_address,
+      ComputeFunctionLiveness(symbol.address, *physical_address, num_instructions));
+  return &result.first->second;
+}
+
+RegisterLiveness PPCAnalyzer::GetLivenessAt(u32 address, CodeBlock* block) const
+{
+  if (!m_liveness_cache || m_is_debugging_enabled || !HasOption(OPTION_EXIT_LIVENESS))
+    return RegisterLiveness::All();
+
+  const Common::Symbol* const symbol =
+      Core::System::GetInstance().GetPowerPC().GetSymbolDB().GetSymbolFromAddr(address);
+  if (!symbol || ((address - symbol->address) & 3) != 0)
+    return RegisterLiveness::All();
+
+  const FunctionLiveness* const function = GetFunctionLiveness(*symbol);
+  const u32 index = (address - symbol->address) / 4;
+  if (!function || index >= function->instructions.size())
+    return RegisterLiveness::All();
+
+  const auto& instructions = function->instructions;
+  if (instructions[index].barrier)
+    return RegisterLiveness::All();
+
+  // The result depends on all the code that can run before the next barriers, so the block must
+  // be invalidated together with it
+  std::vector<bool> visited(instructions.size());
+  std::vector<s32> stack{static_cast<s32>(index)};
+  visited[index] = true;
+  while (!stack.empty())
+  {
+    const FunctionLiveness::Instruction& instruction = instructions[stack.back()];
+    stack.pop_back();
+    block->m_physical_addresses.insert(instruction.physical_address);
+    if (instruction.barrier)
+      continue;
+
+    for (const s32 successor : instruction.successors)
+    {
+      if (successor >= 0 && !visited[successor])
+      {
+        visited[successor] = true;
+        stack.push_back(successor);
+      }
+    }
+  }
+
+  return instructions[index].live_in;
+}
+
+RegisterLiveness PPCAnalyzer::GetExitLiveness(const CodeOp& op, bool last_op,
+                                              CodeBlock* block) const
+{
+  if (!m_liveness_cache || m_is_debugging_enabled || !HasOption(OPTION_EXIT_LIVENESS))
+    return RegisterLiveness::All();
+
+  // Only the targets of direct branches are known while compiling
+  if ((op.inst.OPCD != 18 && op.inst.OPCD != 16) || op.inst.LK)
+    return RegisterLiveness::All();
+
+  // The untaken path of a followed branch is the one that leaves the block
+  if (op.branchIsFollowed)
+    return GetLivenessAt(op.address + 4, block);
+
+  const bool conditional = IsConditionalBranch(op.inst);
+
+  // Unconditional branches in the middle of a block have been followed
+  if (!conditional && !last_op)
+    return {};
+
+  RegisterLiveness liveness = GetLivenessAt(op.branchTo, block);
+  if (conditional && last_op)
+    liveness |= GetLivenessAt(op.address + 4, block);
+  return liveness;
+}
+
 static bool CanCauseGatherPipeInterruptCheck(const CodeOp& op)
 {
   // eieio
@@ -826,9 +1164,12 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   bool found_call = false;
   size_t caller = 0;
   u32 numFollows = 0;
+  u32 numProfiledFollows = 0;
   u32 num_inst = 0;
 
   const bool enable_follow = m_enable_branch_following;
+  const bool enable_profiled_follow = enable_follow && !m_is_debugging_enabled &&
+                                      HasOption(OPTION_PROFILED_BRANCH_FOLLOW) && block_size > 1;
 
   auto& system = Core::System::GetInstance();
   auto& mmu = system.GetMMU();
@@ -942,8 +1283,25 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       }
     }
 
-    code[i].branchIsIdleLoop =
-        code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
+    if (code[i].branchTo == block->m_address)
+    {
+      const bool basic_idle_loop = IsBusyWaitLoop(block, code, i);
+      const bool generalized_idle_loop = !basic_idle_loop && m_enable_generalized_idle_loops &&
+                                         IsGeneralizedBusyWaitLoop(block, code, i);
+      code[i].branchIsIdleLoop = basic_idle_loop || generalized_idle_loop;
+      if (code[i].branchIsIdleLoop && m_idle_loop_report)
+      {
+        m_idle_loop_report->insert_or_assign(
+            address, IdleLoop{block->m_address, static_cast<u32>(i + 1), generalized_idle_loop});
+      }
+    }
+
+    // Only forward branches are followed, so that loops don't get unrolled into the block.
+    const bool follow_taken = enable_profiled_follow && conditional_continue && inst.OPCD == 16 &&
+                              !inst.LK && code[i].branchTo > address &&
+                              !code[i].branchIsIdleLoop &&
+                              numProfiledFollows < PROFILED_BRANCH_FOLLOWING_THRESHOLD &&
+                              IsBranchLikelyTaken(address);
 
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
@@ -951,6 +1309,15 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       numFollows++;
       address = code[i].branchTo;
     }
+    else if (follow_taken)
+    {
+      // Follow the conditional branch the way it usually goes. The JIT emits the exit for the
+      // other way, and registers stay allocated across the branch on the hot path.
+      numProfiledFollows++;
+      code[i].branchIsFollowed = true;
+      found_call = false;
+      address = code[i].branchTo;
+    }
     else
     {
       // Just pick the next instruction
@@ -983,11 +1350,23 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   auto& power_pc = system.GetPowerPC();
   auto& ppc_symbol_db = power_pc.GetSymbolDB();
   // Scan for flag dependencies; assume the next block (or any branch that can leave the block)
-  // wants flags, to be safe.
-  bool wantsFPRF = true;
-  bool wantsCA = true;
-  BitSet8 crInUse, crDiscardable;
-  BitSet32 gprBlockInputs, gprInUse, fprInUse, gprDiscardable, fprDiscardable, fprInXmm;
+  // wants flags, to be safe, unless the liveness of the code there is known.
+  RegisterLiveness live_at_end = RegisterLiveness::All();
+  if (block->m_broken)
+  {
+    if (!block->m_memory_exception)
+      live_at_end = GetLivenessAt(address, block);
+  }
+  else if (block->m_num_instructions > 0 && code[block->m_num_instructions - 1].canEndBlock)
+  {
+    // Nothing after the instruction that ends the block runs
+    live_at_end = {};
+  }
+  bool wantsFPRF = live_at_end.fprf;
+  bool wantsCA = live_at_end.ca;
+  BitSet8 crInUse, crDiscardable = ~live_at_end.crs;
+  BitSet32 gprBlockInputs, gprInUse, fprInUse, fprInXmm;
+  BitSet32 gprDiscardable = ~live_at_end.gprs, fprDiscardable = ~live_at_end.fprs;
   for (int i = block->m_num_instructions - 1; i >= 0; i--)
   {
     CodeOp& op = code[i];
@@ -1004,19 +1383,25 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     const auto ppc_mode = power_pc.GetMode();
     const bool hle = !!HLE::TryReplaceFunction(ppc_symbol_db, op.address, ppc_mode);
     const bool breakpoint = power_pc.GetBreakPoints().IsAddressBreakPoint(op.address);
-    const bool may_exit_block = hle || breakpoint || op.canEndBlock || op.canCauseException;
+    RegisterLiveness exit_liveness;
+    if (hle || breakpoint || op.canCauseException)
+      exit_liveness = RegisterLiveness::All();
+    else if (op.canEndBlock)
+      exit_liveness = GetExitLiveness(op, i == int(block->m_num_instructions) - 1, block);
 
     const bool opWantsFPRF = op.wantsFPRF;
     const bool opWantsCA = op.wantsCA;
-    op.wantsFPRF = wantsFPRF || may_exit_block;
-    op.wantsCA = wantsCA || may_exit_block;
-    wantsFPRF |= opWantsFPRF || may_exit_block;
-    wantsCA |= opWantsCA || may_exit_block;
+    op.wantsFPRF = wantsFPRF || exit_liveness.fprf;
+    op.wantsCA = wantsCA || exit_liveness.ca;
+    wantsFPRF |= opWantsFPRF || exit_liveness.fprf;
+    wantsCA |= opWantsCA || exit_liveness.ca;
     wantsFPRF &= !op.outputFPRF || opWantsFPRF;
     wantsCA &= !op.outputCA || opWantsCA;
-    op.gprInUse = gprInUse;
-    op.fprInUse = fprInUse;
-    op.crInUse = crInUse;
+    // Registers that are dead at a later block exit get discarded instead of flushed, so they
+    // count as being in use
+    op.gprInUse = gprInUse | gprDiscardable;
+    op.fprInUse = fprInUse | fprDiscardable;
+    op.crInUse = crInUse | crDiscardable;
     op.gprDiscardable = gprDiscardable;
     op.fprDiscardable = fprDiscardable;
     op.crDiscardable = crDiscardable;
@@ -1042,9 +1427,9 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     }
     else if (op.canEndBlock || op.canCauseException)
     {
-      gprDiscardable = BitSet32{};
-      fprDiscardable = BitSet32{};
-      crDiscardable = BitSet8{};
+      gprDiscardable &= ~(exit_liveness.gprs | op.regsIn);
+      fprDiscardable &= ~(exit_liveness.fprs | op.fregsIn);
+      crDiscardable &= ~(exit_liveness.crs | op.crIn);
     }
     else
     {
@@ -1140,6 +1525,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     {
       const int gqr = op.inst.OPCD == 4 ? op.inst.Ix : op.inst.I;
       gqrUsed[gqr] = true;
+      op.gqrModifiedBefore = gqrModified[gqr];
     }
 
     if (IsMtspr(op.inst))
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -26,6 +28,77 @@ class CPUThreadGuard;
 
 namespace PPCAnalyst
 {
+// How often a conditional branch went either way while its code was being interpreted
+struct BranchCounts
+{
+  u32 taken = 0;
+  u32 not_taken = 0;
+};
+// Indexed by the address of the branch
+using BranchProfile = std::map<u32, BranchCounts>;
+
+// Registers and flags whose current value may still be read
+struct RegisterLiveness
+{
+  BitSet32 gprs;
+  BitSet32 fprs;
+  BitSet8 crs;
+  bool ca = false;
+  bool fprf = false;
+
+  static RegisterLiveness All()
+  {
+    return {BitSet32(0xFFFFFFFF), BitSet32(0xFFFFFFFF), BitSet8(0xFF), true, true};
+  }
+
+  RegisterLiveness& operator|=(const RegisterLiveness& other)
+  {
+    gprs |= other.gprs;
+    fprs |= other.fprs;
+    crs |= other.crs;
+    ca |= other.ca;
+    fprf |= other.fprf;
+    return *this;
+  }
+
+  bool operator==(const RegisterLiveness&) const = default;
+};
+
+// Register liveness at the start of every instruction of a PPCSymbolDB function. This tells the
+// JIT what the code after a block exit overwrites before reading it.
+struct FunctionLiveness
+{
+  struct Instruction
+  {
+    RegisterLiveness live_in;
+    u32 physical_address = 0;
+    // Indices of the instructions of the function that can run next, or -1
+    std::array<s32, 2> successors{-1, -1};
+    // Everything is live here no matter what the code after this instruction does, e.g. because
+    // it can cause an exception, or it leaves the function.
+    bool barrier = false;
+  };
+
+  u32 address = 0;
+  std::vector<Instruction> instructions;
+};
+// Indexed by the physical address of the start of the function
+using LivenessCache = std::map<u32, FunctionLiveness>;
+
+// Removes the liveness of all functions that overlap the given range of physical memory
+void InvalidateLiveness(LivenessCache* cache, u32 physical_address, u32 length);
+
+// An idle loop found by the analyzer
+struct IdleLoop
+{
+  u32 start_address = 0;
+  u32 num_instructions = 0;
+  // Whether only the generalized detector recognizes it
+  bool generalized = false;
+};
+// Indexed by the address of the branch back to the start of the loop
+using IdleLoopReport = std::map<u32, IdleLoop>;
+
 struct CodeOp  // 16B
 {
   UGeckoInstruction inst;
@@ -40,6 +113,8 @@ struct CodeOp  // 16B
   BitSet8 crOut;
   bool branchUsesCtr = false;
   bool branchIsIdleLoop = false;
+  // conditional branch whose taken path continues the block, so the untaken path leaves it
+  bool branchIsFollowed = false;
   BitSet8 wantsCR;
   bool wantsFPRF = false;
   bool wantsCA = false;
@@ -51,6 +126,8 @@ struct CodeOp  // 16B
   bool canCauseException = false;
   bool skipLRStack = false;
   bool skip = false;  // followed BL-s for example
+  // quantized load or store whose GQR is written by an earlier instruction in this block
+  bool gqrModifiedBefore = false;
   BitSet8 crInUse;
   BitSet8 crDiscardable;
   // which registers are still needed after this instruction in this block
@@ -171,6 +248,15 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Continue the block at the target of forward conditional branches that the branch profile
+    // says are almost always taken, and leave the block on the untaken path instead.
+    // Requires JIT support to be enabled.
+    OPTION_PROFILED_BRANCH_FOLLOW = (1 << 7),
+
+    // Use the liveness of the code after block exits with a known target, computed for whole
+    // functions, instead of assuming that every register and flag is needed there.
+    OPTION_EXIT_LIVENESS = (1 << 8),
   };
 
   // Option setting/getting
@@ -181,8 +267,21 @@ public:
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
+  // The generalized idle loop detector changes timing compared to the basic one, so it's only
+  // used when determinism isn't needed.
+  void SetGeneralizedIdleLoopsEnabled(bool enabled) { m_enable_generalized_idle_loops = enabled; }
+  void SetBranchProfile(const BranchProfile* profile) { m_branch_profile = profile; }
+  void SetLivenessCache(LivenessCache* cache) { m_liveness_cache = cache; }
+  void SetIdleLoopReport(IdleLoopReport* report) { m_idle_loop_report = report; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
 
+  // Returns what may be read after the block is left at op, and adds the physical addresses of the
+  // code this depends on to the block
+  RegisterLiveness GetExitLiveness(const CodeOp& op, bool last_op, CodeBlock* block) const;
+  // Computes the liveness for the function at address from the code in physical memory
+  FunctionLiveness ComputeFunctionLiveness(u32 address, u32 physical_address,
+                                           u32 num_instructions) const;
+
 private:
   enum class ReorderType
   {
@@ -197,6 +296,10 @@ private:
   void ReorderInstructions(u32 instructions, CodeOp* code) const;
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo) const;
   bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const;
+  bool IsGeneralizedBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const;
+  bool IsBranchLikelyTaken(u32 address) const;
+  RegisterLiveness GetLivenessAt(u32 address, CodeBlock* block) const;
+  const FunctionLiveness* GetFunctionLiveness(const Common::Symbol& symbol) const;
 
   // Options
   u32 m_options = 0;
@@ -205,6 +308,11 @@ private:
   bool m_enable_branch_following = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
+  bool m_enable_generalized_idle_loops = false;
+
+  const BranchProfile* m_branch_profile = nullptr;
+  LivenessCache* m_liveness_cache = nullptr;
+  IdleLoopReport* m_idle_loop_report = nullptr;
 };
 
 void FindFunctions(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr,
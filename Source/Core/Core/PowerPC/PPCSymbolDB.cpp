@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstring>
 #include <map>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -15,17 +16,71 @@
 #include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 #include "Common/StringUtil.h"
 #include "Core/Core.h"
 #include "Core/Debugger/DebugInterface.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 #include "Core/System.h"
 
+namespace
+{
+// Layout of a binary symbol cache file (.dsyb): a SymbolCacheHeader, the SymbolCacheEntry table
+// sorted by address, the calls of all symbols back to back, and finally the names.
+constexpr u32 SYMBOL_CACHE_MAGIC = 0x42595344;  // "DSYB"
+constexpr u32 SYMBOL_CACHE_VERSION = 1;
+
+struct SymbolCacheHeader
+{
+  u32 magic;
+  u32 version;
+  u32 symbol_count;
+  u32 call_count;
+  u32 names_size;
+  u32 map_checksum;
+  u32 memory_checksum;
+  u32 bad;
+};
+static_assert(sizeof(SymbolCacheHeader) == 32);
+
+struct SymbolCacheEntry
+{
+  u32 address;
+  u32 size;
+  u32 hash;
+  u32 flags;
+  u32 name_offset;
+  u32 name_length;
+  u32 first_call;
+  u32 call_count;
+  u8 type;
+  u8 analyzed;
+  u16 padding;
+};
+static_assert(sizeof(SymbolCacheEntry) == 36);
+static_assert(sizeof(Common::SCall) == 8);
+
+// Function analysis depends on the code in memory, so a cached map is only valid for the same
+// memory contents.
+u32 ComputeMemoryChecksum(const Core::CPUThreadGuard& guard)
+{
+  auto& memory = guard.GetSystem().GetMemory();
+  u32 checksum = Common::UpdateCRC32(Common::StartCRC32(), memory.GetRAM(),
+                                     memory.GetRamSizeReal());
+  if (memory.GetEXRAM())
+    checksum = Common::UpdateCRC32(checksum, memory.GetEXRAM(), memory.GetExRamSizeReal());
+  return checksum;
+}
+}  // namespace
+
 PPCSymbolDB::PPCSymbolDB() = default;
 
 PPCSymbolDB::~PPCSymbolDB() = default;
@@ -42,6 +97,7 @@ Common::Symbol* PPCSymbolDB::AddFunction(const Core::CPUThreadGuard& guard, u32
     return nullptr;
 
   const auto insert = m_functions.emplace(start_addr, std::move(symbol));
+  InvalidateAddressIndex();
   Common::Symbol* ptr = &insert.first->second;
   ptr->type = Common::Symbol::Type::Function;
   m_checksum_to_function[ptr->hash].insert(ptr);
@@ -65,6 +121,7 @@ void PPCSymbolDB::AddKnownSymbol(const Core::CPUThreadGuard& guard, u32 startAdd
   {
     // new symbol. run analyze.
     auto& new_symbol = m_functions.emplace(startAddr, name).first->second;
+    InvalidateAddressIndex();
     new_symbol.type = type;
     new_symbol.address = startAddr;
 
@@ -89,21 +146,14 @@ void PPCSymbolDB::AddKnownSymbol(const Core::CPUThreadGuard& guard, u32 startAdd
 
 Common::Symbol* PPCSymbolDB::GetSymbolFromAddr(u32 addr)
 {
-  auto it = m_functions.lower_bound(addr);
+  Common::Symbol* const symbol = GetSymbolStartingAtOrBefore(addr);
+  if (!symbol)
+    return nullptr;
 
-  if (it != m_functions.end())
-  {
-    // If the address is exactly the start address of a symbol, we're done.
-    if (it->second.address == addr)
-      return &it->second;
-  }
-  if (it != m_functions.begin())
-  {
-    // Otherwise, check whether the address is within the bounds of a symbol.
-    --it;
-    if (addr >= it->second.address && addr < it->second.address + it->second.size)
-      return &it->second;
-  }
+  // If the address is exactly the start address of a symbol, we're done. Otherwise, check
+  // whether the address is within the bounds of the symbol.
+  if (symbol->address == addr || addr < symbol->address + symbol->size)
+    return symbol;
 
   return nullptr;
 }
@@ -221,6 +271,38 @@ void PPCSymbolDB::LogFunctionCall(u32 addr)
 // produced by SaveSymbolMap below.
 // bad=true means carefully load map files that might not be from exactly the right version
 bool PPCSymbolDB::LoadMap(const Core::CPUThreadGuard& guard, const std::string& filename, bool bad)
+{
+  // The cache holds the complete database after loading, so it can only stand in for the map file
+  // when there are no other symbols to merge with.
+  if (!m_functions.empty())
+    return LoadMapText(guard, filename, bad);
+
+  std::string map_contents;
+  if (!File::ReadFileToString(filename, map_contents))
+    return false;
+
+  const u32 map_checksum = Common::ComputeCRC32(map_contents);
+  const u32 memory_checksum = ComputeMemoryChecksum(guard);
+  const std::string cache_path =
+      fmt::format("{}{:08x}.dsyb", File::GetUserPath(D_SYMBOLCACHE_IDX),
+                  Common::ComputeCRC32(filename));
+  if (LoadSymbolCache(cache_path, map_checksum, memory_checksum, bad))
+  {
+    Index();
+    NOTICE_LOG_FMT(SYMBOLS, "{} symbols loaded from the symbol cache.", m_functions.size());
+    return true;
+  }
+
+  if (!LoadMapText(guard, filename, bad))
+    return false;
+
+  if (!SaveSymbolCache(cache_path, map_checksum, memory_checksum, bad))
+    WARN_LOG_FMT(SYMBOLS, "Failed to write symbol cache '{}'", cache_path);
+  return true;
+}
+
+bool PPCSymbolDB::LoadMapText(const Core::CPUThreadGuard& guard, const std::string& filename,
+                              bool bad)
 {
   File::IOFile f(filename, "r");
   if (!f)
@@ -533,3 +615,108 @@ bool PPCSymbolDB::SaveCodeMap(const Core::CPUThreadGuard& guard, const std::stri
   }
   return true;
 }
+
+bool PPCSymbolDB::LoadSymbolCache(const std::string& path, u32 map_checksum, u32 memory_checksum,
+                                  bool bad)
+{
+  Common::MappedFile file;
+  if (!File::Exists(path) || !file.Open(path, Common::MappedFile::Mode::Read))
+    return false;
+
+  const u8* const data = file.GetData();
+  const u64 size = file.GetSize();
+  SymbolCacheHeader header;
+  if (size < sizeof(header))
+    return false;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != SYMBOL_CACHE_MAGIC || header.version != SYMBOL_CACHE_VERSION ||
+      header.map_checksum != map_checksum || header.memory_checksum != memory_checksum ||
+      header.bad != static_cast<u32>(bad))
+  {
+    return false;
+  }
+
+  const u64 entries_offset = sizeof(SymbolCacheHeader);
+  const u64 calls_offset = entries_offset + u64(header.symbol_count) * sizeof(SymbolCacheEntry);
+  const u64 names_offset = calls_offset + u64(header.call_count) * sizeof(Common::SCall);
+  if (names_offset + header.names_size > size)
+    return false;
+
+  const std::span<const SymbolCacheEntry> entries(
+      reinterpret_cast<const SymbolCacheEntry*>(data + entries_offset), header.symbol_count);
+  const std::span<const Common::SCall> calls(
+      reinterpret_cast<const Common::SCall*>(data + calls_offset), header.call_count);
+  const std::string_view names(reinterpret_cast<const char*>(data + names_offset),
+                               header.names_size);
+
+  for (const SymbolCacheEntry& entry : entries)
+  {
+    if (u64(entry.name_offset) + entry.name_length > names.size() ||
+        u64(entry.first_call) + entry.call_count > calls.size())
+    {
+      Clear();
+      return false;
+    }
+
+    // Entries are sorted by address, so every symbol goes to the end of the map.
+    Common::Symbol& symbol =
+        m_functions
+            .emplace_hint(m_functions.end(), entry.address,
+                          std::string(names.substr(entry.name_offset, entry.name_length)))
+            ->second;
+    symbol.address = entry.address;
+    symbol.size = entry.size;
+    symbol.hash = entry.hash;
+    symbol.flags = entry.flags;
+    symbol.type = static_cast<Common::Symbol::Type>(entry.type);
+    symbol.analyzed = entry.analyzed != 0;
+    const auto symbol_calls = calls.subspan(entry.first_call, entry.call_count);
+    symbol.calls.assign(symbol_calls.begin(), symbol_calls.end());
+    if (symbol.type == Common::Symbol::Type::Function)
+      m_checksum_to_function[symbol.hash].insert(&symbol);
+  }
+
+  InvalidateAddressIndex();
+  return true;
+}
+
+bool PPCSymbolDB::SaveSymbolCache(const std::string& path, u32 map_checksum, u32 memory_checksum,
+                                  bool bad) const
+{
+  std::vector<SymbolCacheEntry> entries;
+  std::vector<Common::SCall> calls;
+  std::string names;
+  entries.reserve(m_functions.size());
+  for (const auto& [address, symbol] : m_functions)
+  {
+    SymbolCacheEntry& entry = entries.emplace_back();
+    entry.address = address;
+    entry.size = symbol.size;
+    entry.hash = symbol.hash;
+    entry.flags = symbol.flags;
+    entry.name_offset = static_cast<u32>(names.size());
+    entry.name_length = static_cast<u32>(symbol.name.size());
+    entry.first_call = static_cast<u32>(calls.size());
+    entry.call_count = static_cast<u32>(symbol.calls.size());
+    entry.type = static_cast<u8>(symbol.type);
+    entry.analyzed = symbol.analyzed;
+    names += symbol.name;
+    calls.insert(calls.end(), symbol.calls.begin(), symbol.calls.end());
+  }
+
+  SymbolCacheHeader header{};
+  header.magic = SYMBOL_CACHE_MAGIC;
+  header.version = SYMBOL_CACHE_VERSION;
+  header.symbol_count = static_cast<u32>(entries.size());
+  header.call_count = static_cast<u32>(calls.size());
+  header.names_size = static_cast<u32>(names.size());
+  header.map_checksum = map_checksum;
+  header.memory_checksum = memory_checksum;
+  header.bad = bad;
+
+  if (!File::CreateFullPath(path))
+    return false;
+  File::IOFile f(path, "wb");
+  return f.WriteArray(&header, 1) && f.WriteArray(entries.data(), entries.size()) &&
+         f.WriteArray(calls.data(), calls.size()) && f.WriteBytes(names.data(), names.size());
+}
@@ -32,6 +32,8 @@ public:
 
   void FillInCallers();
 
+  // Loads a map file. The analysed result is kept in a binary symbol cache, so loading the same
+  // map file for the same memory contents again skips parsing and analysis.
   bool LoadMap(const Core::CPUThreadGuard& guard, const std::string& filename, bool bad = false);
   bool SaveSymbolMap(const std::string& filename) const;
   bool SaveCodeMap(const Core::CPUThreadGuard& guard, const std::string& filename) const;
@@ -39,4 +41,13 @@ public:
   void PrintCalls(u32 funcAddr) const;
   void PrintCallers(u32 funcAddr) const;
   void LogFunctionCall(u32 addr);
+
+private:
+  bool LoadMapText(const Core::CPUThreadGuard& guard, const std::string& filename, bool bad);
+
+  // The binary symbol cache is memory-mapped when loading. It is only valid for the same map
+  // file and the same emulated memory contents, which are identified by their checksums.
+  bool LoadSymbolCache(const std::string& path, u32 map_checksum, u32 memory_checksum, bool bad);
+  bool SaveSymbolCache(const std::string& path, u32 map_checksum, u32 memory_checksum,
+                       bool bad) const;
 };
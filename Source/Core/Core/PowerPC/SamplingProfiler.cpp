@@ -0,0 +1,369 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MachineContext.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace PowerPC
+{
+namespace
+{
+#if !defined(_WIN32) && !defined(_M_GENERIC)
+std::atomic<SamplingProfiler*> s_active_profiler = nullptr;
+std::atomic<u32> s_active_signal_handlers = 0;
+bool s_signal_handler_installed = false;
+#endif
+}  // namespace
+
+SamplingProfiler::SamplingProfiler(Core::System& system) : m_system(system)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+  Stop();
+}
+
+bool SamplingProfiler::Start(std::chrono::microseconds interval)
+{
+  if (m_running.IsSet())
+    return false;
+
+  if (!Core::IsCPUThread())
+  {
+    ERROR_LOG_FMT(POWERPC, "The sampling profiler must be started on the CPU thread");
+    return false;
+  }
+
+#if defined(_M_GENERIC)
+  ERROR_LOG_FMT(POWERPC, "The sampling profiler is not supported on this platform");
+  return false;
+#else
+#ifdef _WIN32
+  if (!DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &m_cpu_thread,
+                       THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE, 0))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open the CPU thread for sampling: {}", GetLastError());
+    return false;
+  }
+#else
+  SamplingProfiler* expected = nullptr;
+  if (!s_active_profiler.compare_exchange_strong(expected, this))
+  {
+    ERROR_LOG_FMT(POWERPC, "Another sampling profiler is already running");
+    return false;
+  }
+
+  m_cpu_thread = pthread_self();
+
+  // The handler stays installed once the first profiler has started, because restoring the default
+  // action would terminate the process if a signal is still in flight when the profiler stops.
+  if (!s_signal_handler_installed)
+  {
+    struct sigaction sa;
+    sa.sa_sigaction = &SignalHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, nullptr) != 0)
+    {
+      ERROR_LOG_FMT(POWERPC, "Failed to install the SIGPROF handler: {}", std::strerror(errno));
+      s_active_profiler.store(nullptr);
+      return false;
+    }
+    s_signal_handler_installed = true;
+  }
+#endif
+
+  {
+    std::lock_guard lk(m_stacks_mutex);
+    m_stacks.clear();
+    m_sample_count = 0;
+  }
+  m_read_index.store(0);
+  m_write_index.store(0);
+  m_dropped_samples.store(0);
+
+  m_stop_event.Reset();
+  m_running.Set();
+  m_thread = std::thread(&SamplingProfiler::SamplingThread, this, interval);
+  return true;
+#endif
+}
+
+void SamplingProfiler::Stop()
+{
+  if (!m_running.TestAndClear())
+    return;
+
+  m_stop_event.Set();
+  m_thread.join();
+
+#ifdef _WIN32
+  CloseHandle(m_cpu_thread);
+  m_cpu_thread = nullptr;
+#elif !defined(_M_GENERIC)
+  // Signals that are still in flight are ignored from here on, but one that is already being
+  // handled must finish before this profiler can go away.
+  s_active_profiler.store(nullptr);
+  while (s_active_signal_handlers.load() != 0)
+    std::this_thread::yield();
+#endif
+
+  ProcessSamples();
+}
+
+bool SamplingProfiler::IsRunning() const
+{
+  return m_running.IsSet();
+}
+
+u64 SamplingProfiler::GetSampleCount() const
+{
+  std::lock_guard lk(m_stacks_mutex);
+  return m_sample_count;
+}
+
+u64 SamplingProfiler::GetDroppedSampleCount() const
+{
+  return m_dropped_samples.load(std::memory_order_relaxed);
+}
+
+void SamplingProfiler::SamplingThread(std::chrono::microseconds interval)
+{
+  Common::SetCurrentThreadName("Sampling Profiler");
+
+  auto next_sample = std::chrono::steady_clock::now();
+  while (true)
+  {
+    next_sample += interval;
+    const auto now = std::chrono::steady_clock::now();
+    // Don't try to catch up after falling behind, that would just cause a burst of samples
+    if (next_sample < now)
+      next_sample = now;
+    if (m_stop_event.WaitFor(next_sample - now))
+      break;
+
+    ProcessSamples();
+
+    // While the CPU thread is paused it isn't running guest code, so there's nothing to attribute
+    if (m_system.GetCPU().GetState() == CPU::State::Running)
+      TakeSample();
+  }
+}
+
+void SamplingProfiler::TakeSample()
+{
+#ifdef _WIN32
+  if (SuspendThread(m_cpu_thread) == static_cast<DWORD>(-1))
+    return;
+  CONTEXT context{};
+  context.ContextFlags = CONTEXT_CONTROL;
+  if (GetThreadContext(m_cpu_thread, &context))
+    CaptureSample(reinterpret_cast<const u8*>(context.CTX_PC));
+  ResumeThread(m_cpu_thread);
+#elif !defined(_M_GENERIC)
+  pthread_kill(m_cpu_thread, SIGPROF);
+#endif
+}
+
+#if !defined(_WIN32) && !defined(_M_GENERIC)
+void SamplingProfiler::SignalHandler(int sig, siginfo_t*, void* raw_context)
+{
+  if (sig != SIGPROF)
+    return;
+
+  s_active_signal_handlers.fetch_add(1);
+  SamplingProfiler* const profiler = s_active_profiler.load();
+  if (!profiler || !pthread_equal(pthread_self(), profiler->m_cpu_thread))
+  {
+    s_active_signal_handlers.fetch_sub(1);
+    return;
+  }
+
+  const int saved_errno = errno;
+  ucontext_t* const context = static_cast<ucontext_t*>(raw_context);
+#if defined(__OpenBSD__)
+  const SContext* const ctx = context;
+#elif defined(__APPLE__) && !defined(USE_SIGACTION_ON_APPLE)
+  const SContext* const ctx = &context->uc_mcontext->__ss;
+#elif defined(__APPLE__)
+  const SContext* const ctx = context->uc_mcontext;
+#else
+  const SContext* const ctx = &context->uc_mcontext;
+#endif
+  profiler->CaptureSample(reinterpret_cast<const u8*>(ctx->CTX_PC));
+  errno = saved_errno;
+  s_active_signal_handlers.fetch_sub(1);
+}
+#endif
+
+void SamplingProfiler::CaptureSample(const u8* host_pc)
+{
+  const u32 write_index = m_write_index.load(std::memory_order_relaxed);
+  if (write_index - m_read_index.load(std::memory_order_acquire) >= SAMPLE_BUFFER_SIZE)
+  {
+    m_dropped_samples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // Registers that the JIT keeps in host registers may be slightly stale here. PC is only written
+  // back on block exits, and r1 is only written back once a function prologue is done with it.
+  const PowerPCState& ppc_state = m_system.GetPPCState();
+  RawSample& sample = m_samples[write_index % SAMPLE_BUFFER_SIZE];
+  sample.host_pc = host_pc;
+  sample.pc = ppc_state.pc;
+  sample.lr = LR(ppc_state);
+  sample.depth = 0;
+
+  // Each stack frame starts with a pointer to the caller's frame, and the saved LR of a function is
+  // stored 4 bytes into its caller's frame.
+  u32 stack_pointer = ppc_state.gpr[1];
+  while (sample.depth < MAX_STACK_DEPTH)
+  {
+    const std::optional<u32> back_chain = ReadGuestU32(stack_pointer);
+    if (!back_chain || *back_chain <= stack_pointer)
+      break;
+    const std::optional<u32> return_address = ReadGuestU32(*back_chain + 4);
+    if (!return_address || *return_address == 0)
+      break;
+    sample.return_addresses[sample.depth++] = *return_address;
+    stack_pointer = *back_chain;
+  }
+
+  m_write_index.store(write_index + 1, std::memory_order_release);
+}
+
+std::optional<u32> SamplingProfiler::ReadGuestU32(u32 address) const
+{
+  // Going through the MMU isn't safe while the CPU thread is interrupted, so only the default
+  // BAT mappings of MEM1 and MEM2 are supported. These are where game stacks live.
+  if (address % 4 != 0 || address < 0x80000000)
+    return std::nullopt;
+
+  auto& memory = m_system.GetMemory();
+  const u32 physical_address = address & 0x1FFFFFFF;
+  const u8* data = nullptr;
+  if (physical_address < memory.GetRamSizeReal())
+  {
+    data = memory.GetRAM() + physical_address;
+  }
+  else if (memory.GetEXRAM() && physical_address >= 0x10000000 &&
+           physical_address - 0x10000000 < memory.GetExRamSizeReal())
+  {
+    data = memory.GetEXRAM() + (physical_address - 0x10000000);
+  }
+  else
+  {
+    return std::nullopt;
+  }
+
+  u32 value;
+  std::memcpy(&value, data, sizeof(value));
+  return Common::swap32(value);
+}
+
+void SamplingProfiler::ProcessSamples()
+{
+  u32 read_index = m_read_index.load(std::memory_order_relaxed);
+  const u32 write_index = m_write_index.load(std::memory_order_acquire);
+  if (read_index == write_index)
+    return;
+
+  JitInterface& jit_interface = m_system.GetJitInterface();
+  std::lock_guard lk(m_stacks_mutex);
+  for (; read_index != write_index; ++read_index)
+  {
+    const RawSample& sample = m_samples[read_index % SAMPLE_BUFFER_SIZE];
+
+    Stack stack;
+    stack.callers.assign(sample.return_addresses.rend() - sample.depth,
+                         sample.return_addresses.rend());
+    stack.lr = sample.lr;
+
+    // The block may have been destroyed since the sample was taken, in which case its host code may
+    // already belong to another block. This is rare enough not to matter for a statistical profile.
+    const std::optional<u32> block_address =
+        jit_interface.GetBlockAddressFromHostCode(sample.host_pc);
+    stack.in_jit_code = block_address.has_value();
+    stack.pc = block_address.value_or(sample.pc);
+
+    ++m_stacks[std::move(stack)];
+    ++m_sample_count;
+  }
+  m_read_index.store(read_index, std::memory_order_release);
+}
+
+bool SamplingProfiler::WriteFoldedStacks(const std::string& path) const
+{
+  PPCSymbolDB& symbol_db = m_system.GetPPCSymbolDB();
+  const auto get_name = [&](u32 address) -> std::string {
+    const Common::Symbol* const symbol = symbol_db.GetSymbolFromAddr(address);
+    return symbol ? symbol->name : fmt::format("{:08x}", address);
+  };
+
+  std::map<std::string, u64> folded_stacks;
+  {
+    std::lock_guard lk(m_stacks_mutex);
+    for (const auto& [stack, count] : m_stacks)
+    {
+      std::vector<std::string> frames;
+      frames.reserve(stack.callers.size() + 3);
+      for (const u32 address : stack.callers)
+        frames.push_back(get_name(address));
+
+      // LR only points into the caller if the current function hasn't saved it yet, which is the
+      // case for leaf functions. Otherwise it points into the current function or duplicates the
+      // innermost return address from the stack.
+      const std::string pc_name = get_name(stack.pc);
+      std::string lr_name = get_name(stack.lr);
+      if (lr_name != pc_name && (frames.empty() || lr_name != frames.back()))
+        frames.push_back(std::move(lr_name));
+      frames.push_back(pc_name);
+      if (!stack.in_jit_code)
+        frames.push_back("[host]");
+
+      folded_stacks[fmt::format("{}", fmt::join(frames, ";"))] += count;
+    }
+  }
+
+  File::IOFile file(path, "w");
+  if (!file)
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open '{}' for writing", path);
+    return false;
+  }
+  for (const auto& [stack, count] : folded_stacks)
+  {
+    const std::string line = fmt::format("{} {}\n", stack, count);
+    if (!file.WriteString(line))
+    {
+      ERROR_LOG_FMT(POWERPC, "Failed to write sampling profile to '{}'", path);
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace PowerPC
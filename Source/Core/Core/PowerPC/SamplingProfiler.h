@@ -0,0 +1,121 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <compare>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+namespace Core
+{
+class System;
+}
+
+namespace PowerPC
+{
+// Finds out where emulated time goes by periodically interrupting the CPU thread, instead of
+// instrumenting every JIT block like block profiling does.
+//
+// On every sample, the host PC of the CPU thread is mapped back to the JIT block that contains it,
+// and the guest call stack is recovered from LR and the r1 back chain. Samples are aggregated on
+// the profiler thread and resolved to PPCSymbolDB symbols when they are written out.
+class SamplingProfiler
+{
+public:
+  static constexpr u32 MAX_STACK_DEPTH = 32;
+  static constexpr u32 SAMPLE_BUFFER_SIZE = 256;
+
+  explicit SamplingProfiler(Core::System& system);
+  SamplingProfiler(const SamplingProfiler&) = delete;
+  SamplingProfiler(SamplingProfiler&&) = delete;
+  SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+  SamplingProfiler& operator=(SamplingProfiler&&) = delete;
+  ~SamplingProfiler();
+
+  // Starts sampling the calling thread, which must be the CPU thread, every interval.
+  // Samples from a previous run are discarded.
+  bool Start(std::chrono::microseconds interval);
+  void Stop();
+  bool IsRunning() const;
+
+  u64 GetSampleCount() const;
+  u64 GetDroppedSampleCount() const;
+
+  // Writes the samples in the collapsed stack format ("outer;inner;leaf count" per line) that is
+  // understood by flamegraph.pl, inferno and speedscope.
+  bool WriteFoldedStacks(const std::string& path) const;
+
+private:
+  // Everything that is captured while the CPU thread is interrupted. This must not allocate or
+  // take locks, since the CPU thread may be interrupted at any point.
+  struct RawSample
+  {
+    const u8* host_pc;
+    u32 pc;
+    u32 lr;
+    u32 depth;
+    std::array<u32, MAX_STACK_DEPTH> return_addresses;
+  };
+
+  struct Stack
+  {
+    // Return addresses found on the guest stack, outermost first
+    std::vector<u32> callers;
+    u32 lr;
+    u32 pc;
+    bool in_jit_code;
+
+    auto operator<=>(const Stack&) const = default;
+  };
+
+  void SamplingThread(std::chrono::microseconds interval);
+  void TakeSample();
+  void CaptureSample(const u8* host_pc);
+  void ProcessSamples();
+  std::optional<u32> ReadGuestU32(u32 address) const;
+
+#ifndef _WIN32
+  static void SignalHandler(int sig, siginfo_t* info, void* raw_context);
+#endif
+
+  Core::System& m_system;
+
+  std::thread m_thread;
+  Common::Flag m_running;
+  Common::Event m_stop_event;
+
+#ifdef _WIN32
+  // HANDLE
+  void* m_cpu_thread = nullptr;
+#else
+  pthread_t m_cpu_thread{};
+#endif
+
+  // Single producer (the interrupted CPU thread), single consumer (the profiler thread)
+  std::array<RawSample, SAMPLE_BUFFER_SIZE> m_samples{};
+  std::atomic<u32> m_write_index = 0;
+  std::atomic<u32> m_read_index = 0;
+  std::atomic<u64> m_dropped_samples = 0;
+
+  mutable std::mutex m_stacks_mutex;
+  std::map<Stack, u64> m_stacks;
+  u64 m_sample_count = 0;
+};
+}  // namespace PowerPC
@@ -3,17 +3,23 @@
 
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <span>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -101,18 +107,35 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(const Core::CPUThreadGuard& guard, u32 address, u32 size, const MEGASignature& sig)
+// Reads the code at address into dest, one page at a time. Returns false if any of it can't be
+// read.
+bool ReadCode(const Core::CPUThreadGuard& guard, u32 address, std::span<u32> dest)
 {
-  if (size != sig.code.size() * sizeof(u32))
+  std::span<u8> bytes(reinterpret_cast<u8*>(dest.data()), dest.size_bytes());
+  while (!bytes.empty())
+  {
+    const size_t chunk_size =
+        std::min(bytes.size(), PowerPC::HW_PAGE_SIZE - (address & PowerPC::HW_PAGE_MASK));
+    if (!PowerPC::MMU::HostTryReadBlock(guard, address, bytes.first(chunk_size)))
+      return false;
+    address += static_cast<u32>(chunk_size);
+    bytes = bytes.subspan(chunk_size);
+  }
+
+  for (u32& instruction : dest)
+    instruction = Common::swap32(instruction);
+  return true;
+}
+
+bool Compare(std::span<const u32> code, const MEGASignature& sig)
+{
+  if (code.size() != sig.code.size())
     return false;
 
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 && PowerPC::MMU::HostRead_U32(
-                                guard, static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
-    {
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
-    }
   }
   return true;
 }
@@ -160,19 +183,57 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
 
 void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
 {
+  // Only signatures of the same size can match a function, so bucket them by size. Every bucket
+  // keeps the file order, so the first matching signature still wins.
+  std::unordered_map<u32, std::vector<const MEGASignature*>> signatures_by_size;
+  for (const auto& sig : m_signatures)
+    signatures_by_size[static_cast<u32>(sig.code.size() * sizeof(u32))].push_back(&sig);
+
+  std::vector<Common::Symbol*> candidates;
   for (auto& it : symbol_db->AccessSymbols())
   {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    if (signatures_by_size.contains(it.second.size))
+      candidates.push_back(&it.second);
+  }
+
+  // Functions are matched in parallel. Renaming them is left to this thread, so that the symbol
+  // database is only read by the workers.
+  std::vector<const MEGASignature*> matches(candidates.size());
+  const auto match_candidates = [&](size_t first, size_t stride) {
+    std::vector<u32> code;
+    for (size_t i = first; i < candidates.size(); i += stride)
     {
-      if (Compare(guard, symbol.address, symbol.size, sig))
-      {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
-        break;
-      }
+      const Common::Symbol& symbol = *candidates[i];
+      code.resize(symbol.size / sizeof(u32));
+      if (!ReadCode(guard, symbol.address, code))
+        continue;
+
+      const auto& bucket = signatures_by_size.find(symbol.size)->second;
+      const auto sig = std::ranges::find_if(
+          bucket, [&](const MEGASignature* signature) { return Compare(code, *signature); });
+      if (sig != bucket.end())
+        matches[i] = *sig;
     }
+  };
+
+  const size_t thread_count = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                                 std::max<size_t>(candidates.size() / 256, 1));
+  std::vector<std::future<void>> futures(thread_count - 1);
+  for (size_t i = 0; i < futures.size(); ++i)
+    futures[i] = std::async(std::launch::async, match_candidates, i + 1, thread_count);
+  match_candidates(0, thread_count);
+  for (auto& future : futures)
+    future.get();
+
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    if (!matches[i])
+      continue;
+
+    Common::Symbol& symbol = *candidates[i];
+    symbol.name = matches[i]->name;
+    INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", symbol.name, symbol.address,
+                 symbol.size);
   }
   symbol_db->Index();
 }
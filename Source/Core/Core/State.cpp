@@ -6,11 +6,13 @@
 #include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <locale>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
@@ -23,6 +25,7 @@
 #include <lzo/lzo1x.h>
 
 #include "Common/ChunkFile.h"
+#include "Common/ChunkedWriter.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
@@ -75,9 +78,60 @@ static std::mutex s_undo_load_buffer_mutex;
 
 static std::mutex s_load_or_save_in_progress_mutex;
 
+// Chunks of a savestate that is being serialized on the CPU thread. The save thread compresses
+// and writes them out while the rest of the state is still being serialized.
+class StateChunkQueue
+{
+public:
+  void Push(std::vector<u8> chunk)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_chunks.push_back(std::move(chunk));
+    }
+    m_cv.notify_one();
+  }
+
+  void Finish(bool success)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_finished = true;
+      m_success = success;
+    }
+    m_cv.notify_one();
+  }
+
+  // Waits for the next chunk. Returns nothing once all chunks have been popped.
+  std::optional<std::vector<u8>> Pop()
+  {
+    std::unique_lock lk(m_mutex);
+    m_cv.wait(lk, [this] { return !m_chunks.empty() || m_finished; });
+    if (m_chunks.empty())
+      return std::nullopt;
+
+    std::vector<u8> chunk = std::move(m_chunks.front());
+    m_chunks.pop_front();
+    return chunk;
+  }
+
+  bool Succeeded()
+  {
+    std::lock_guard lk(m_mutex);
+    return m_success;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::vector<u8>> m_chunks;
+  bool m_finished = false;
+  bool m_success = false;
+};
+
 struct CompressAndDumpState_args
 {
-  std::vector<u8> buffer_vector;
+  std::shared_ptr<StateChunkQueue> chunks;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
@@ -233,16 +287,20 @@ void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
   Core::RunOnCPUThread(
       system,
       [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-
-        DoState(system, p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+        buffer.clear();
+        Common::ChunkedWriter writer([&buffer](std::vector<u8> chunk) {
+          if (buffer.empty())
+            buffer = std::move(chunk);
+          else
+            buffer.insert(buffer.end(), chunk.begin(), chunk.end());
+        });
 
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+        PointerWrap p(writer);
         DoState(system, p);
+        if (p.IsWriteMode())
+          writer.Finish();
+        else
+          buffer.clear();
       },
       true);
 }
@@ -362,7 +420,8 @@ static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t un
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+// Returns the offset of the extended header in the file.
+static u64 WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -380,14 +439,28 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   f.WriteArray(&header.version_header, 1);
   f.WriteString(header.version_string);
 
+  const u64 extended_header_offset = f.Tell();
   f.WriteArray(&extended_header.base_header, 1);
   // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
+
+  return extended_header_offset;
+}
+
+// The size of a streamed state is only known once all of it has been written.
+static void UpdateUncompressedSizeInFile(size_t uncompressed_size, u64 extended_header_offset,
+                                         File::IOFile& f)
+{
+  StateExtendedHeader extended_header{};
+  CreateExtendedHeader(extended_header, uncompressed_size);
+
+  f.Seek(static_cast<s64>(extended_header_offset), File::SeekOrigin::Begin);
+  f.WriteArray(&extended_header.base_header, 1);
+  f.Seek(0, File::SeekOrigin::End);
 }
 
 static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args& save_args)
 {
-  const u8* const buffer_data = save_args.buffer_vector.data();
-  const size_t buffer_size = save_args.buffer_vector.size();
+  StateChunkQueue& chunks = *save_args.chunks;
   const std::string& filename = save_args.filename;
 
   // Find free temporary filename.
@@ -408,12 +481,29 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  const u64 extended_header_offset = WriteHeadersToFile(0, f);
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
-  else
-    f.WriteBytes(buffer_data, buffer_size);
+  // Each chunk is compressed into its own LZ4 block, which DecompressLZ4 already handles.
+  size_t uncompressed_size = 0;
+  while (std::optional<std::vector<u8>> chunk = chunks.Pop())
+  {
+    if (s_use_compression)
+      CompressBufferToFile(chunk->data(), chunk->size(), f);
+    else
+      f.WriteBytes(chunk->data(), chunk->size());
+
+    uncompressed_size += chunk->size();
+  }
+
+  if (!chunks.Succeeded())
+  {
+    // The CPU thread has already reported the error.
+    f.Close();
+    File::Delete(temp_filename);
+    return;
+  }
+
+  UpdateUncompressedSizeInFile(uncompressed_size, extended_header_offset, f);
 
   if (!f.IsGood())
     Core::DisplayMessage("Failed to write state file", 2000);
@@ -484,50 +574,43 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           ++s_state_writes_in_queue;
         }
 
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-        DoState(system, p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-        // Then actually do the write.
-        std::vector<u8> current_buffer;
-        current_buffer.resize(buffer_size);
-        ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(system, p);
+        // Queue the write before serializing, so that the save thread can compress and write
+        // chunks of the state while the rest is still being serialized.
+        auto chunks = std::make_shared<StateChunkQueue>();
+        std::shared_ptr<Common::Event> sync_event;
 
-        if (p.IsWriteMode())
+        CompressAndDumpState_args save_args;
+        save_args.chunks = chunks;
+        save_args.filename = filename;
+        if (wait)
         {
-          Core::DisplayMessage("Saving State...", 1000);
+          sync_event = std::make_shared<Common::Event>();
+          save_args.state_write_done_event = sync_event;
+        }
 
-          std::shared_ptr<Common::Event> sync_event;
+        s_save_thread.EmplaceItem(std::move(save_args));
 
-          CompressAndDumpState_args save_args;
-          save_args.buffer_vector = std::move(current_buffer);
-          save_args.filename = filename;
-          if (wait)
-          {
-            sync_event = std::make_shared<Common::Event>();
-            save_args.state_write_done_event = sync_event;
-          }
-
-          s_save_thread.EmplaceItem(std::move(save_args));
+        Common::ChunkedWriter writer(
+            [&chunks](std::vector<u8> chunk) { chunks->Push(std::move(chunk)); });
+        PointerWrap p(writer);
+        DoState(system, p);
 
-          if (sync_event)
-            sync_event->Wait();
+        if (p.IsWriteMode())
+        {
+          writer.Finish();
+          chunks->Finish(true);
+          Core::DisplayMessage("Saving State...", 1000);
         }
         else
         {
           // someone aborted the save by changing the mode?
-          {
-            // Note: The worker thread takes care of this in the other branch.
-            std::lock_guard lk_(s_state_writes_in_queue_mutex);
-            if (--s_state_writes_in_queue == 0)
-              s_state_write_queue_is_empty.notify_all();
-          }
+          // Note: The worker thread discards what has been written so far.
+          chunks->Finish(false);
           Core::DisplayMessage("Unable to save: Internal DoState Error", 4000);
         }
+
+        if (sync_event)
+          sync_event->Wait();
       },
       true);
 }
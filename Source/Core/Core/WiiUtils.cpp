@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <bitset>
 #include <cstddef>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -50,6 +52,41 @@
 
 namespace WiiUtils
 {
+// Streams a content from the WAD into ES with large sequential reads. The next chunk is read while
+// the current one is being decrypted, and at most two chunks are held in memory at any time.
+static bool ImportWADContentData(IOS::HLE::ESCore& es, IOS::HLE::ESCore::Context& context,
+                                 const DiscIO::VolumeWAD& wad, u64 offset, u64 size)
+{
+  constexpr u64 CHUNK_SIZE = 0x400000;
+  std::array<std::vector<u8>, 2> buffers;
+  const auto read_chunk = [&](std::vector<u8>& buffer, u64 chunk_offset) {
+    buffer.resize(std::min(CHUNK_SIZE, size - chunk_offset));
+    return wad.Read(offset + chunk_offset, buffer.size(), buffer.data());
+  };
+
+  if (size != 0 && !read_chunk(buffers[0], 0))
+    return false;
+
+  for (u64 chunk_offset = 0, i = 0; chunk_offset < size; chunk_offset += CHUNK_SIZE, ++i)
+  {
+    const std::vector<u8>& buffer = buffers[i % buffers.size()];
+    const u64 next_chunk_offset = chunk_offset + CHUNK_SIZE;
+    std::future<bool> next_read;
+    if (next_chunk_offset < size)
+    {
+      next_read = std::async(std::launch::async, read_chunk,
+                             std::ref(buffers[(i + 1) % buffers.size()]), next_chunk_offset);
+    }
+
+    const bool imported =
+        es.ImportContentData(context, 0, buffer.data(), static_cast<u32>(buffer.size())) >= 0;
+    const bool read = !next_read.valid() || next_read.get();
+    if (!imported || !read)
+      return false;
+  }
+  return true;
+}
+
 static bool ImportWAD(IOS::HLE::Kernel& ios, const DiscIO::VolumeWAD& wad,
                       IOS::HLE::ESCore::VerifySignature verify_signature)
 {
@@ -85,12 +122,14 @@ static bool ImportWAD(IOS::HLE::Kernel& ios, const DiscIO::VolumeWAD& wad,
 
   const bool contents_imported = [&]() {
     const u64 title_id = tmd.GetTitleId();
-    for (const IOS::ES::Content& content : tmd.GetContents())
+    const std::vector<IOS::ES::Content> contents = tmd.GetContents();
+    const std::vector<u64> content_offsets = wad.GetContentOffsets();
+    for (size_t i = 0; i < contents.size(); ++i)
     {
-      const std::vector<u8> data = wad.GetContent(content.index);
-
+      const IOS::ES::Content& content = contents[i];
       if (es.ImportContentBegin(context, title_id, content.id) < 0 ||
-          es.ImportContentData(context, 0, data.data(), static_cast<u32>(data.size())) < 0 ||
+          !ImportWADContentData(es, context, wad, content_offsets[i],
+                                Common::AlignUp(content.size, 0x40)) ||
           es.ImportContentEnd(context, 0) < 0)
       {
         PanicAlertFmtT("WAD installation failed: Could not import content {0:08x}.", content.id);
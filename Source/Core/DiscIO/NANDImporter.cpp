@@ -4,7 +4,10 @@
 #include "DiscIO/NANDImporter.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <future>
+#include <thread>
 
 #include "Common/Crypto/AES.h"
 #include "Common/FileUtil.h"
@@ -15,8 +18,13 @@
 
 namespace DiscIO
 {
-constexpr size_t NAND_SIZE = 0x20000000;
 constexpr size_t NAND_KEYS_SIZE = 0x400;
+constexpr size_t NAND_TOTAL_BLOCKS = 0x40000;
+constexpr size_t NAND_BLOCK_SIZE = 0x800;
+constexpr size_t NAND_ECC_BLOCK_SIZE = 0x40;
+constexpr size_t NAND_BIN_SIZE =
+    (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * NAND_TOTAL_BLOCKS;  // 0x21000000
+constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
 
 NANDImporter::NANDImporter() : m_nand_root(File::GetUserPath(D_WIIROOT_IDX))
 {
@@ -36,39 +44,27 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
 
   ExportKeys();
   ProcessEntry(0, "");
+  ExtractFiles();
   ExtractCertificates();
 }
 
 bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
                                std::function<std::string()> get_otp_dump_path)
 {
-  constexpr size_t NAND_TOTAL_BLOCKS = 0x40000;
-  constexpr size_t NAND_BLOCK_SIZE = 0x800;
-  constexpr size_t NAND_ECC_BLOCK_SIZE = 0x40;
-  constexpr size_t NAND_BIN_SIZE =
-      (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * NAND_TOTAL_BLOCKS;  // 0x21000000
-
-  File::IOFile file(path_to_bin, "rb");
-  const u64 image_size = file.GetSize();
-  if (image_size != NAND_BIN_SIZE + NAND_KEYS_SIZE && image_size != NAND_BIN_SIZE)
+  // The image is mapped rather than read into memory, so that only the pages which are actually
+  // used by the filesystem are ever loaded.
+  if (!m_nand.Open(path_to_bin, Common::MappedFile::Mode::Read))
   {
     PanicAlertFmtT("This file does not look like a BootMii NAND backup.");
     return false;
   }
 
-  m_nand.resize(NAND_SIZE);
-
-  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i++)
+  const u64 image_size = m_nand.GetSize();
+  if (image_size != NAND_BIN_SIZE + NAND_KEYS_SIZE && image_size != NAND_BIN_SIZE)
   {
-    // Instead of updating on every cycle, we only update every 1000 cycles for a balance between
-    // not updating fast enough vs updating too fast
-    if (i % 1000 == 0)
-      m_update_callback();
-
-    file.ReadBytes(&m_nand[i * NAND_BLOCK_SIZE], NAND_BLOCK_SIZE);
-
-    // We don't care about the ECC blocks
-    file.Seek(NAND_ECC_BLOCK_SIZE, File::SeekOrigin::Current);
+    PanicAlertFmtT("This file does not look like a BootMii NAND backup.");
+    m_nand.Close();
+    return false;
   }
 
   m_nand_keys.resize(NAND_KEYS_SIZE);
@@ -85,7 +81,26 @@ bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
   }
 
   // Otherwise, just read the key data from the NAND image.
-  return file.ReadBytes(m_nand_keys.data(), NAND_KEYS_SIZE);
+  std::memcpy(m_nand_keys.data(), m_nand.GetData() + NAND_BIN_SIZE, NAND_KEYS_SIZE);
+  return true;
+}
+
+void NANDImporter::ReadNAND(u64 offset, u8* buffer, size_t size) const
+{
+  // Every block in the image is followed by ECC data, which we don't care about
+  while (size > 0)
+  {
+    const u64 block = offset / NAND_BLOCK_SIZE;
+    const u64 offset_in_block = offset % NAND_BLOCK_SIZE;
+    const size_t bytes_to_copy = std::min<size_t>(size, NAND_BLOCK_SIZE - offset_in_block);
+    std::memcpy(buffer,
+                m_nand.GetData() + block * (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) +
+                    offset_in_block,
+                bytes_to_copy);
+    offset += bytes_to_copy;
+    buffer += bytes_to_copy;
+    size -= bytes_to_copy;
+  }
 }
 
 bool NANDImporter::FindSuperblock()
@@ -96,8 +111,8 @@ bool NANDImporter::FindSuperblock()
   for (int i = 0; i < 16; i++)
   {
     auto superblock = std::make_unique<NANDSuperblock>();
-    std::memcpy(superblock.get(), &m_nand[NAND_SUPERBLOCK_START + i * sizeof(NANDSuperblock)],
-                sizeof(NANDSuperblock));
+    ReadNAND(NAND_SUPERBLOCK_START + i * sizeof(NANDSuperblock),
+             reinterpret_cast<u8*>(superblock.get()), sizeof(NANDSuperblock));
 
     if (std::memcmp(superblock->magic.data(), "SFFS", 4) != 0)
     {
@@ -150,9 +165,8 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
     Type type = static_cast<Type>(entry.mode & 3);
     if (type == Type::File)
     {
-      std::vector<u8> data = GetEntryData(entry);
-      File::IOFile file(m_nand_root + path, "wb");
-      file.WriteBytes(data.data(), data.size());
+      // Files are extracted once all directories exist, see ExtractFiles
+      m_files_to_extract.push_back({path, entry});
     }
     else if (type == Type::Directory)
     {
@@ -168,34 +182,62 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
   }
 }
 
-std::vector<u8> NANDImporter::GetEntryData(const NANDFSTEntry& entry)
+void NANDImporter::ExtractFiles()
 {
-  constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
+  // Files are independent of each other, so they are decrypted and written on several threads.
+  // Each thread only ever holds one FAT block, which keeps memory usage bounded.
+  const auto extract_files = [this](size_t first, size_t stride) {
+    for (size_t i = first; i < m_files_to_extract.size(); i += stride)
+      ExtractFile(m_files_to_extract[i]);
+  };
+
+  const size_t thread_count = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                                 std::max<size_t>(m_files_to_extract.size(), 1));
+  std::vector<std::future<void>> futures(thread_count);
+  for (size_t i = 0; i < futures.size(); ++i)
+    futures[i] = std::async(std::launch::async, extract_files, i, thread_count);
+
+  for (auto& future : futures)
+  {
+    while (future.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready)
+      m_update_callback();
+  }
+  m_files_to_extract.clear();
+}
+
+bool NANDImporter::ExtractFile(const FileToExtract& file_to_extract) const
+{
+  const NANDFSTEntry& entry = file_to_extract.entry;
+  File::IOFile file(m_nand_root + file_to_extract.path, "wb");
 
   u16 sub = entry.sub;
   size_t remaining_bytes = entry.size;
-  std::vector<u8> data{};
-  data.reserve(remaining_bytes);
-
-  auto block = std::make_unique<u8[]>(NAND_FAT_BLOCK_SIZE);
+  std::array<u8, NAND_FAT_BLOCK_SIZE> encrypted_block;
+  std::array<u8, NAND_FAT_BLOCK_SIZE> block;
   while (remaining_bytes > 0)
   {
     if (sub >= m_superblock->fat.size())
     {
       ERROR_LOG_FMT(DISCIO, "FAT block index {} out of range", sub);
-      return {};
+      file.Resize(0);
+      return false;
     }
 
-    m_aes_ctx->CryptIvZero(&m_nand[NAND_FAT_BLOCK_SIZE * sub], block.get(), NAND_FAT_BLOCK_SIZE);
+    ReadNAND(NAND_FAT_BLOCK_SIZE * sub, encrypted_block.data(), encrypted_block.size());
+    m_aes_ctx->CryptIvZero(encrypted_block.data(), block.data(), NAND_FAT_BLOCK_SIZE);
 
-    size_t size = std::min(remaining_bytes, NAND_FAT_BLOCK_SIZE);
-    data.insert(data.end(), block.get(), block.get() + size);
+    const size_t size = std::min(remaining_bytes, NAND_FAT_BLOCK_SIZE);
+    if (!file.WriteBytes(block.data(), size))
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to write {}", file_to_extract.path);
+      return false;
+    }
     remaining_bytes -= size;
 
     sub = m_superblock->fat[sub];
   }
 
-  return data;
+  return true;
 }
 
 bool NANDImporter::ExtractCertificates()
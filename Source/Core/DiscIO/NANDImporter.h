@@ -13,6 +13,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/AES.h"
+#include "Common/MappedFile.h"
 #include "Common/Swap.h"
 
 namespace DiscIO
@@ -64,17 +65,27 @@ public:
 #pragma pack(pop)
 
 private:
+  struct FileToExtract
+  {
+    std::string path;
+    NANDFSTEntry entry;
+  };
+
   bool ReadNANDBin(const std::string& path_to_bin, std::function<std::string()> get_otp_dump_path);
+  void ReadNAND(u64 offset, u8* buffer, size_t size) const;
   bool FindSuperblock();
   std::string GetPath(const NANDFSTEntry& entry, const std::string& parent_path);
   std::string FormatDebugString(const NANDFSTEntry& entry);
   void ProcessEntry(u16 entry_number, const std::string& parent_path);
-  std::vector<u8> GetEntryData(const NANDFSTEntry& entry);
+  void ExtractFiles();
+  bool ExtractFile(const FileToExtract& file) const;
   void ExportKeys();
 
   std::string m_nand_root;
-  std::vector<u8> m_nand;
+  // The NAND image including the ECC data, which is skipped when reading
+  Common::MappedFile m_nand;
   std::vector<u8> m_nand_keys;
+  std::vector<FileToExtract> m_files_to_extract;
   std::unique_ptr<Common::AES::Context> m_aes_ctx;
   std::unique_ptr<NANDSuperblock> m_superblock;
   std::function<void()> m_update_callback;
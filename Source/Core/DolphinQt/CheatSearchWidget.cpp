@@ -304,7 +304,10 @@ void CheatSearchWidget::OnNextScanClicked()
   }
 
   const size_t old_count = m_session->GetResultCount();
-  const Cheats::SearchErrorCode error_code = m_session->RunSearch(Core::CPUThreadGuard{m_system});
+  // Only copying the values needs the CPU thread, the comparisons run without holding it.
+  Cheats::SearchErrorCode error_code = m_session->PrepareSearch(Core::CPUThreadGuard{m_system});
+  if (error_code == Cheats::SearchErrorCode::Success)
+    error_code = m_session->FinishSearch();
 
   if (error_code == Cheats::SearchErrorCode::Success)
   {
@@ -55,6 +55,12 @@ void LogConfigWidget::CreateWidgets()
   m_out_file = new QCheckBox(tr("Write to File"));
   m_out_console = new QCheckBox(tr("Write to Console"));
   m_out_window = new QCheckBox(tr("Write to Window"));
+  m_out_async = new QCheckBox(tr("Write Asynchronously"));
+  m_out_async->setToolTip(
+      tr("Queues log messages and writes them from a background thread, which greatly reduces "
+         "the performance impact of verbose logging.<br><br>Messages may be dropped if they are "
+         "logged faster than they can be written, and the last messages before a crash may be "
+         "lost."));
 
   auto* types = new QGroupBox(tr("Log Types"));
   auto* types_layout = new QVBoxLayout;
@@ -84,6 +90,7 @@ void LogConfigWidget::CreateWidgets()
   outputs_layout->addWidget(m_out_file);
   outputs_layout->addWidget(m_out_console);
   outputs_layout->addWidget(m_out_window);
+  outputs_layout->addWidget(m_out_async);
 
   layout->addWidget(types);
   types_layout->addWidget(m_types_toggle);
@@ -107,6 +114,7 @@ void LogConfigWidget::ConnectWidgets()
   connect(m_out_file, &QCheckBox::toggled, this, &LogConfigWidget::SaveSettings);
   connect(m_out_console, &QCheckBox::toggled, this, &LogConfigWidget::SaveSettings);
   connect(m_out_window, &QCheckBox::toggled, this, &LogConfigWidget::SaveSettings);
+  connect(m_out_async, &QCheckBox::toggled, this, &LogConfigWidget::SaveSettings);
 
   connect(m_types_toggle, &QPushButton::clicked, [this] {
     m_all_enabled = !m_all_enabled;
@@ -150,6 +158,7 @@ void LogConfigWidget::LoadSettings()
       log_manager->IsListenerEnabled(Common::Log::LogListener::CONSOLE_LISTENER));
   m_out_window->setChecked(
       log_manager->IsListenerEnabled(Common::Log::LogListener::LOG_WINDOW_LISTENER));
+  m_out_async->setChecked(log_manager->IsAsyncEnabled());
 
   // Config - Log Types
   for (int i = 0; i < static_cast<int>(Common::Log::LogType::NUMBER_OF_LOGS); ++i)
@@ -203,6 +212,8 @@ void LogConfigWidget::SaveSettings()
                               m_out_console->isChecked());
   log_manager->EnableListener(Common::Log::LogListener::LOG_WINDOW_LISTENER,
                               m_out_window->isChecked());
+  log_manager->SetAsyncEnabled(m_out_async->isChecked());
+
   // Config - Log Types
   for (int i = 0; i < static_cast<int>(Common::Log::LogType::NUMBER_OF_LOGS); ++i)
   {
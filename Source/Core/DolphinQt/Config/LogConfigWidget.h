@@ -37,6 +37,7 @@ private:
   QCheckBox* m_out_file;
   QCheckBox* m_out_console;
   QCheckBox* m_out_window;
+  QCheckBox* m_out_async;
   QPushButton* m_types_toggle;
   QListWidget* m_types_list;
 
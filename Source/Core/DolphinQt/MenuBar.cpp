@@ -3,6 +3,8 @@
 
 #include "DolphinQt/MenuBar.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <future>
 
@@ -13,6 +15,7 @@
 #include <QFontDialog>
 #include <QInputDialog>
 #include <QMap>
+#include <QSignalBlocker>
 #include <QUrl>
 
 #include <fmt/format.h>
@@ -154,6 +157,13 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
   m_jit_write_cache_log_dump->setEnabled(running && jit_exists);
+  m_jit_sampling_profiler->setEnabled(running && jit_exists);
+  if (!running)
+  {
+    // The profiler is stopped along with the emulation
+    const QSignalBlocker blocker(m_jit_sampling_profiler);
+    m_jit_sampling_profiler->setChecked(false);
+  }
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -218,6 +228,37 @@ void MenuBar::OnWriteJitBlockLogDump()
   }
 }
 
+void MenuBar::OnToggleSamplingProfiler(bool enabled)
+{
+  auto& jit_interface = Core::System::GetInstance().GetJitInterface();
+  if (enabled)
+  {
+    const std::chrono::microseconds interval{
+        std::max(Config::Get(Config::MAIN_DEBUG_JIT_SAMPLING_PROFILER_INTERVAL), 1)};
+    if (!jit_interface.StartSamplingProfiler(interval))
+    {
+      ModalMessageBox::warning(this, tr("Error"), tr("Failed to start the sampling profiler."));
+      const QSignalBlocker blocker(m_jit_sampling_profiler);
+      m_jit_sampling_profiler->setChecked(false);
+    }
+    return;
+  }
+
+  jit_interface.StopSamplingProfiler();
+  const std::string filename =
+      fmt::format("{}{}_samples.folded", File::GetUserPath(D_DUMPDEBUG_JITBLOCKS_IDX),
+                  SConfig::GetInstance().GetGameID());
+  if (!jit_interface.WriteSamplingProfile(filename))
+  {
+    ModalMessageBox::warning(
+        this, tr("Error"),
+        tr("Failed to open \"%1\" for writing.").arg(QString::fromStdString(filename)));
+    return;
+  }
+  ModalMessageBox::information(this, tr("Success"),
+                               tr("Wrote to \"%1\".").arg(QString::fromStdString(filename)));
+}
+
 void MenuBar::AddFileMenu()
 {
   QMenu* file_menu = addMenu(tr("&File"));
@@ -921,6 +962,9 @@ void MenuBar::AddJITMenu()
   });
   m_jit_write_cache_log_dump =
       m_jit->addAction(tr("Write JIT Block Log Dump"), this, &MenuBar::OnWriteJitBlockLogDump);
+  m_jit_sampling_profiler = m_jit->addAction(tr("Enable JIT Sampling Profiler"));
+  m_jit_sampling_profiler->setCheckable(true);
+  connect(m_jit_sampling_profiler, &QAction::toggled, this, &MenuBar::OnToggleSamplingProfiler);
 
   m_jit->addSeparator();
 
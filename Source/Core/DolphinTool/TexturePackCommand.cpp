@@ -0,0 +1,193 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/PackedTextureAssetLibrary.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+
+namespace DolphinTool
+{
+using Level = VideoCommon::CustomTextureData::ArraySlice::Level;
+
+// Halves an RGBA8 level with a box filter
+static Level DownsampleLevel(const Level& source)
+{
+  Level level;
+  level.format = source.format;
+  level.width = std::max(source.width / 2, 1u);
+  level.height = std::max(source.height / 2, 1u);
+  level.row_length = level.width;
+  level.data.resize(static_cast<std::size_t>(level.width) * level.height * 4);
+
+  const u32 step_x = source.width > 1 ? 2 : 1;
+  const u32 step_y = source.height > 1 ? 2 : 1;
+  for (u32 y = 0; y < level.height; y++)
+  {
+    for (u32 x = 0; x < level.width; x++)
+    {
+      for (u32 channel = 0; channel < 4; channel++)
+      {
+        u32 sum = 0;
+        for (u32 sy = 0; sy < step_y; sy++)
+        {
+          for (u32 sx = 0; sx < step_x; sx++)
+          {
+            const u32 source_x = x * step_x + sx;
+            const u32 source_y = y * step_y + sy;
+            sum += source.data[(source_y * source.row_length + source_x) * 4 + channel];
+          }
+        }
+        level.data[(y * level.width + x) * 4 + channel] =
+            static_cast<u8>((sum + (step_x * step_y) / 2) / (step_x * step_y));
+      }
+    }
+  }
+
+  return level;
+}
+
+static void GenerateMipmaps(VideoCommon::CustomTextureData::ArraySlice* slice)
+{
+  if (slice->m_levels.size() != 1 || slice->m_levels[0].format != AbstractTextureFormat::RGBA8)
+    return;
+
+  while (slice->m_levels.back().width > 1 || slice->m_levels.back().height > 1)
+    slice->m_levels.push_back(DownsampleLevel(slice->m_levels.back()));
+}
+
+int TexturePackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: texturepack [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the directory containing the custom textures of a game.")
+      .metavar("DIRECTORY");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack FILE to write.")
+      .metavar("FILE");
+
+  parser.add_option("-n", "--no_mipmaps")
+      .action("store_true")
+      .help("Optional. Do not generate mipmaps for textures that only have a base level.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  const std::string& input_directory = options["input"];
+  if (input_directory.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  if (!File::IsDirectory(input_directory))
+  {
+    fmt::print(std::cerr, "Error: The input is not a directory\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& output_file_path = options["output"];
+  if (output_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+
+  const bool generate_mipmaps = !options.is_set_by_user("no_mipmaps");
+
+  // Collect the textures the same way HiresTexture does. Mipmap files are picked up by the
+  // library when their base level is loaded.
+  auto library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+  std::map<std::string, bool> texture_names;
+  for (const std::string& path :
+       Common::DoFileSearch({input_directory}, {".png", ".dds"}, /*recursive*/ true))
+  {
+    std::string filename;
+    SplitPath(path, nullptr, &filename, nullptr);
+    if (!filename.starts_with("tex1_") || filename.find("_mip") != std::string::npos)
+      continue;
+
+    const std::size_t arb_index = filename.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      filename.erase(arb_index, 4);
+
+    if (!texture_names.try_emplace(filename, has_arbitrary_mipmaps).second)
+    {
+      fmt::print(std::cerr, "Warning: Skipping duplicate texture '{}'\n", path);
+      continue;
+    }
+
+    library->SetAssetIDMapData(filename, {{"texture", StringToPath(path)}});
+  }
+
+  std::vector<VideoCommon::TexturePack::SourceTexture> textures;
+  textures.reserve(texture_names.size());
+  for (const auto& [name, has_arbitrary_mipmaps] : texture_names)
+    textures.push_back({name, has_arbitrary_mipmaps, {}});
+
+  // Decoding the source images dominates the runtime, so spread it over all cores
+  std::atomic<std::size_t> next_texture = 0;
+  std::atomic<bool> failed = false;
+  const auto worker = [&] {
+    for (std::size_t i = next_texture++; i < textures.size(); i = next_texture++)
+    {
+      auto& texture = textures[i];
+      VideoCommon::TextureData data;
+      if (library->LoadGameTexture(texture.name, &data).m_bytes_loaded == 0 ||
+          data.m_texture.m_slices.empty())
+      {
+        fmt::print(std::cerr, "Error: Failed to load texture '{}'\n", texture.name);
+        failed = true;
+        continue;
+      }
+
+      texture.slice = std::move(data.m_texture.m_slices[0]);
+      if (generate_mipmaps && !texture.has_arbitrary_mipmaps)
+        GenerateMipmaps(&texture.slice);
+    }
+  };
+
+  std::vector<std::thread> threads(std::max(std::thread::hardware_concurrency(), 1u));
+  for (auto& thread : threads)
+    thread = std::thread(worker);
+  for (auto& thread : threads)
+    thread.join();
+
+  if (failed)
+    return EXIT_FAILURE;
+
+  if (!VideoCommon::TexturePack::Write(output_file_path, textures))
+  {
+    fmt::print(std::cerr, "Error: Failed to write the texture pack\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Packed {} textures into '{}'\n", textures.size(), output_file_path);
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
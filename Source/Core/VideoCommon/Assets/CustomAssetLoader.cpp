@@ -3,6 +3,9 @@
 
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "Common/MemoryUtil.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
@@ -44,6 +47,10 @@ void CustomAssetLoader::Init()
     }
   });
 
+  // Assets are independent of each other, so they can be decoded in parallel. Leave some cores
+  // for the emulation itself.
+  const std::size_t load_thread_count =
+      std::clamp<std::size_t>(std::thread::hardware_concurrency() / 2, 1, MAX_ASSET_LOAD_THREADS);
   m_asset_load_thread.Reset("Custom Asset Loader", [this](std::weak_ptr<CustomAsset> asset) {
     if (auto ptr = asset.lock())
     {
@@ -66,7 +73,7 @@ void CustomAssetLoader::Init()
         }
       }
     }
-  });
+  }, load_thread_count);
 }
 
 void CustomAssetLoader ::Shutdown()
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -19,10 +20,18 @@ public:
     struct Level
     {
       std::vector<u8> data;
+      // Used instead of data when the level is read straight out of a memory-mapped texture pack.
+      // The library that loaded the level keeps the mapping alive.
+      std::span<const u8> mapped_data;
       AbstractTextureFormat format = AbstractTextureFormat::RGBA8;
       u32 width = 0;
       u32 height = 0;
       u32 row_length = 0;
+
+      std::span<const u8> GetData() const
+      {
+        return mapped_data.empty() ? std::span<const u8>(data) : mapped_data;
+      }
     };
     std::vector<Level> m_levels;
   };
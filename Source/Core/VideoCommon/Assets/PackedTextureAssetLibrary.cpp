@@ -0,0 +1,304 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/PackedTextureAssetLibrary.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/Align.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+#include "VideoCommon/RenderState.h"
+
+namespace VideoCommon
+{
+namespace
+{
+u64 HashName(std::string_view name)
+{
+  return XXH64(name.data(), name.size(), 0);
+}
+
+// Checks that the level's data is large enough for its dimensions, like LoadDDSTexture does for
+// loose textures.
+bool IsValidLevelSize(const TexturePack::Level& level)
+{
+  // Also keeps the stride calculation from overflowing
+  constexpr u32 MAX_DIMENSION = 1 << 16;
+  if (level.width == 0 || level.height == 0 || level.width > MAX_DIMENSION ||
+      level.height > MAX_DIMENSION || level.row_length < level.width ||
+      level.row_length > MAX_DIMENSION)
+  {
+    return false;
+  }
+
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(level.format);
+  if (level.row_length % block_size != 0)
+    return false;
+
+  const u64 stride = AbstractTexture::CalculateStrideForFormat(level.format, level.row_length);
+  const u64 block_rows = Common::AlignUp(level.height, block_size) / block_size;
+  return level.data_size >= stride * block_rows;
+}
+
+bool WritePadding(File::IOFile* file, u64 offset)
+{
+  static constexpr std::array<u8, TexturePack::DATA_ALIGNMENT> zeros{};
+  const u64 position = file->Tell();
+  return position <= offset && file->WriteBytes(zeros.data(), offset - position);
+}
+}  // namespace
+
+bool TexturePack::Write(const std::string& path, std::span<const SourceTexture> textures)
+{
+  std::vector<u64> hashes(textures.size());
+  std::ranges::transform(textures, hashes.begin(),
+                         [](const SourceTexture& texture) { return HashName(texture.name); });
+  std::vector<std::size_t> order(textures.size());
+  std::iota(order.begin(), order.end(), std::size_t(0));
+  std::ranges::sort(order, [&](std::size_t lhs, std::size_t rhs) {
+    return hashes[lhs] < hashes[rhs];
+  });
+
+  std::vector<Entry> entries;
+  std::vector<Level> levels;
+  std::string names;
+  entries.reserve(textures.size());
+  for (const std::size_t index : order)
+  {
+    const SourceTexture& texture = textures[index];
+    entries.push_back({hashes[index], static_cast<u32>(names.size()),
+                       static_cast<u32>(texture.name.size()), static_cast<u32>(levels.size()),
+                       static_cast<u32>(texture.slice.m_levels.size()),
+                       texture.has_arbitrary_mipmaps ? EntryFlag_ArbitraryMipmaps : 0u, 0});
+    names += texture.name;
+    for (const auto& level : texture.slice.m_levels)
+    {
+      levels.push_back({level.width, level.height, level.row_length, level.format, 0,
+                        level.GetData().size()});
+    }
+  }
+
+  Header header{};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.entry_count = static_cast<u32>(entries.size());
+  header.level_count = static_cast<u32>(levels.size());
+  header.entries_offset = sizeof(Header);
+  header.levels_offset = header.entries_offset + entries.size() * sizeof(Entry);
+  header.names_offset = header.levels_offset + levels.size() * sizeof(Level);
+  header.names_size = names.size();
+
+  u64 data_offset = Common::AlignUp(header.names_offset + header.names_size, DATA_ALIGNMENT);
+  for (Level& level : levels)
+  {
+    level.data_offset = data_offset;
+    data_offset = Common::AlignUp(data_offset + level.data_size, DATA_ALIGNMENT);
+  }
+
+  File::IOFile file(path, "wb");
+  if (!file.WriteArray(&header, 1) || !file.WriteArray(entries.data(), entries.size()) ||
+      !file.WriteArray(levels.data(), levels.size()) ||
+      !file.WriteBytes(names.data(), names.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write texture pack header to '{}'", path);
+    return false;
+  }
+
+  auto level_iter = levels.begin();
+  for (const std::size_t index : order)
+  {
+    for (const auto& level : textures[index].slice.m_levels)
+    {
+      const std::span<const u8> level_data = level.GetData();
+      if (!WritePadding(&file, level_iter->data_offset) ||
+          !file.WriteBytes(level_data.data(), level_data.size()))
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to write texture '{}' to texture pack '{}'",
+                      textures[index].name, path);
+        return false;
+      }
+      ++level_iter;
+    }
+  }
+
+  return true;
+}
+
+bool PackedTextureAssetLibrary::Open(const std::string& path)
+{
+  m_entries = {};
+  m_levels = {};
+  m_names = {};
+  m_path = path;
+  if (!m_file.Open(path, Common::MappedFile::Mode::Read))
+    return false;
+
+  const u8* const data = m_file.GetData();
+  const u64 size = m_file.GetSize();
+  const auto fail = [&](std::string_view reason) {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' is invalid: {}", path, reason);
+    m_file.Close();
+    m_entries = {};
+    m_levels = {};
+    m_names = {};
+    return false;
+  };
+  const auto in_bounds = [size](u64 offset, u64 length) {
+    return offset <= size && length <= size - offset;
+  };
+
+  using namespace TexturePack;
+  Header header;
+  if (size < sizeof(header))
+    return fail("file is too small");
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != MAGIC)
+    return fail("bad magic");
+  if (header.version != VERSION)
+    return fail(fmt::format("unsupported version {}", header.version));
+
+  if (!in_bounds(header.entries_offset, u64(header.entry_count) * sizeof(Entry)) ||
+      header.entries_offset % alignof(Entry) != 0 ||
+      !in_bounds(header.levels_offset, u64(header.level_count) * sizeof(Level)) ||
+      header.levels_offset % alignof(Level) != 0 ||
+      !in_bounds(header.names_offset, header.names_size))
+  {
+    return fail("tables are out of bounds");
+  }
+
+  const std::span<const Entry> entries(
+      reinterpret_cast<const Entry*>(data + header.entries_offset), header.entry_count);
+  const std::span<const Level> levels(reinterpret_cast<const Level*>(data + header.levels_offset),
+                                      header.level_count);
+
+  for (const Level& level : levels)
+  {
+    if (level.format >= AbstractTextureFormat::Undefined)
+      return fail("unknown texture format");
+    if (!IsValidLevelSize(level))
+      return fail("texture level has invalid dimensions");
+    if (!in_bounds(level.data_offset, level.data_size))
+      return fail("texture data is out of bounds");
+  }
+  for (const Entry& entry : entries)
+  {
+    if (u64(entry.name_offset) + entry.name_length > header.names_size)
+      return fail("texture name is out of bounds");
+    if (entry.level_count == 0 || u64(entry.first_level) + entry.level_count > header.level_count)
+      return fail("texture levels are out of bounds");
+
+    // The texture cache creates a texture from the first level and uploads the others as its mips
+    const std::span<const Level> texture_levels = levels.subspan(entry.first_level,
+                                                                 entry.level_count);
+    for (std::size_t i = 1; i < texture_levels.size(); ++i)
+    {
+      const Level& level = texture_levels[i];
+      const Level& previous = texture_levels[i - 1];
+      if (level.format != previous.format || level.width != std::max(previous.width / 2, 1u) ||
+          level.height != std::max(previous.height / 2, 1u))
+      {
+        return fail("texture mipmaps don't match the first level");
+      }
+    }
+  }
+  if (!std::ranges::is_sorted(entries, {}, &Entry::name_hash))
+    return fail("entries are not sorted");
+
+  m_entries = entries;
+  m_levels = levels;
+  m_names = std::string_view(reinterpret_cast<const char*>(data + header.names_offset),
+                             header.names_size);
+  m_open_time = TimeType::clock::now();
+  return true;
+}
+
+void PackedTextureAssetLibrary::ForEachTexture(
+    const std::function<void(std::string_view, bool)>& func) const
+{
+  for (const TexturePack::Entry& entry : m_entries)
+    func(GetName(entry), (entry.flags & TexturePack::EntryFlag_ArbitraryMipmaps) != 0);
+}
+
+std::string_view PackedTextureAssetLibrary::GetName(const TexturePack::Entry& entry) const
+{
+  return m_names.substr(entry.name_offset, entry.name_length);
+}
+
+const TexturePack::Entry* PackedTextureAssetLibrary::FindEntry(std::string_view name) const
+{
+  const auto range =
+      std::ranges::equal_range(m_entries, HashName(name), {}, &TexturePack::Entry::name_hash);
+  const auto iter = std::ranges::find_if(
+      range, [&](const TexturePack::Entry& entry) { return GetName(entry) == name; });
+  return iter != range.end() ? &*iter : nullptr;
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                    TextureData* data)
+{
+  const TexturePack::Entry* const entry = FindEntry(asset_id);
+  if (!entry)
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in texture pack '{}'!", asset_id, m_path);
+    return {};
+  }
+
+  data->m_sampler = RenderState::GetLinearSamplerState();
+  data->m_type = TextureData::Type::Type_Texture2D;
+  data->m_texture.m_slices.clear();
+  auto& slice = data->m_texture.m_slices.emplace_back();
+
+  std::size_t bytes_loaded = 0;
+  for (const TexturePack::Level& packed_level : m_levels.subspan(entry->first_level,
+                                                                  entry->level_count))
+  {
+    auto& level = slice.m_levels.emplace_back();
+    level.mapped_data = std::span<const u8>(m_file.GetData() + packed_level.data_offset,
+                                            packed_level.data_size);
+    level.format = packed_level.format;
+    level.width = packed_level.width;
+    level.height = packed_level.height;
+    level.row_length = packed_level.row_length;
+    bytes_loaded += packed_level.data_size;
+  }
+
+  return LoadInfo{bytes_loaded, m_open_time};
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadPixelShader(const AssetID& asset_id,
+                                                                        PixelShaderData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                     MaterialData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo PackedTextureAssetLibrary::LoadMesh(const AssetID& asset_id,
+                                                                 MeshData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::TimeType
+PackedTextureAssetLibrary::GetLastAssetWriteTime(const AssetID&) const
+{
+  return m_open_time;
+}
+}  // namespace VideoCommon
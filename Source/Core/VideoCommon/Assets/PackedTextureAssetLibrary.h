@@ -0,0 +1,115 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+// Layout of a packed texture pack (.dtp) file. All values are little endian.
+//
+// The file starts with a Header, followed by the Entry table sorted by name hash, the Level table
+// and the names of all textures. The texture data comes last, with every level aligned to
+// DATA_ALIGNMENT so that it can be uploaded straight out of the mapped file.
+namespace TexturePack
+{
+constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+constexpr u32 VERSION = 1;
+constexpr u64 DATA_ALIGNMENT = 256;
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 entry_count;
+  u32 level_count;
+  u64 entries_offset;
+  u64 levels_offset;
+  u64 names_offset;
+  u64 names_size;
+};
+
+enum EntryFlag : u32
+{
+  EntryFlag_ArbitraryMipmaps = (1 << 0),
+};
+
+struct Entry
+{
+  // XXH64 of the name
+  u64 name_hash;
+  u32 name_offset;
+  u32 name_length;
+  u32 first_level;
+  u32 level_count;
+  u32 flags;
+  u32 padding;
+};
+
+struct Level
+{
+  u32 width;
+  u32 height;
+  u32 row_length;
+  AbstractTextureFormat format;
+  u64 data_offset;
+  u64 data_size;
+};
+
+static_assert(sizeof(Header) == 48);
+static_assert(sizeof(Entry) == 32);
+static_assert(sizeof(Level) == 32);
+
+// A texture to be written into a texture pack
+struct SourceTexture
+{
+  std::string name;
+  bool has_arbitrary_mipmaps = false;
+  CustomTextureData::ArraySlice slice;
+};
+
+// Writes the given textures into a new texture pack at path
+bool Write(const std::string& path, std::span<const SourceTexture> textures);
+}  // namespace TexturePack
+
+// This class implements 'CustomAssetLibrary' and loads game textures from a packed texture pack.
+// The pack is memory-mapped and texture levels point directly into the mapping, so loading a
+// texture neither reads nor decodes anything. Only textures are supported.
+class PackedTextureAssetLibrary final : public CustomAssetLibrary
+{
+public:
+  bool Open(const std::string& path);
+
+  // Calls func with the name of every texture in the pack and whether it has arbitrary mipmaps
+  void ForEachTexture(const std::function<void(std::string_view, bool)>& func) const;
+
+  LoadInfo LoadTexture(const AssetID& asset_id, TextureData* data) override;
+  LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+  LoadInfo LoadMesh(const AssetID& asset_id, MeshData* data) override;
+
+  // The pack is never reloaded while it is mapped, so this is the time it was opened
+  TimeType GetLastAssetWriteTime(const AssetID& asset_id) const override;
+
+private:
+  const TexturePack::Entry* FindEntry(std::string_view name) const;
+  std::string_view GetName(const TexturePack::Entry& entry) const;
+
+  Common::MappedFile m_file;
+  std::string m_path;
+  std::span<const TexturePack::Entry> m_entries;
+  std::span<const TexturePack::Level> m_levels;
+  std::string_view m_names;
+  TimeType m_open_time = {};
+};
+}  // namespace VideoCommon
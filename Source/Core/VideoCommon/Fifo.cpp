@@ -3,7 +3,9 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 
 #include "Common/Assert.h"
@@ -28,6 +30,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -48,6 +51,8 @@ void FifoManager::RefreshConfig()
   m_config_sync_gpu_max_distance = Config::Get(Config::MAIN_SYNC_GPU_MAX_DISTANCE);
   m_config_sync_gpu_min_distance = Config::Get(Config::MAIN_SYNC_GPU_MIN_DISTANCE);
   m_config_sync_gpu_overclock = Config::Get(Config::MAIN_SYNC_GPU_OVERCLOCK);
+  m_gpu_mainloop.SetMaxSpinTime(
+      std::chrono::microseconds(Config::Get(Config::MAIN_GPU_THREAD_MAX_SPIN_TIME)));
 }
 
 void FifoManager::DoState(PointerWrap& p)
@@ -292,6 +297,12 @@ void FifoManager::RunGpuLoop()
 
   m_gpu_mainloop.Run(
       [this] {
+        const Common::BlockingLoop::WaitCounters wait_counters =
+            m_gpu_mainloop.TakeWaitCounters();
+        ADDSTAT(g_stats.this_frame.num_gpu_thread_sleeps, wait_counters.sleeps);
+        ADDSTAT(g_stats.this_frame.num_gpu_thread_spin_hits, wait_counters.spin_hits);
+        ADDSTAT(g_stats.this_frame.gpu_thread_spin_us, wait_counters.spin_time.count());
+
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
 
@@ -318,6 +329,10 @@ void FifoManager::RunGpuLoop()
           auto& fifo = command_processor.GetFifo();
           command_processor.SetCPStatusFromGPU();
 
+          g_stats.this_frame.max_fifo_distance =
+              std::max(g_stats.this_frame.max_fifo_distance,
+                       static_cast<int>(fifo.CPReadWriteDistance.load(std::memory_order_relaxed)));
+
           // check if we are able to run this buffer
           while (!command_processor.IsInterruptWaiting() &&
                  fifo.bFF_GPReadEnable.load(std::memory_order_relaxed) &&
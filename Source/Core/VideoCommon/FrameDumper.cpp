@@ -3,6 +3,9 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -16,11 +19,17 @@
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
 // The video encoder needs the image to be a multiple of x samples.
 static constexpr int VIDEO_ENCODER_LCM = 4;
 
+// The readback of a frame is only mapped one frame after it was copied, so at least two slots are
+// needed to keep copying while a frame is pending.
+static constexpr int MIN_FRAME_DUMP_QUEUE_DEPTH = 2;
+static constexpr int MAX_FRAME_DUMP_QUEUE_DEPTH = 16;
+
 static bool DumpFrameToPNG(const FrameData& frame, const std::string& file_name)
 {
   return Common::ConvertRGBAToRGBAndSavePNG(file_name, frame.data, frame.width, frame.height,
@@ -62,12 +71,21 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  if (m_frame_dump_slots.empty())
+  {
+    m_frame_dump_slots.resize(std::clamp(Config::Get(Config::GFX_FRAME_DUMPS_QUEUE_DEPTH),
+                                         MIN_FRAME_DUMP_QUEUE_DEPTH, MAX_FRAME_DUMP_QUEUE_DEPTH));
+    m_frame_dump_next_slot = 0;
+  }
+
+  // The encoders may still be working on the frame that was last copied into this slot.
+  FrameDumpSlot& slot = m_frame_dump_slots[m_frame_dump_next_slot];
+  WaitForFrameDumpSlot(slot);
+  if (!CheckFrameDumpReadbackTexture(slot, target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  slot.texture->CopyFromTexture(src_texture, copy_rect, 0, 0, slot.texture->GetRect());
+  slot.state = m_ffmpeg_dump.FetchState(ticks, frame_number);
   m_frame_dump_needs_flush = true;
 }
 
@@ -99,9 +117,10 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool FrameDumper::CheckFrameDumpReadbackTexture(FrameDumpSlot& slot, u32 target_width,
+                                                u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = slot.texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -118,28 +137,26 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
 
 void FrameDumper::FlushFrameDump()
 {
+  // The frame copied during the previous frame has had a whole frame to finish on the GPU, so
+  // mapping it now normally doesn't stall.
+  if (m_frame_dump_pending_slot)
+  {
+    QueueFrameDumpSlot(*m_frame_dump_pending_slot);
+    m_frame_dump_pending_slot.reset();
+  }
+
   if (!m_frame_dump_needs_flush)
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  const std::size_t slot_index = m_frame_dump_next_slot;
+  m_frame_dump_next_slot = (m_frame_dump_next_slot + 1) % m_frame_dump_slots.size();
+  m_frame_dump_needs_flush = false;
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
+  // Only defer the readback while dumping frames. A lone screenshot should be taken right away.
+  if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+    m_frame_dump_pending_slot = slot_index;
   else
-  {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
-
-  m_frame_dump_needs_flush = false;
+    QueueFrameDumpSlot(slot_index);
 
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
@@ -148,30 +165,49 @@ void FrameDumper::FlushFrameDump()
 
 void FrameDumper::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
+  // Ensure the last queued readbacks have been sent to the encoder.
   FlushFrameDump();
+  if (m_frame_dump_pending_slot)
+  {
+    QueueFrameDumpSlot(*m_frame_dump_pending_slot);
+    m_frame_dump_pending_slot.reset();
+  }
 
-  if (!m_frame_dump_thread_running.IsSet())
-    return;
+  if (m_frame_dump_thread_running.IsSet())
+  {
+    // Ensure previous frames have been encoded.
+    FinishFrameData();
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+    // Wake thread up, and wait for it to exit.
+    {
+      std::lock_guard lk(m_frame_dump_lock);
+      m_frame_dump_thread_running.Clear();
+    }
+    m_frame_dump_queue_cond.notify_one();
+    if (m_frame_dump_thread.joinable())
+      m_frame_dump_thread.join();
+  }
+
+  if (m_frame_dump_slots.empty())
+    return;
 
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  FinishFrameData();
+  m_frame_dump_slots.clear();
+  m_frame_dump_next_slot = 0;
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::QueueFrameDumpSlot(std::size_t slot_index)
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
+  FrameDumpSlot& slot = m_frame_dump_slots[slot_index];
+  slot.texture->Flush();
+  if (!slot.texture->Map())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    return;
+  }
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -181,20 +217,52 @@ void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
     m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
   }
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  const AbstractStagingTexture& texture = *slot.texture;
+  {
+    std::lock_guard lk(m_frame_dump_lock);
+    slot.in_flight = true;
+    m_frame_dump_queue.push(
+        {FrameData{reinterpret_cast<const u8*>(texture.GetMappedPointer()),
+                   static_cast<int>(texture.GetConfig().width),
+                   static_cast<int>(texture.GetConfig().height),
+                   static_cast<int>(texture.GetMappedStride()), slot.state},
+         slot_index});
+  }
+  m_frame_dump_queue_cond.notify_one();
 }
 
-void FrameDumper::FinishFrameData()
+void FrameDumper::WaitForFrameDumpSlot(FrameDumpSlot& slot)
 {
-  if (!m_frame_dump_frame_running)
-    return;
+  {
+    std::unique_lock lk(m_frame_dump_lock);
+    if (slot.in_flight)
+    {
+      const auto wait_start = std::chrono::steady_clock::now();
+      m_frame_dump_slot_cond.wait(lk, [&slot] { return !slot.in_flight; });
+      ADDSTAT(g_stats.this_frame.frame_dump_wait_us,
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - wait_start)
+                  .count());
+    }
+  }
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  if (slot.texture && slot.texture->IsMapped())
+    slot.texture->Unmap();
+}
 
-  m_frame_dump_output_texture->Unmap();
+void FrameDumper::ReleaseFrameDumpSlot(std::size_t slot_index)
+{
+  {
+    std::lock_guard lk(m_frame_dump_lock);
+    m_frame_dump_slots[slot_index].in_flight = false;
+  }
+  m_frame_dump_slot_cond.notify_all();
+}
+
+void FrameDumper::FinishFrameData()
+{
+  for (FrameDumpSlot& slot : m_frame_dump_slots)
+    WaitForFrameDumpSlot(slot);
 }
 
 void FrameDumper::FrameDumpThreadFunc()
@@ -216,11 +284,20 @@ void FrameDumper::FrameDumpThreadFunc()
 
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+    QueuedFrame queued_frame;
+    {
+      std::unique_lock lk(m_frame_dump_lock);
+      m_frame_dump_queue_cond.wait(lk, [this] {
+        return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running.IsSet();
+      });
+      if (m_frame_dump_queue.empty())
+        break;
+
+      queued_frame = m_frame_dump_queue.front();
+      m_frame_dump_queue.pop();
+    }
 
-    auto frame = m_frame_dump_data;
+    const FrameData& frame = queued_frame.frame;
 
     // Save screenshot
     if (m_screenshot_request.TestAndClear())
@@ -235,6 +312,7 @@ void FrameDumper::FrameDumpThreadFunc()
       m_screenshot_completed.Set();
     }
 
+    bool handed_to_encoder = false;
     if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
     {
       if (!frame_dump_started)
@@ -253,20 +331,28 @@ void FrameDumper::FrameDumpThreadFunc()
       if (frame_dump_started)
       {
         if (dump_to_ffmpeg)
+        {
           DumpFrameToFFMPEG(frame);
+        }
         else
-          DumpFrameToImage(frame);
+        {
+          DumpFrameToImage(queued_frame);
+          handed_to_encoder = true;
+        }
       }
     }
 
-    m_frame_dump_done.Set();
+    // Frames handed to the image encoders are released once they have been written.
+    if (!handed_to_encoder)
+      ReleaseFrameDumpSlot(queued_frame.slot_index);
   }
 
   if (frame_dump_started)
   {
-    // No additional cleanup is needed when dumping to images.
     if (dump_to_ffmpeg)
       StopFrameDumpToFFMPEG();
+    else
+      m_image_encoder.Shutdown();
   }
 }
 
@@ -330,12 +416,22 @@ bool FrameDumper::StartFrameDumpToImage(const FrameData&)
     }
   }
 
+  // There is no point in having more encoders than frames that can be in flight.
+  const std::size_t encoder_count = std::clamp<std::size_t>(std::thread::hardware_concurrency(),
+                                                            1, m_frame_dump_slots.size());
+  m_image_encoder.Reset(
+      "FrameDumpEncoder",
+      [this](ImageDumpItem item) {
+        DumpFrameToPNG(item.queued_frame.frame, item.file_name);
+        ReleaseFrameDumpSlot(item.queued_frame.slot_index);
+      },
+      encoder_count);
   return true;
 }
 
-void FrameDumper::DumpFrameToImage(const FrameData& frame)
+void FrameDumper::DumpFrameToImage(const QueuedFrame& queued_frame)
 {
-  DumpFrameToPNG(frame, GetFrameDumpNextImageFileName());
+  m_image_encoder.EmplaceItem(ImageDumpItem{queued_frame, GetFrameDumpNextImageFileName()});
   m_frame_dump_image_counter++;
 }
 
@@ -3,11 +3,21 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
 #include "Common/Thread.h"
+#include "Common/WorkQueueThread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
@@ -38,6 +48,30 @@ public:
   void DoState(PointerWrap& p);
 
 private:
+  // A readback texture and the state of the frame copied into it. The slots form a ring so that
+  // the video thread can copy new frames while older ones are still being encoded.
+  struct FrameDumpSlot
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameState state;
+    // Set while the dump thread (or an image encoder) is using the mapped texture.
+    bool in_flight = false;
+  };
+
+  // A mapped frame and the slot it lives in, as handed from the video thread to the encoders.
+  struct QueuedFrame
+  {
+    FrameData frame;
+    std::size_t slot_index;
+  };
+
+  // A frame handed to the image encoder pool, along with the file it is written to.
+  struct ImageDumpItem
+  {
+    QueuedFrame queued_frame;
+    std::string file_name;
+  };
+
   // NOTE: The methods below are called on the framedumping thread.
   void FrameDumpThreadFunc();
   bool StartFrameDumpToFFMPEG(const FrameData&);
@@ -45,49 +79,54 @@ private:
   void StopFrameDumpToFFMPEG();
   std::string GetFrameDumpNextImageFileName() const;
   bool StartFrameDumpToImage(const FrameData&);
-  void DumpFrameToImage(const FrameData&);
+  void DumpFrameToImage(const QueuedFrame&);
 
   void ShutdownFrameDumping();
 
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Checks that the readback texture of the slot exists and is the correct size.
+  bool CheckFrameDumpReadbackTexture(FrameDumpSlot& slot, u32 target_width, u32 target_height);
+
+  // Maps the readback texture of the slot and queues it for encoding.
+  void QueueFrameDumpSlot(std::size_t slot_index);
+
+  // Blocks until the slot is no longer used by the encoders, then unmaps its texture.
+  void WaitForFrameDumpSlot(FrameDumpSlot& slot);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Called by the encoders once they no longer need the frame in the slot.
+  void ReleaseFrameDumpSlot(std::size_t slot_index);
 
-  // Ensures all encoded frames have been written to the output file.
+  // Ensures all queued frames have been encoded.
   void FinishFrameData();
 
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
-
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
+  // Ring of readback textures, sized from GFX_FRAME_DUMPS_QUEUE_DEPTH when dumping starts.
+  std::vector<FrameDumpSlot> m_frame_dump_slots;
+  std::size_t m_frame_dump_next_slot = 0;
+  // Slot that holds a copied frame that hasn't been queued for encoding yet. Mapping it is
+  // deferred until the end of the next frame so the GPU has finished the copy by then.
+  std::optional<std::size_t> m_frame_dump_pending_slot;
+  // Set when the most recent copy has not gone through FlushFrameDump yet.
+  bool m_frame_dump_needs_flush = false;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
+  // Slots queued for the dump thread, in frame order.
+  std::queue<QueuedFrame> m_frame_dump_queue;
+  std::mutex m_frame_dump_lock;
+  std::condition_variable m_frame_dump_queue_cond;
+  std::condition_variable m_frame_dump_slot_cond;
 
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Writes image sequence frames on several threads. Every frame gets its file name in order
+  // before it is queued, so the output order does not depend on which encoder finishes first.
+  Common::WorkQueueThread<ImageDumpItem> m_image_encoder;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
-
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
 
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <span>
 #include <variant>
 
 #include "Common/Logging/Log.h"
@@ -346,9 +347,10 @@ void CustomPipeline::UpdatePixelData(
                    ++level_index)
               {
                 auto& level = slice.m_levels[level_index];
+                const std::span<const u8> level_data = level.GetData();
                 texture_asset->m_texture->Load(level_index, level.width, level.height,
-                                               level.row_length, level.data.data(),
-                                               level.data.size(), static_cast<u32>(slice_index));
+                                               level.row_length, level_data.data(),
+                                               level_data.size(), static_cast<u32>(slice_index));
               }
             }
           }
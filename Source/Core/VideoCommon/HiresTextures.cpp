@@ -27,28 +27,40 @@
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/PackedTextureAssetLibrary.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
 constexpr std::string_view s_format_prefix{"tex1_"};
 
+constexpr std::string_view s_texture_pack_extension{".dtp"};
+
+namespace
+{
+struct HiresTextureSource
+{
+  bool has_arbitrary_mipmaps = false;
+  std::shared_ptr<VideoCommon::CustomAssetLibrary> library;
+};
+}  // namespace
+
 static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_hires_texture_cache;
-static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
+static std::unordered_map<std::string, HiresTextureSource> s_hires_texture_id_to_source;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 
 namespace
 {
-std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
+std::pair<std::string, HiresTextureSource> GetNameSourcePair(const TextureInfo& texture_info)
 {
-  if (s_hires_texture_id_to_arbmipmap.empty())
-    return {"", false};
+  if (s_hires_texture_id_to_source.empty())
+    return {"", {}};
 
   const auto texture_name_details = texture_info.CalculateTextureName();
   // look for an exact match first
   const std::string full_name = texture_name_details.GetFullName();
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(full_name);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  if (auto iter = s_hires_texture_id_to_source.find(full_name);
+      iter != s_hires_texture_id_to_source.end())
   {
     return {full_name, iter->second};
   }
@@ -57,8 +69,8 @@ std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
   const std::string texture_name_single_wildcard_tlut =
       fmt::format("{}_{}_$_{}", texture_name_details.base_name, texture_name_details.texture_name,
                   texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tlut);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  if (auto iter = s_hires_texture_id_to_source.find(texture_name_single_wildcard_tlut);
+      iter != s_hires_texture_id_to_source.end())
   {
     return {texture_name_single_wildcard_tlut, iter->second};
   }
@@ -67,13 +79,13 @@ std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
   const std::string texture_name_single_wildcard_tex =
       fmt::format("{}_${}_{}", texture_name_details.base_name, texture_name_details.tlut_name,
                   texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tex);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  if (auto iter = s_hires_texture_id_to_source.find(texture_name_single_wildcard_tex);
+      iter != s_hires_texture_id_to_source.end())
   {
     return {texture_name_single_wildcard_tex, iter->second};
   }
 
-  return {"", false};
+  return {"", {}};
 }
 }  // namespace
 
@@ -120,8 +132,8 @@ void HiresTexture::Update()
         if (has_arbitrary_mipmaps)
           filename.erase(arb_index, 4);
 
-        const auto [it, inserted] =
-            s_hires_texture_id_to_arbmipmap.try_emplace(filename, has_arbitrary_mipmaps);
+        const auto [it, inserted] = s_hires_texture_id_to_source.try_emplace(
+            filename, HiresTextureSource{has_arbitrary_mipmaps, s_file_library});
         if (!inserted)
         {
           failed_insert = true;
@@ -144,6 +156,35 @@ void HiresTexture::Update()
       }
     }
 
+    // Packed texture packs are read after the loose files, so that loose files can be used to
+    // replace individual textures of a pack.
+    const auto pack_paths = Common::DoFileSearch(
+        {texture_directory}, {std::string(s_texture_pack_extension)}, /*recursive*/ true);
+    for (auto& path : pack_paths)
+    {
+      auto library = std::make_shared<VideoCommon::PackedTextureAssetLibrary>();
+      if (!library->Open(path))
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to open texture pack '{}'", path);
+        continue;
+      }
+
+      library->ForEachTexture([&](std::string_view name, bool has_arbitrary_mipmaps) {
+        const auto [it, inserted] = s_hires_texture_id_to_source.try_emplace(
+            std::string(name), HiresTextureSource{has_arbitrary_mipmaps, library});
+        if (!inserted)
+          return;
+
+        if (g_ActiveConfig.bCacheHiresTextures)
+        {
+          auto hires_texture = std::make_shared<HiresTexture>(
+              has_arbitrary_mipmaps,
+              system.GetCustomAssetLoader().LoadGameTexture(it->first, library));
+          s_hires_texture_cache.try_emplace(it->first, std::move(hires_texture));
+        }
+      });
+    }
+
     if (failed_insert)
     {
       ERROR_LOG_FMT(VIDEO, "One or more textures at path '{}' were already inserted",
@@ -159,20 +200,20 @@ void HiresTexture::Update()
   else
   {
     OSD::AddMessage(
-        fmt::format("Found '{}' custom textures", s_hires_texture_id_to_arbmipmap.size()), 10000);
+        fmt::format("Found '{}' custom textures", s_hires_texture_id_to_source.size()), 10000);
   }
 }
 
 void HiresTexture::Clear()
 {
   s_hires_texture_cache.clear();
-  s_hires_texture_id_to_arbmipmap.clear();
+  s_hires_texture_id_to_source.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 }
 
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
 {
-  const auto [base_filename, has_arb_mipmaps] = GetNameArbPair(texture_info);
+  const auto [base_filename, source] = GetNameSourcePair(texture_info);
   if (base_filename == "")
     return nullptr;
 
@@ -184,8 +225,8 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
   {
     auto& system = Core::System::GetInstance();
     auto hires_texture = std::make_shared<HiresTexture>(
-        has_arb_mipmaps,
-        system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
+        source.has_arbitrary_mipmaps,
+        system.GetCustomAssetLoader().LoadGameTexture(base_filename, source.library));
     if (g_ActiveConfig.bCacheHiresTextures)
     {
       s_hires_texture_cache.try_emplace(base_filename, hires_texture);
@@ -114,6 +114,11 @@ void Statistics::Display() const
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
+  draw_statistic("GPU thread sleeps:", "%d", this_frame.num_gpu_thread_sleeps);
+  draw_statistic("GPU thread spin hits:", "%d", this_frame.num_gpu_thread_spin_hits);
+  draw_statistic("GPU thread spin time:", "%d us", this_frame.gpu_thread_spin_us);
+  draw_statistic("Max FIFO distance:", "%d", this_frame.max_fifo_distance);
+  draw_statistic("Frame dump wait time:", "%d us", this_frame.frame_dump_wait_us);
 
   ImGui::Columns(1);
 
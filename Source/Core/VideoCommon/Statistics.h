@@ -79,6 +79,13 @@ struct Statistics
     int num_draw_done = 0;
     int num_token = 0;
     int num_token_int = 0;
+
+    int num_gpu_thread_sleeps = 0;
+    int num_gpu_thread_spin_hits = 0;
+    int gpu_thread_spin_us = 0;
+    int max_fifo_distance = 0;
+
+    int frame_dump_wait_us = 0;
   };
   ThisFrame this_frame;
   void ResetFrame();
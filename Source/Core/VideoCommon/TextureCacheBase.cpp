@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1691,8 +1692,9 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
            ++level_index)
       {
         const auto& level = slice.m_levels[level_index];
+        const std::span<const u8> level_data = level.GetData();
         entry->texture->Load(level_index, level.width, level.height, level.row_length,
-                             level.data.data(), level.data.size(), data_index);
+                             level_data.data(), level_data.size(), data_index);
       }
     }
 
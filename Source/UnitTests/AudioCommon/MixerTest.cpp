@@ -0,0 +1,198 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/MixerKernels.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
+
+static std::vector<s16> RandomSamples(size_t count, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(-32768, 32767);
+  std::vector<s16> samples(count);
+  for (s16& sample : samples)
+    sample = static_cast<s16>(dist(rng));
+
+  // Make sure the extremes are covered.
+  samples[0] = -32768;
+  samples[1] = 32767;
+  return samples;
+}
+
+TEST(MixerKernels, MixWithVolume)
+{
+  // Use an odd number of frames so that the scalar tail of the vector kernels gets exercised.
+  constexpr u32 NUM_FRAMES = 1001;
+  const std::vector<s16> src = RandomSamples(NUM_FRAMES * 2, 1);
+  const std::vector<s16> initial_dest = RandomSamples(NUM_FRAMES * 2, 2);
+
+  for (const auto& [left_volume, right_volume] :
+       {std::pair{256, 256}, std::pair{0, 256}, std::pair{129, 3}, std::pair{255, 0}})
+  {
+    std::vector<s16> dest = initial_dest;
+    AudioCommon::MixWithVolume(dest.data(), src.data(), NUM_FRAMES, left_volume, right_volume);
+
+    for (u32 i = 0; i < NUM_FRAMES * 2; ++i)
+    {
+      const s32 volume = i % 2 == 0 ? right_volume : left_volume;
+      const s32 expected = std::clamp(initial_dest[i] + ((src[i] * volume) >> 8), -32767, 32767);
+      ASSERT_EQ(expected, dest[i]) << "index " << i << ", volume " << volume;
+    }
+  }
+}
+
+TEST(MixerKernels, ResampleLinear)
+{
+  constexpr u32 NUM_FRAMES = 501;
+  const std::vector<s16> left = RandomSamples(NUM_FRAMES, 3);
+  const std::vector<s16> right = RandomSamples(NUM_FRAMES, 4);
+
+  // 32 kHz to 48 kHz, 48 kHz to 32 kHz, and ratios that keep hitting the weights at the edges of
+  // the 16-bit range
+  for (const u32 ratio : {65536u * 32000 / 48000, 65536u * 48000 / 32000, 0x8000u, 0x10000u})
+  {
+    // An output size that isn't a multiple of the vector width runs out of output space in the
+    // scalar tail
+    for (const u32 max_frames : {NUM_FRAMES * 2, 7u})
+    {
+      std::vector<s16> out(NUM_FRAMES * 4);
+      u32 position = 0;
+      u32 frac = 0x1234;
+      const u32 written = AudioCommon::ResampleLinear(out.data(), max_frames, left.data(),
+                                                      right.data(), NUM_FRAMES, &position, &frac,
+                                                      ratio);
+
+      u32 expected_position = 0;
+      u32 expected_frac = 0x1234;
+      u32 expected_written = 0;
+      for (; expected_written < max_frames && expected_position + 1 < NUM_FRAMES;
+           ++expected_written)
+      {
+        const s64 l =
+            left[expected_position] +
+            ((s64(left[expected_position + 1] - left[expected_position]) * expected_frac) >> 16);
+        const s64 r =
+            right[expected_position] +
+            ((s64(right[expected_position + 1] - right[expected_position]) * expected_frac) >>
+             16);
+        ASSERT_EQ(r, out[expected_written * 2]) << "ratio " << ratio;
+        ASSERT_EQ(l, out[expected_written * 2 + 1]) << "ratio " << ratio;
+
+        expected_frac += ratio;
+        expected_position += expected_frac >> 16;
+        expected_frac &= 0xFFFF;
+      }
+
+      EXPECT_EQ(expected_written, written);
+      EXPECT_EQ(expected_position, position);
+      EXPECT_EQ(expected_frac, frac);
+    }
+  }
+}
+
+TEST(MixerKernels, ResampleSincPreservesDC)
+{
+  constexpr u32 NUM_FRAMES = 300;
+  const std::vector<s16> left(NUM_FRAMES + AudioCommon::SINC_HISTORY, 12345);
+  const std::vector<s16> right(NUM_FRAMES + AudioCommon::SINC_HISTORY, -32768);
+
+  const u32 ratio = 65536u * 44100 / 48000;
+  std::vector<s16> out(NUM_FRAMES * 4);
+  u32 position = 0;
+  u32 frac = 0;
+  const u32 written = AudioCommon::ResampleSinc(
+      out.data(), NUM_FRAMES * 2, left.data() + AudioCommon::SINC_HISTORY,
+      right.data() + AudioCommon::SINC_HISTORY, NUM_FRAMES, &position, &frac, ratio);
+
+  EXPECT_GT(written, 0u);
+  EXPECT_GE(position + AudioCommon::SINC_LOOKAHEAD, NUM_FRAMES);
+  for (u32 i = 0; i < written; ++i)
+  {
+    ASSERT_EQ(-32768, out[i * 2]);
+    ASSERT_EQ(12345, out[i * 2 + 1]);
+  }
+}
+
+TEST(MixerKernels, ResampleSincDownsamplingFilter)
+{
+  constexpr u32 NUM_FRAMES = 1000;
+  constexpr u32 SETTLE_FRAMES = 20;
+
+  // A tone at 80% of the Nyquist frequency of the input
+  std::vector<s16> input(NUM_FRAMES + AudioCommon::SINC_HISTORY);
+  for (u32 i = 0; i < input.size(); ++i)
+    input[i] = static_cast<s16>(std::lround(10000 * std::sin(std::numbers::pi * 0.8 * i)));
+
+  const auto get_peak = [&](u32 ratio) {
+    std::vector<s16> out(NUM_FRAMES * 4);
+    u32 position = 0;
+    u32 frac = 0;
+    const u32 written = AudioCommon::ResampleSinc(
+        out.data(), NUM_FRAMES * 2, input.data() + AudioCommon::SINC_HISTORY,
+        input.data() + AudioCommon::SINC_HISTORY, NUM_FRAMES, &position, &frac, ratio);
+    EXPECT_GT(written, SETTLE_FRAMES);
+
+    int peak = 0;
+    for (u32 i = SETTLE_FRAMES; i < written; ++i)
+      peak = std::max({peak, std::abs(out[i * 2]), std::abs(out[i * 2 + 1])});
+    return peak;
+  };
+
+  // The tone is below the Nyquist frequency of the output when upsampling, but would alias when
+  // downsampling by half
+  EXPECT_GT(get_peak(65536u * 32000 / 48000), 8000);
+  EXPECT_LT(get_peak(65536u * 2), 100);
+}
+
+// Measures how long it takes to produce one second of output with the DMA and streaming inputs
+// active. Run with --gtest_also_run_disabled_tests --gtest_filter=Mixer.DISABLED_Benchmark
+TEST(Mixer, DISABLED_Benchmark)
+{
+  Config::Init();
+
+  constexpr u32 CHUNK_MS = 5;
+  const std::vector<s16> dma_input = RandomSamples(32 * CHUNK_MS * 2, 5);
+  const std::vector<s16> streaming_input = RandomSamples(48 * CHUNK_MS * 2, 6);
+
+  for (const bool sinc : {false, true})
+  {
+    Config::SetCurrent(Config::MAIN_AUDIO_SINC_RESAMPLING, sinc);
+
+    for (const u32 sample_rate : {48000u, 96000u})
+    {
+      Mixer mixer(sample_rate);
+      const u32 output_frames = sample_rate / 1000 * CHUNK_MS;
+      std::vector<s16> output(output_frames * 2);
+
+      const auto start = std::chrono::steady_clock::now();
+      for (u32 i = 0; i < 1000 / CHUNK_MS; ++i)
+      {
+        mixer.PushSamples(dma_input.data(), static_cast<u32>(dma_input.size() / 2));
+        mixer.PushStreamingSamples(streaming_input.data(),
+                                   static_cast<u32>(streaming_input.size() / 2));
+        mixer.Mix(output.data(), output_frames);
+      }
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+
+      fmt::print("{} resampling at {} Hz: {} us per second of output\n", sinc ? "Sinc" : "Linear",
+                 sample_rate,
+                 std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+  }
+
+  Config::Shutdown();
+}
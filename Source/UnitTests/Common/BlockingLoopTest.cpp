@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -77,3 +78,37 @@ TEST(BlockingLoop, MultiThreaded)
     loop_thread.join();
   }
 }
+
+TEST(BlockingLoop, SpinBeforeSleep)
+{
+  Common::BlockingLoop loop;
+  loop.SetMaxSpinTime(std::chrono::milliseconds(10));
+
+  std::atomic<int> signaled(0);
+  std::atomic<int> received(0);
+
+  std::thread loop_thread([&]() { loop.Run([&]() { received.store(signaled.load()); }); });
+
+  loop.Prepare();
+  loop.Wait();
+
+  for (int i = 0; i < 1000; i++)
+  {
+    // Wait() allows the worker to sleep, so it spins before doing that, and wakeups must neither
+    // get lost while spinning nor while going to sleep afterwards.
+    signaled++;
+    loop.Wakeup();
+    loop.Wait();
+    EXPECT_EQ(signaled.load(), received.load());
+
+    if (i % 100 == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  loop.Stop();
+
+  // Must not block
+  loop.Wait();
+
+  loop_thread.join();
+}
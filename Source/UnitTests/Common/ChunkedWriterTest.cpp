@@ -0,0 +1,105 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Common/ChunkFile.h"
+#include "Common/ChunkedWriter.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+struct TestState
+{
+  u32 value = 0;
+  std::string name;
+  std::vector<u16> numbers;
+  std::vector<u8> external;
+
+  void DoState(PointerWrap& p)
+  {
+    p.Do(value);
+    p.Do(name);
+    p.Do(numbers);
+
+    const size_t size_position = p.ReserveU32();
+    u32 external_size = static_cast<u32>(external.size());
+    u8* external_data = p.DoExternal(external_size);
+    if (p.IsWriteMode())
+      std::memcpy(external_data, external.data(), external.size());
+    else if (p.IsReadMode())
+      external.assign(external_data, external_data + external_size);
+    p.SetReservedU32(size_position, p.GetOffsetFromReservedU32(size_position));
+
+    p.DoMarker("TestState");
+  }
+};
+}  // namespace
+
+TEST(ChunkedWriter, RoundTrip)
+{
+  TestState state;
+  state.value = 0x12345678;
+  state.name = "Chunked writer test";
+  for (u16 i = 0; i < 100; ++i)
+    state.numbers.push_back(i * 3);
+  for (u32 i = 0; i < 200; ++i)
+    state.external.push_back(static_cast<u8>(i));
+
+  std::vector<std::vector<u8>> chunks;
+  Common::ChunkedWriter writer([&](std::vector<u8> chunk) { chunks.push_back(std::move(chunk)); },
+                               64);
+  PointerWrap p_write(writer);
+  state.DoState(p_write);
+  ASSERT_TRUE(p_write.IsWriteMode());
+  const size_t size = p_write.GetPosition();
+  writer.Finish();
+
+  // The data doesn't fit into one chunk, and DoExternal needs a larger one.
+  EXPECT_GT(chunks.size(), 2u);
+
+  std::vector<u8> buffer;
+  for (const std::vector<u8>& chunk : chunks)
+    buffer.insert(buffer.end(), chunk.begin(), chunk.end());
+  ASSERT_EQ(size, buffer.size());
+
+  // The same data must be produced when writing to a buffer of the right size.
+  std::vector<u8> expected(size);
+  u8* ptr = expected.data();
+  PointerWrap p_expected(&ptr, expected.size(), PointerWrap::Mode::Write);
+  state.DoState(p_expected);
+  ASSERT_TRUE(p_expected.IsWriteMode());
+  EXPECT_EQ(expected, buffer);
+
+  TestState loaded;
+  ptr = buffer.data();
+  PointerWrap p_read(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  loaded.DoState(p_read);
+  ASSERT_TRUE(p_read.IsReadMode());
+  EXPECT_EQ(state.value, loaded.value);
+  EXPECT_EQ(state.name, loaded.name);
+  EXPECT_EQ(state.numbers, loaded.numbers);
+  EXPECT_EQ(state.external, loaded.external);
+}
+
+TEST(ChunkedWriter, HoldDelaysChunks)
+{
+  size_t submitted = 0;
+  Common::ChunkedWriter writer([&](std::vector<u8> chunk) { submitted += chunk.size(); }, 16);
+  PointerWrap p(writer);
+
+  const size_t position = p.ReserveU32();
+  for (u32 i = 0; i < 20; ++i)
+    p.Do(i);
+  EXPECT_EQ(0u, submitted);
+
+  p.SetReservedU32(position, 0xDEADBEEF);
+  EXPECT_GT(submitted, 0u);
+
+  writer.Finish();
+  EXPECT_EQ(sizeof(u32) * 21, submitted);
+}
@@ -0,0 +1,136 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Common/Logging/LogRingBuffer.h"
+
+using Common::Log::LogLevel;
+using Common::Log::LogRecordHeader;
+using Common::Log::LogRingBuffer;
+using Common::Log::LogType;
+
+static LogRecordHeader MakeHeader(u32 line)
+{
+  return {{}, "file.cpp", line, 0, LogLevel::LINFO, LogType::COMMON};
+}
+
+static std::string PopMessage(LogRingBuffer& ring, u32* line = nullptr)
+{
+  std::string result;
+  EXPECT_TRUE(ring.Peek([&](const LogRecordHeader& header, std::string_view message) {
+    result = message;
+    if (line)
+      *line = header.line;
+  }));
+  ring.Pop();
+  return result;
+}
+
+TEST(LogRingBuffer, Simple)
+{
+  LogRingBuffer ring(4096);
+  EXPECT_TRUE(ring.IsEmpty());
+
+  EXPECT_TRUE(ring.Push(MakeHeader(1), "hello"));
+  EXPECT_TRUE(ring.Push(MakeHeader(2), ""));
+  EXPECT_FALSE(ring.IsEmpty());
+
+  u32 line = 0;
+  EXPECT_EQ("hello", PopMessage(ring, &line));
+  EXPECT_EQ(1u, line);
+  EXPECT_EQ("", PopMessage(ring, &line));
+  EXPECT_EQ(2u, line);
+  EXPECT_TRUE(ring.IsEmpty());
+  EXPECT_FALSE(ring.Peek([](const LogRecordHeader&, std::string_view) {}));
+}
+
+TEST(LogRingBuffer, DropsWhenFull)
+{
+  LogRingBuffer ring(1024);
+  const std::string message(100, 'x');
+
+  u32 pushed = 0;
+  while (ring.Push(MakeHeader(pushed), message))
+    ++pushed;
+
+  EXPECT_GT(pushed, 0u);
+  EXPECT_FALSE(ring.Push(MakeHeader(0), message));
+  EXPECT_EQ(2u, ring.TakeDroppedCount());
+  EXPECT_EQ(0u, ring.TakeDroppedCount());
+
+  for (u32 i = 0; i < pushed; ++i)
+  {
+    u32 line;
+    EXPECT_EQ(message, PopMessage(ring, &line));
+    EXPECT_EQ(i, line);
+  }
+  EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(LogRingBuffer, TruncatesLongMessages)
+{
+  LogRingBuffer ring(1024);
+  const std::string message(1024, 'x');
+
+  EXPECT_TRUE(ring.Push(MakeHeader(0), message));
+  EXPECT_EQ(ring.GetMaxMessageLength(), PopMessage(ring).size());
+}
+
+TEST(LogRingBuffer, WrapAround)
+{
+  LogRingBuffer ring(1024);
+
+  // Vary the record sizes so that every possible amount of tail padding gets exercised.
+  for (u32 i = 0; i < 10000; ++i)
+  {
+    const std::string message(i % 97, static_cast<char>('a' + i % 26));
+    EXPECT_TRUE(ring.Push(MakeHeader(i), message));
+    if (i % 3 == 0)
+      EXPECT_TRUE(ring.Push(MakeHeader(i), message));
+
+    EXPECT_EQ(message, PopMessage(ring));
+    if (i % 3 == 0)
+      EXPECT_EQ(message, PopMessage(ring));
+  }
+  EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(LogRingBuffer, MultiThreaded)
+{
+  LogRingBuffer ring(4096);
+  constexpr u32 COUNT = 10000;
+
+  std::thread producer([&ring] {
+    for (u32 i = 0; i < COUNT; ++i)
+    {
+      const std::string message = std::to_string(i);
+      while (!ring.Push(MakeHeader(i), message))
+        std::this_thread::yield();
+    }
+  });
+
+  for (u32 i = 0; i < COUNT; ++i)
+  {
+    std::string message;
+    u32 line = 0;
+    while (!ring.Peek([&](const LogRecordHeader& header, std::string_view msg) {
+      message = msg;
+      line = header.line;
+    }))
+    {
+      std::this_thread::yield();
+    }
+    ring.Pop();
+
+    EXPECT_EQ(i, line);
+    EXPECT_EQ(std::to_string(i), message);
+  }
+
+  producer.join();
+  EXPECT_TRUE(ring.IsEmpty());
+}
@@ -0,0 +1,71 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "Common/WorkQueueThread.h"
+
+TEST(WorkQueueThread, ProcessesAllItems)
+{
+  std::atomic<int> sum = 0;
+  Common::WorkQueueThread<int> worker("WorkQueueThread Test", [&](int item) { sum += item; });
+
+  for (int i = 1; i <= 100; ++i)
+    worker.Push(i);
+  worker.WaitForCompletion();
+
+  EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(WorkQueueThread, MultipleThreadsProcessAllItems)
+{
+  std::atomic<int> sum = 0;
+  std::atomic<int> in_flight = 0;
+  std::atomic<int> max_in_flight = 0;
+  Common::WorkQueueThread<int> worker(
+      "WorkQueueThread Test",
+      [&](int item) {
+        const int current = ++in_flight;
+        int expected = max_in_flight.load();
+        while (current > expected && !max_in_flight.compare_exchange_weak(expected, current))
+        {
+        }
+        sum += item;
+        --in_flight;
+      },
+      4);
+
+  for (int i = 1; i <= 1000; ++i)
+    worker.Push(i);
+  worker.WaitForCompletion();
+
+  EXPECT_EQ(sum.load(), 500500);
+  EXPECT_EQ(in_flight.load(), 0);
+  EXPECT_LE(max_in_flight.load(), 4);
+}
+
+TEST(WorkQueueThread, ShutdownFinishesQueuedItems)
+{
+  std::atomic<int> count = 0;
+  Common::WorkQueueThread<int> worker("WorkQueueThread Test", [&](int) { ++count; }, 3);
+
+  for (int i = 0; i < 500; ++i)
+    worker.Push(i);
+  worker.Shutdown();
+
+  EXPECT_EQ(count.load(), 500);
+}
+
+TEST(WorkQueueThread, CancelWithMultipleThreads)
+{
+  Common::WorkQueueThread<int> worker("WorkQueueThread Test", [&](int) {}, 4);
+
+  for (int i = 0; i < 500; ++i)
+    worker.Push(i);
+  worker.Cancel();
+  worker.WaitForCompletion();
+
+  EXPECT_FALSE(worker.IsCancelling());
+}
@@ -0,0 +1,303 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/CheatSearch.h"
+#include "Core/PowerPC/MMU.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr u32 BASE_ADDRESS = 0x80000000;
+constexpr u32 PAGE_SIZE = PowerPC::HW_PAGE_SIZE;
+constexpr u32 PAGE_COUNT = 160;
+
+// Sessions switch from bitmaps over a snapshot to a list of results at this many results
+constexpr size_t SPARSE_RESULT_LIMIT = 0x10000;
+
+enum class PageState
+{
+  NotRAM,
+  Inaccessible,
+  Accessible,
+};
+
+// A window of emulated memory with pages that can be made inaccessible or not RAM at all
+class FakeMemory final : public Cheats::MemoryReader
+{
+public:
+  FakeMemory() : m_data(PAGE_COUNT * PAGE_SIZE), m_pages(PAGE_COUNT, PageState::Accessible)
+  {
+    Mutate(m_data.size());
+  }
+
+  bool IsRAMAddress(u32 address) const override
+  {
+    const std::optional<u32> page = GetPage(address);
+    return page && m_pages[*page] != PageState::NotRAM;
+  }
+
+  std::optional<bool> TryReadBlock(u32 address, std::span<u8> dest) const override
+  {
+    EXPECT_EQ(address / PAGE_SIZE, (address + dest.size() - 1) / PAGE_SIZE);
+    if (!IsAccessible(address))
+      return std::nullopt;
+    std::memcpy(dest.data(), &m_data[address - BASE_ADDRESS], dest.size());
+    return false;
+  }
+
+  // Reads a value byte by byte, only if all of it is accessible
+  template <typename T>
+  std::optional<T> Read(u32 address) const
+  {
+    std::array<u8, sizeof(T)> bytes;
+    for (u32 i = 0; i < sizeof(T); ++i)
+    {
+      if (!IsAccessible(address + i))
+        return std::nullopt;
+      bytes[sizeof(T) - 1 - i] = m_data[address + i - BASE_ADDRESS];
+    }
+    return std::bit_cast<T>(bytes);
+  }
+
+  // Changes the given number of random bytes. The bytes are picked from a few values so that
+  // there are plenty of equal values, zeroes, NaNs, denormals and signed zeroes.
+  void Mutate(size_t count)
+  {
+    static constexpr std::array<u8, 6> BYTES = {0x00, 0x01, 0x3F, 0x7F, 0x80, 0xFF};
+    std::uniform_int_distribution<size_t> offset(0, m_data.size() - 1);
+    std::uniform_int_distribution<size_t> byte(0, BYTES.size() - 1);
+    for (size_t i = 0; i < count; ++i)
+      m_data[offset(m_rng)] = BYTES[byte(m_rng)];
+  }
+
+  void SetPageState(u32 page, PageState state) { m_pages[page] = state; }
+
+private:
+  static std::optional<u32> GetPage(u32 address)
+  {
+    if (address < BASE_ADDRESS || address - BASE_ADDRESS >= PAGE_COUNT * PAGE_SIZE)
+      return std::nullopt;
+    return (address - BASE_ADDRESS) / PAGE_SIZE;
+  }
+
+  bool IsAccessible(u32 address) const
+  {
+    const std::optional<u32> page = GetPage(address);
+    return page && m_pages[*page] == PageState::Accessible;
+  }
+
+  std::vector<u8> m_data;
+  std::vector<PageState> m_pages;
+  std::mt19937 m_rng{1234};
+};
+
+// Searches value by value, like searches did before they used snapshots
+template <typename T>
+class ReferenceSearch
+{
+public:
+  ReferenceSearch(const FakeMemory& memory, const std::vector<Cheats::MemoryRange>& ranges,
+                  bool aligned, const std::function<bool(const T& value)>& validator)
+      : m_memory(memory)
+  {
+    const u32 step = aligned ? sizeof(T) : 1;
+    for (const Cheats::MemoryRange& range : ranges)
+    {
+      const u64 end = u64(range.m_start) + range.m_length;
+      u64 address = range.m_start;
+      if (aligned)
+        address = (address + sizeof(T) - 1) / sizeof(T) * sizeof(T);
+      for (; address + sizeof(T) <= end; address += step)
+      {
+        const std::optional<T> value = m_memory.Read<T>(static_cast<u32>(address));
+        if (value && validator(*value))
+        {
+          m_results.push_back({*value, Cheats::SearchResultValueState::ValueFromPhysicalMemory,
+                               static_cast<u32>(address)});
+        }
+      }
+    }
+  }
+
+  void Next(const std::function<bool(const T& new_value, const T& old_value)>& validator)
+  {
+    std::vector<Cheats::SearchResult<T>> results;
+    for (const Cheats::SearchResult<T>& previous : m_results)
+    {
+      const std::optional<T> value = m_memory.Read<T>(previous.m_address);
+      if (!value)
+      {
+        results.push_back(
+            {T{}, Cheats::SearchResultValueState::AddressNotAccessible, previous.m_address});
+      }
+      else if (!previous.IsValueValid() || validator(*value, previous.m_value))
+      {
+        results.push_back(
+            {*value, Cheats::SearchResultValueState::ValueFromPhysicalMemory, previous.m_address});
+      }
+    }
+    m_results = std::move(results);
+  }
+
+  const std::vector<Cheats::SearchResult<T>>& GetResults() const { return m_results; }
+
+private:
+  const FakeMemory& m_memory;
+  std::vector<Cheats::SearchResult<T>> m_results;
+};
+
+template <typename T>
+void ExpectSameResults(const Cheats::CheatSearchSession<T>& session,
+                       const ReferenceSearch<T>& reference)
+{
+  const std::vector<Cheats::SearchResult<T>>& expected = reference.GetResults();
+  ASSERT_EQ(session.GetResultCount(), expected.size());
+
+  size_t valid_count = 0;
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    ASSERT_EQ(session.GetResultAddress(i), expected[i].m_address) << "result " << i;
+    ASSERT_EQ(session.GetResultValueState(i), expected[i].m_value_state)
+        << "address " << std::hex << expected[i].m_address;
+    if (!expected[i].IsValueValid())
+      continue;
+
+    ++valid_count;
+    // Compare the bits so that NaNs compare equal
+    const T value = session.GetResultValue(i);
+    ASSERT_EQ(std::memcmp(&value, &expected[i].m_value, sizeof(T)), 0)
+        << "address " << std::hex << expected[i].m_address;
+  }
+  EXPECT_EQ(session.GetValidValueCount(), valid_count);
+}
+
+template <typename T>
+void RunSearch(Cheats::CheatSearchSession<T>* session, const FakeMemory& memory)
+{
+  ASSERT_EQ(session->PrepareSearch(memory), Cheats::SearchErrorCode::Success);
+  ASSERT_EQ(session->FinishSearch(), Cheats::SearchErrorCode::Success);
+}
+
+template <typename T>
+void TestSearches(bool aligned)
+{
+  SCOPED_TRACE(aligned ? "aligned" : "unaligned");
+
+  FakeMemory memory;
+  // Blocks are split by pages that aren't RAM, and values can't be read from pages that are
+  // inaccessible
+  memory.SetPageState(10, PageState::Inaccessible);
+  memory.SetPageState(11, PageState::NotRAM);
+  memory.SetPageState(25, PageState::NotRAM);
+  memory.SetPageState(26, PageState::NotRAM);
+  memory.SetPageState(60, PageState::Inaccessible);
+  memory.SetPageState(100, PageState::NotRAM);
+
+  // Neither range starts or ends on a page or value boundary, and the second one runs past the
+  // end of the memory
+  const std::vector<Cheats::MemoryRange> ranges = {
+      {BASE_ADDRESS + 3, 40 * PAGE_SIZE + 0x155},
+      {BASE_ADDRESS + 48 * PAGE_SIZE + 0x123, (PAGE_COUNT - 40) * PAGE_SIZE}};
+
+  Cheats::CheatSearchSession<T> session(ranges, PowerPC::RequestedAddressSpace::Physical,
+                                        aligned);
+  session.SetFilterType(Cheats::FilterType::DoNotFilter);
+  ReferenceSearch<T> reference(memory, ranges, aligned, [](const T&) { return true; });
+  RunSearch(&session, memory);
+  ExpectSameResults(session, reference);
+  ASSERT_GT(session.GetResultCount(), SPARSE_RESULT_LIMIT);
+
+  // Values on a page that became accessible weren't found by the first search. Values on pages
+  // that are no longer accessible are kept.
+  memory.Mutate(0x4000);
+  memory.SetPageState(60, PageState::Accessible);
+  memory.SetPageState(30, PageState::Inaccessible);
+  memory.SetPageState(31, PageState::NotRAM);
+  reference.Next([](const T&, const T&) { return true; });
+  RunSearch(&session, memory);
+  ExpectSameResults(session, reference);
+  ASSERT_GT(session.GetResultCount(), SPARSE_RESULT_LIMIT);
+
+  memory.Mutate(0x4000);
+  memory.SetPageState(30, PageState::Accessible);
+  session.SetFilterType(Cheats::FilterType::CompareAgainstLastValue);
+  session.SetCompareType(Cheats::CompareType::Equal);
+  reference.Next(std::equal_to<T>());
+  RunSearch(&session, memory);
+  ExpectSameResults(session, reference);
+
+  // Few enough values change for every type to switch to a list of results
+  memory.Mutate(0x1000);
+  memory.SetPageState(31, PageState::Accessible);
+  memory.SetPageState(70, PageState::Inaccessible);
+  session.SetCompareType(Cheats::CompareType::NotEqual);
+  reference.Next(std::not_equal_to<T>());
+  RunSearch(&session, memory);
+  ExpectSameResults(session, reference);
+  ASSERT_LE(session.GetResultCount(), SPARSE_RESULT_LIMIT);
+
+  memory.Mutate(0x4000);
+  session.SetFilterType(Cheats::FilterType::CompareAgainstSpecificValue);
+  session.SetCompareType(Cheats::CompareType::GreaterOrEqual);
+  ASSERT_TRUE(session.SetValueFromString("1", false));
+  reference.Next([](const T& new_value, const T&) { return new_value >= T(1); });
+  RunSearch(&session, memory);
+  ExpectSameResults(session, reference);
+
+  memory.Mutate(0x4000);
+  memory.SetPageState(70, PageState::Accessible);
+  session.SetFilterType(Cheats::FilterType::CompareAgainstLastValue);
+  session.SetCompareType(Cheats::CompareType::Less);
+  reference.Next(std::less<T>());
+  RunSearch(&session, memory);
+  ExpectSameResults(session, reference);
+}
+
+template <typename T>
+void TestSearches()
+{
+  TestSearches<T>(true);
+  TestSearches<T>(false);
+}
+}  // namespace
+
+TEST(CheatSearch, U8)
+{
+  TestSearches<u8>();
+}
+
+TEST(CheatSearch, U16)
+{
+  TestSearches<u16>();
+}
+
+TEST(CheatSearch, U32)
+{
+  TestSearches<u32>();
+}
+
+TEST(CheatSearch, S32)
+{
+  TestSearches<s32>();
+}
+
+TEST(CheatSearch, Float)
+{
+  TestSearches<float>();
+}
+
+TEST(CheatSearch, Double)
+{
+  TestSearches<double>();
+}
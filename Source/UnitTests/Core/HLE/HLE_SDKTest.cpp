@@ -0,0 +1,321 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/Core.h"
+#include "Core/HLE/HLE_SDK.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Simple versions of the SDK routines. Code runs with instruction translation off.
+constexpr u32 FUNCTION_ADDRESS = 0x00003000;
+constexpr u32 RETURN_ADDRESS = 0x00002000;
+constexpr u32 STACK_POINTER = 0x80001000;
+
+// Copies backwards if the source is below the destination
+constexpr std::initializer_list<u32> GUEST_MEMCPY = {
+    0x2C050000,  // cmpwi r5, 0
+    0x4D820020,  // beqlr
+    0x7C041840,  // cmplw r4, r3
+    0x41800020,  // blt backwards
+    0x7CA903A6,  // mtctr r5
+    0x38C4FFFF,  // addi r6, r4, -1
+    0x38E3FFFF,  // addi r7, r3, -1
+    0x8C060001,  // lbzu r0, 1(r6)
+    0x9C070001,  // stbu r0, 1(r7)
+    0x4200FFF8,  // bdnz -8
+    0x4E800020,  // blr
+    0x7CA903A6,  // backwards: mtctr r5
+    0x7CC42A14,  // add r6, r4, r5
+    0x7CE32A14,  // add r7, r3, r5
+    0x8C06FFFF,  // lbzu r0, -1(r6)
+    0x9C07FFFF,  // stbu r0, -1(r7)
+    0x4200FFF8,  // bdnz -8
+    0x4E800020,  // blr
+};
+
+constexpr std::initializer_list<u32> GUEST_MEMSET = {
+    0x2C050000,  // cmpwi r5, 0
+    0x4D820020,  // beqlr
+    0x7CA903A6,  // mtctr r5
+    0x38C3FFFF,  // addi r6, r3, -1
+    0x9C860001,  // stbu r4, 1(r6)
+    0x4200FFFC,  // bdnz -4
+    0x4E800020,  // blr
+};
+
+// The SDK's version ends with an sc as a sync barrier, which is left out here since there is no
+// system call handler
+constexpr std::initializer_list<u32> GUEST_DCFLUSHRANGE = {
+    0x28040000,  // cmplwi r4, 0
+    0x4D820020,  // beqlr
+    0x546506FE,  // clrlwi r5, r3, 27
+    0x7C842A14,  // add r4, r4, r5
+    0x3884001F,  // addi r4, r4, 31
+    0x5484D97E,  // srwi r4, r4, 5
+    0x7C8903A6,  // mtctr r4
+    0x7C0018AC,  // dcbf 0, r3
+    0x38630020,  // addi r3, r3, 32
+    0x4200FFF8,  // bdnz -8
+    0x4E800020,  // blr
+};
+
+// 0x80000000 maps the first MiB of RAM. The next BAT page maps somewhere else in RAM, so ranges
+// that cross into it aren't contiguous.
+constexpr u32 CONTIGUOUS_END = 0x80100000;
+// 0x81000000 maps the last BAT page of RAM, followed by a BAT page past the end of RAM
+constexpr u32 RAM_END = 0x81020000;
+
+using HLEFunction = void (*)(const Core::CPUThreadGuard&);
+
+struct CallResult
+{
+  bool native;
+  u32 r3;
+  u32 pc;
+  u32 lr;
+  u32 sp;
+  std::vector<u8> ram;
+};
+
+class HLE_SDKTest : public testing::Test
+{
+protected:
+  HLE_SDKTest() : m_system(Core::System::GetInstance())
+  {
+    Core::DeclareAsCPUThread();
+    m_system.GetMemory().Init();
+
+    auto& ppc_state = m_system.GetPPCState();
+    ppc_state.msr.Hex = 0;
+    ppc_state.msr.DR = 1;
+    SetBAT(SPR_DBAT0U, 0x80000000, 0x00000000, 0x7);
+    SetBAT(SPR_DBAT1U, 0x80100000, 0x00300000, 0);
+    SetBAT(SPR_DBAT2U, 0x81000000, 0x017E0000, 0);
+    SetBAT(SPR_DBAT3U, 0x81020000, 0x01800000, 0);
+    m_system.GetMMU().DBATUpdated();
+
+    auto& memory = m_system.GetMemory();
+    m_initial_ram.resize(memory.GetRamSize());
+    for (size_t i = 0; i < m_initial_ram.size(); ++i)
+      m_initial_ram[i] = static_cast<u8>(i * 13 + (i >> 8));
+  }
+
+  ~HLE_SDKTest() override
+  {
+    auto& ppc_state = m_system.GetPPCState();
+    for (u32 i = 0; i < 8; ++i)
+      ppc_state.spr[SPR_DBAT0U + i] = 0;
+    m_system.GetMMU().DBATUpdated();
+    ppc_state.msr.Hex = 0;
+
+    m_system.GetMemory().Shutdown();
+    Core::UndeclareAsCPUThread();
+  }
+
+  void SetBAT(u32 spr, u32 effective_address, u32 physical_address, u32 block_length)
+  {
+    auto& ppc_state = m_system.GetPPCState();
+    // Valid in supervisor and user mode
+    ppc_state.spr[spr] = effective_address | (block_length << 2) | 3;
+    // Read/write
+    ppc_state.spr[spr + 1] = physical_address | 2;
+  }
+
+  // Calls the native version of a function. Calls it can't handle must run the guest version
+  // instead, so those continue in the interpreter.
+  CallResult CallNative(HLEFunction function, std::initializer_list<u32> code,
+                        std::initializer_list<u32> args)
+  {
+    SetUpCall(code, args);
+
+    Core::CPUThreadGuard guard(m_system);
+    function(guard);
+
+    // Like the HLE hook does
+    auto& ppc_state = m_system.GetPPCState();
+    const bool native = ppc_state.npc == RETURN_ADDRESS;
+    ppc_state.pc = ppc_state.npc;
+    if (!native)
+      RunInterpreter();
+
+    return GetResult(native);
+  }
+
+  // Runs the guest version of a function in the interpreter
+  CallResult CallGuest(std::initializer_list<u32> code, std::initializer_list<u32> args)
+  {
+    SetUpCall(code, args);
+    RunInterpreter();
+    return GetResult(false);
+  }
+
+  void SetUpCall(std::initializer_list<u32> code, std::initializer_list<u32> args)
+  {
+    auto& memory = m_system.GetMemory();
+    std::memcpy(memory.GetRAM(), m_initial_ram.data(), m_initial_ram.size());
+    u32 address = FUNCTION_ADDRESS;
+    for (const u32 inst : code)
+    {
+      memory.Write_U32(inst, address);
+      address += 4;
+    }
+
+    auto& ppc_state = m_system.GetPPCState();
+    u32 reg = 3;
+    for (const u32 arg : args)
+      ppc_state.gpr[reg++] = arg;
+    ppc_state.gpr[1] = STACK_POINTER;
+    LR(ppc_state) = RETURN_ADDRESS;
+    ppc_state.pc = FUNCTION_ADDRESS;
+    ppc_state.npc = FUNCTION_ADDRESS;
+  }
+
+  void RunInterpreter()
+  {
+    auto& ppc_state = m_system.GetPPCState();
+    auto& interpreter = m_system.GetInterpreter();
+    for (u32 i = 0; i < 0x100000 && ppc_state.pc != RETURN_ADDRESS; ++i)
+      interpreter.SingleStepInner();
+    EXPECT_EQ(ppc_state.Exceptions, 0u);
+  }
+
+  CallResult GetResult(bool native)
+  {
+    const auto& ppc_state = m_system.GetPPCState();
+    auto& memory = m_system.GetMemory();
+    return {native,
+            ppc_state.gpr[3],
+            ppc_state.pc,
+            LR(ppc_state),
+            ppc_state.gpr[1],
+            std::vector<u8>(memory.GetRAM(), memory.GetRAM() + memory.GetRamSize())};
+  }
+
+  static void ExpectSameResult(const CallResult& native, const CallResult& guest)
+  {
+    EXPECT_EQ(native.r3, guest.r3);
+    EXPECT_EQ(native.pc, RETURN_ADDRESS);
+    EXPECT_EQ(guest.pc, RETURN_ADDRESS);
+    EXPECT_EQ(native.lr, RETURN_ADDRESS);
+    EXPECT_EQ(guest.lr, RETURN_ADDRESS);
+    EXPECT_EQ(native.sp, STACK_POINTER);
+
+    ASSERT_EQ(native.ram.size(), guest.ram.size());
+    const auto mismatch = std::mismatch(native.ram.begin(), native.ram.end(), guest.ram.begin());
+    EXPECT_TRUE(mismatch.first == native.ram.end())
+        << "RAM differs at " << std::hex << (mismatch.first - native.ram.begin());
+  }
+
+  void TestMemcpy(u32 dest, u32 src, u32 size, bool native)
+  {
+    SCOPED_TRACE(testing::Message() << std::hex << "memcpy(" << dest << ", " << src << ", " << size
+                                    << ")");
+    const CallResult native_result =
+        CallNative(HLE_SDK::HLE_memcpy, GUEST_MEMCPY, {dest, src, size});
+    const CallResult guest_result = CallGuest(GUEST_MEMCPY, {dest, src, size});
+    EXPECT_EQ(native_result.native, native);
+    EXPECT_EQ(guest_result.r3, dest);
+    ExpectSameResult(native_result, guest_result);
+  }
+
+  void TestMemset(u32 dest, u32 value, u32 size, bool native)
+  {
+    SCOPED_TRACE(testing::Message() << std::hex << "memset(" << dest << ", " << value << ", "
+                                    << size << ")");
+    const CallResult native_result =
+        CallNative(HLE_SDK::HLE_memset, GUEST_MEMSET, {dest, value, size});
+    const CallResult guest_result = CallGuest(GUEST_MEMSET, {dest, value, size});
+    EXPECT_EQ(native_result.native, native);
+    EXPECT_EQ(guest_result.r3, dest);
+    ExpectSameResult(native_result, guest_result);
+  }
+
+  void TestDCFlushRange(u32 address, u32 size)
+  {
+    SCOPED_TRACE(testing::Message() << std::hex << "DCFlushRange(" << address << ", " << size
+                                    << ")");
+    const CallResult native_result =
+        CallNative(HLE_SDK::HLE_DCFlushRange, GUEST_DCFLUSHRANGE, {address, size});
+    const CallResult guest_result = CallGuest(GUEST_DCFLUSHRANGE, {address, size});
+    EXPECT_TRUE(native_result.native);
+    ExpectSameResult(native_result, guest_result);
+  }
+
+  Core::System& m_system;
+  std::vector<u8> m_initial_ram;
+};
+}  // namespace
+
+TEST_F(HLE_SDKTest, Memcpy)
+{
+  TestMemcpy(0x80010000, 0x80020000, 0x100, true);
+  TestMemcpy(0x80010003, 0x80020001, 0x45, true);
+  TestMemcpy(0x80010001, 0x80020001, 1, true);
+  TestMemcpy(0x80010000, 0x80020000, 0, true);
+  // The ranges only just don't overlap
+  TestMemcpy(0x80010040, 0x80010000, 0x40, true);
+  TestMemcpy(0x80010000, 0x80010040, 0x40, true);
+}
+
+TEST_F(HLE_SDKTest, MemcpyOverlapping)
+{
+  TestMemcpy(0x80010010, 0x80010000, 0x40, false);
+  TestMemcpy(0x80010000, 0x80010010, 0x40, false);
+  TestMemcpy(0x80010001, 0x80010000, 0x100, false);
+  TestMemcpy(0x80010000, 0x80010000, 0x20, false);
+}
+
+TEST_F(HLE_SDKTest, MemcpyOutsideOfContiguousRAM)
+{
+  // Ranges that end right before the BAT page boundary are fine
+  TestMemcpy(CONTIGUOUS_END - 0x20, 0x80020000, 0x20, true);
+  TestMemcpy(0x80020000, CONTIGUOUS_END - 0x20, 0x20, true);
+  TestMemcpy(RAM_END - 0x20, 0x80020000, 0x20, true);
+
+  TestMemcpy(CONTIGUOUS_END - 0x10, 0x80020000, 0x20, false);
+  TestMemcpy(0x80020000, CONTIGUOUS_END - 0x10, 0x20, false);
+  TestMemcpy(RAM_END - 0x10, 0x80020000, 0x20, false);
+  TestMemcpy(0x80020000, RAM_END - 0x10, 0x20, false);
+}
+
+TEST_F(HLE_SDKTest, Memset)
+{
+  TestMemset(0x80010000, 0, 0x100, true);
+  TestMemset(0x80010003, 0xAB, 0x45, true);
+  // Only the low byte of the value is used
+  TestMemset(0x80010001, 0x123456CD, 0x20, true);
+  TestMemset(0x80010000, 0xFF, 0, true);
+  TestMemset(CONTIGUOUS_END - 0x20, 0x11, 0x20, true);
+  TestMemset(RAM_END - 0x20, 0x22, 0x20, true);
+}
+
+TEST_F(HLE_SDKTest, MemsetOutsideOfContiguousRAM)
+{
+  TestMemset(CONTIGUOUS_END - 0x10, 0x11, 0x20, false);
+  TestMemset(RAM_END - 0x10, 0x22, 0x20, false);
+}
+
+TEST_F(HLE_SDKTest, DCFlushRange)
+{
+  // Returns the address after the last cache line, counted from the unaligned start
+  TestDCFlushRange(0x80010000, 0);
+  TestDCFlushRange(0x80010000, 1);
+  TestDCFlushRange(0x80010000, 0x40);
+  TestDCFlushRange(0x80010005, 0x3C);
+  TestDCFlushRange(0x80010005, 0x3B);
+  TestDCFlushRange(CONTIGUOUS_END - 0x10, 0x20);
+}
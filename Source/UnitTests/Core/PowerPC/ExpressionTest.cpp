@@ -0,0 +1,80 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <optional>
+
+#include "Core/PowerPC/Expression.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace
+{
+double Evaluate(const char* text)
+{
+  const std::optional<Expression> expression = Expression::TryParse(text);
+  EXPECT_TRUE(expression.has_value()) << text;
+  return expression ? expression->Evaluate(Core::System::GetInstance()) : std::nan("");
+}
+}  // namespace
+
+TEST(Expression, Registers)
+{
+  auto& ppc_state = Core::System::GetInstance().GetPPCState();
+  ppc_state.gpr[3] = 0x80001234;
+  ppc_state.gpr[4] = 5;
+  ppc_state.ps[1].SetPS0(2.5);
+  ppc_state.spr[SPR_LR] = 0x80004000;
+  ppc_state.pc = 0x80003000;
+
+  EXPECT_EQ(1.0, Evaluate("r3 == 0x80001234"));
+  EXPECT_EQ(0.0, Evaluate("r4 != 5"));
+  EXPECT_EQ(12.5, Evaluate("r4 * f1"));
+  EXPECT_EQ(1.0, Evaluate("lr - pc == 0x1000"));
+  EXPECT_EQ(0x1234, Evaluate("r3 & 0xFFFF"));
+  EXPECT_EQ(-1.0, Evaluate("s8(0xFF)"));
+}
+
+TEST(Expression, Operators)
+{
+  EXPECT_EQ(7.0, Evaluate("1 + 2 * 3"));
+  EXPECT_EQ(8.0, Evaluate("2 ** 3"));
+  EXPECT_EQ(1.0, Evaluate("7 % 3"));
+  EXPECT_EQ(16.0, Evaluate("1 << 4"));
+  EXPECT_EQ(-6.0, Evaluate("~5"));
+  EXPECT_EQ(1.0, Evaluate("!0"));
+  EXPECT_EQ(6.0, Evaluate("3 ^ 5"));
+  EXPECT_EQ(3.0, Evaluate("1, 2, 3"));
+}
+
+TEST(Expression, ShortCircuit)
+{
+  EXPECT_EQ(0.0, Evaluate("0 && (x = 1)"));
+  EXPECT_EQ(3.0, Evaluate("2 && 3"));
+  EXPECT_EQ(2.0, Evaluate("2 || 3"));
+  EXPECT_EQ(3.0, Evaluate("0 || 3"));
+  EXPECT_EQ(0.0, Evaluate("0 || 0"));
+  EXPECT_FALSE(std::signbit(Evaluate("-0 && 1")));
+  EXPECT_FALSE(std::signbit(Evaluate("1 && -0")));
+}
+
+TEST(Expression, Temporaries)
+{
+  const std::optional<Expression> expression = Expression::TryParse("x = x + 1, x");
+  ASSERT_TRUE(expression.has_value());
+
+  // Temporaries start out as zero on every evaluation.
+  EXPECT_EQ(1.0, expression->Evaluate(Core::System::GetInstance()));
+  EXPECT_EQ(1.0, expression->Evaluate(Core::System::GetInstance()));
+}
+
+TEST(Expression, RegisterAssignment)
+{
+  auto& ppc_state = Core::System::GetInstance().GetPPCState();
+  ppc_state.gpr[5] = 1;
+
+  EXPECT_EQ(0.0, Evaluate("r5 = 42, 0"));
+  EXPECT_EQ(42u, ppc_state.gpr[5]);
+}
@@ -0,0 +1,214 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <span>
+
+#include "Common/CommonTypes.h"
+#include "Common/ScopeGuard.h"
+#include "Common/x64ABI.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Jit64/Jit.h"
+#include "Core/PowerPC/Jit64Common/Jit64AsmCommon.h"
+#include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/System.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr std::array<EQuantizeType, 5> QUANTIZE_TYPES{QUANTIZE_FLOAT, QUANTIZE_U8, QUANTIZE_U16,
+                                                      QUANTIZE_S8, QUANTIZE_S16};
+
+// Runs a conversion the given number of times (at least once) and returns the last result
+using Routine = u64 (*)(u64 input, u32 gqr, u32 iterations);
+
+class TestCommonAsmRoutines : public CommonAsmRoutines
+{
+public:
+  explicit TestCommonAsmRoutines(Core::System& system) : CommonAsmRoutines(jit), jit(system)
+  {
+    AllocCodeSpace(0x80000);
+    m_const_pool.Init(AllocChildCodeSpace(4096), 4096);
+  }
+
+  // A scale of -1 calls the conversion used by the lookup table routines, which takes the scale
+  // from the GQR at runtime. Otherwise, the conversion is specialized for the given scale and
+  // inlined, like the JIT does for a GQR it knows.
+  Routine GenRoutine(bool store, bool single, EQuantizeType type, int scale)
+  {
+    using namespace Gen;
+
+    const u8* runtime_conversion = nullptr;
+    if (scale == -1)
+    {
+      runtime_conversion = AlignCode4();
+      GenConversion(store, single, type, scale);
+      RET();
+    }
+
+    const auto routine = reinterpret_cast<Routine>(AlignCode16());
+    MOV(32, R(R8), R(ABI_PARAM3));
+    MOV(32, R(R9), R(ABI_PARAM2));
+    MOV(64, R(R10), R(ABI_PARAM1));
+    MOVQ_xmm(XMM2, R(R10));
+
+    const u8* loop = GetCodePtr();
+    MOV(32, R(RSCRATCH2), R(R9));
+    if (store)
+      MOVAPS(XMM0, R(XMM2));
+    else
+      MOV(64, R(RSCRATCH_EXTRA), R(R10));
+    if (runtime_conversion)
+      CALL(runtime_conversion);
+    else
+      GenConversion(store, single, type, scale);
+    SUB(32, R(R8), Imm8(1));
+    J_CC(CC_NZ, loop);
+
+    if (store)
+      MOV(64, R(ABI_RETURN), R(RSCRATCH));
+    else
+      MOVQ_xmm(R(ABI_RETURN), XMM0);
+    RET();
+
+    return routine;
+  }
+
+  Jit64 jit;
+
+private:
+  void GenConversion(bool store, bool single, EQuantizeType type, int scale)
+  {
+    if (store)
+      GenQuantize(single, type, scale);
+    else
+      GenDequantize(single, type, scale);
+  }
+};
+
+u32 OutputBits(bool store, bool single, EQuantizeType type)
+{
+  if (!store)
+    return 64;
+
+  u32 bits = 16;
+  if (type == QUANTIZE_FLOAT)
+    bits = 32;
+  else if (type == QUANTIZE_U8 || type == QUANTIZE_S8)
+    bits = 8;
+  return single ? bits : bits * 2;
+}
+
+u64 Pair(float ps0, float ps1)
+{
+  return std::bit_cast<u32>(ps0) | u64(std::bit_cast<u32>(ps1)) << 32;
+}
+
+// The value that a quantized load gets from memory, sign extended for single S8 and S16 loads
+u64 LoadedValue(u64 value, bool single, EQuantizeType type)
+{
+  if (!single)
+    return value;
+  if (type == QUANTIZE_S8)
+    return u32(s32(s8(value)));
+  if (type == QUANTIZE_S16)
+    return u32(s32(s16(value)));
+  return value & (type == QUANTIZE_FLOAT ? 0xFFFFFFFF : type == QUANTIZE_U8 ? 0xFF : 0xFFFF);
+}
+
+const std::array<u64, 8> store_inputs{
+    Pair(0.0f, -0.0f),       Pair(1.0f, -1.0f),         Pair(0.3f, 127.6f),
+    Pair(-128.5f, 255.9f),   Pair(-32768.0f, 65535.5f), Pair(1.0e9f, -1.0e9f),
+    Pair(1.0e-20f, 3.14159f), Pair(-0.75f, 4096.25f),
+};
+
+const std::array<u64, 6> load_inputs{
+    0x0000000000000000, 0x00000000000000FF, 0x000000000000FFFF,
+    0x0000000000008001, 0x3F800000C2F60000, 0x7F7FFFFF00800000,
+};
+}  // namespace
+
+// Checks that the conversions specialized for a known GQR give the same results as the lookup
+// table routines, for every quantization type and scale.
+TEST(Jit64, QuantizedLoadStore)
+{
+  Core::DeclareAsCPUThread();
+  Common::ScopeGuard cpu_thread_guard([] { Core::UndeclareAsCPUThread(); });
+
+  TestCommonAsmRoutines routines(Core::System::GetInstance());
+
+  for (const bool store : {false, true})
+  {
+    for (const bool single : {false, true})
+    {
+      for (const EQuantizeType type : QUANTIZE_TYPES)
+      {
+        const Routine generic = routines.GenRoutine(store, single, type, -1);
+        const u32 bits = OutputBits(store, single, type);
+        const u64 mask = bits == 64 ? ~u64(0) : (u64(1) << bits) - 1;
+
+        for (int scale = 0; scale < 64; ++scale)
+        {
+          const Routine specialized = routines.GenRoutine(store, single, type, scale);
+          const u32 gqr = u32(scale) << 8 | type;
+
+          for (const u64 value : store ? std::span<const u64>(store_inputs) :
+                                         std::span<const u64>(load_inputs))
+          {
+            const u64 input = store ? value : LoadedValue(value, single, type);
+            const u64 expected = generic(input, gqr, 1) & mask;
+            const u64 actual = specialized(input, gqr, 1) & mask;
+            EXPECT_EQ(expected, actual)
+                << fmt::format("{} single={} type={} scale={} input={:016x}",
+                               store ? "store" : "load", single, static_cast<u32>(type), scale,
+                               input);
+          }
+        }
+      }
+    }
+  }
+}
+
+// Compares the time taken by the specialized and lookup table conversions. Run with
+// --gtest_also_run_disabled_tests --gtest_filter=Jit64.DISABLED_QuantizedLoadStoreBenchmark
+TEST(Jit64, DISABLED_QuantizedLoadStoreBenchmark)
+{
+  Core::DeclareAsCPUThread();
+  Common::ScopeGuard cpu_thread_guard([] { Core::UndeclareAsCPUThread(); });
+
+  TestCommonAsmRoutines routines(Core::System::GetInstance());
+
+  constexpr u32 ITERATIONS = 10000000;
+  constexpr int SCALE = 5;
+
+  const auto measure = [](Routine routine, u64 input, u32 gqr) {
+    const auto start = std::chrono::steady_clock::now();
+    routine(input, gqr, ITERATIONS);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  };
+
+  for (const bool store : {false, true})
+  {
+    for (const bool single : {false, true})
+    {
+      for (const EQuantizeType type : QUANTIZE_TYPES)
+      {
+        const u32 gqr = u32(SCALE) << 8 | type;
+        const u64 input = store ? store_inputs[2] : LoadedValue(load_inputs[4], single, type);
+
+        const auto generic = measure(routines.GenRoutine(store, single, type, -1), input, gqr);
+        const auto specialized =
+            measure(routines.GenRoutine(store, single, type, SCALE), input, gqr);
+
+        fmt::print("{} {} type {}: {} us generic, {} us specialized\n", store ? "Store" : "Load",
+                   single ? "single" : "paired", static_cast<u32>(type), generic, specialized);
+      }
+    }
+  }
+}
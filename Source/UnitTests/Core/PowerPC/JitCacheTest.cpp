@@ -0,0 +1,118 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr std::size_t REGION_SIZE = 0x100;
+
+class TestBlockCache final : public JitBaseBlockCache
+{
+public:
+  using JitBaseBlockCache::JitBaseBlockCache;
+
+private:
+  void WriteLinkBlock(const JitBlock::LinkData&, const JitBlock*) override {}
+};
+
+class JitCacheTest : public testing::Test
+{
+protected:
+  JitCacheTest() : m_jit(Core::System::GetInstance()), m_cache(m_jit)
+  {
+    m_cache.Init();
+    m_cache.InitCodeRegions(m_code.data(), m_code.data() + m_code.size());
+  }
+
+  ~JitCacheTest() override { m_cache.Shutdown(); }
+
+  // Adds a block whose near code starts at the given offset into the given region
+  void AddBlock(u32 address, std::size_t region, std::size_t offset)
+  {
+    JitBlock* const block = m_cache.AllocateBlock(address);
+    block->near_begin = m_code.data() + region * REGION_SIZE + offset;
+    block->near_end = block->near_begin + 0x10;
+    block->far_begin = nullptr;
+    block->far_end = nullptr;
+    block->normalEntry = block->near_begin;
+    block->codeSize = 0x10;
+    block->originalSize = 4;
+    m_cache.FinalizeBlock(*block, false, {address});
+  }
+
+  bool HasBlock(u32 address)
+  {
+    const CPUEmuFeatureFlags feature_flags =
+        Core::System::GetInstance().GetPPCState().feature_flags;
+    return m_cache.GetBlockFromStartAddress(address, feature_flags) != nullptr;
+  }
+
+  void MarkRegionAsUsed(std::size_t region)
+  {
+    u8* const flag = m_cache.GetCodeRegionUseFlag(m_code.data() + region * REGION_SIZE);
+    ASSERT_NE(flag, nullptr);
+    *flag = 1;
+  }
+
+  std::array<u8, JitBaseBlockCache::NUM_CODE_REGIONS * REGION_SIZE> m_code{};
+  CachedInterpreter m_jit;
+  TestBlockCache m_cache;
+};
+}  // namespace
+
+TEST_F(JitCacheTest, CodeRegionUseFlags)
+{
+  EXPECT_EQ(m_cache.GetCodeRegionUseFlag(m_code.data() + m_code.size()), nullptr);
+  EXPECT_EQ(m_cache.GetCodeRegionUseFlag(m_code.data() + REGION_SIZE - 1),
+            m_cache.GetCodeRegionUseFlag(m_code.data()));
+  EXPECT_NE(m_cache.GetCodeRegionUseFlag(m_code.data() + REGION_SIZE),
+            m_cache.GetCodeRegionUseFlag(m_code.data()));
+}
+
+TEST_F(JitCacheTest, EvictColdestCodeRegion)
+{
+  AddBlock(0x80000000, 0, 0x00);
+  AddBlock(0x80000100, 0, 0x40);
+  AddBlock(0x80000200, 1, 0x00);
+  AddBlock(0x80000300, 2, 0x00);
+  EXPECT_EQ(m_cache.GetCodeRegionBlockCount(0), 2u);
+  EXPECT_EQ(m_cache.GetCodeRegionBlockCount(1), 1u);
+  EXPECT_EQ(m_cache.GetCodeRegionBlockCount(2), 1u);
+  EXPECT_EQ(m_cache.GetBlockCount(), 4u);
+
+  // Region 0 was compiled first, but running its code makes it the most recently used one
+  MarkRegionAsUsed(0);
+  EXPECT_EQ(m_cache.EvictColdestCodeRegion(), 1u);
+  EXPECT_EQ(m_cache.GetCodeRegionBlockCount(1), 0u);
+  EXPECT_FALSE(HasBlock(0x80000200));
+  EXPECT_EQ(m_cache.GetBlockCount(), 3u);
+
+  // The use flag was cleared when it was sampled, so region 0 is still newer than region 2
+  EXPECT_EQ(m_cache.EvictColdestCodeRegion(), 1u);
+  EXPECT_EQ(m_cache.GetCodeRegionBlockCount(2), 0u);
+  EXPECT_FALSE(HasBlock(0x80000300));
+  EXPECT_TRUE(HasBlock(0x80000000));
+
+  // Compiling into an empty region makes it the newest one
+  AddBlock(0x80000400, 1, 0x80);
+  EXPECT_EQ(m_cache.GetCodeRegionBlockCount(1), 1u);
+  EXPECT_EQ(m_cache.EvictColdestCodeRegion(), 2u);
+  EXPECT_EQ(m_cache.GetCodeRegionBlockCount(0), 0u);
+  EXPECT_FALSE(HasBlock(0x80000000));
+  EXPECT_FALSE(HasBlock(0x80000100));
+  EXPECT_TRUE(HasBlock(0x80000400));
+
+  EXPECT_EQ(m_cache.EvictColdestCodeRegion(), 1u);
+  EXPECT_EQ(m_cache.GetBlockCount(), 0u);
+  EXPECT_EQ(m_cache.EvictColdestCodeRegion(), 0u);
+}
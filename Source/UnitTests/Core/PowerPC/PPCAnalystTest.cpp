@@ -0,0 +1,425 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <initializer_list>
+#include <optional>
+#include <set>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/SymbolDB.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#include <gtest/gtest.h>
+
+using PPCAnalyst::FunctionLiveness;
+using PPCAnalyst::RegisterLiveness;
+
+namespace
+{
+constexpr u32 LI_R3 = 0x38600000;           // li r3, 0
+constexpr u32 LI_R4 = 0x38800000;           // li r4, 0
+constexpr u32 ADDI_R4_R5 = 0x38850000;      // addi r4, r5, 0
+constexpr u32 ADDIC_R3_R4 = 0x30640001;     // addic r3, r4, 1
+constexpr u32 CMPWI_R3 = 0x2C030000;        // cmpwi r3, 0
+constexpr u32 LWZ_R3 = 0x80640000;          // lwz r3, 0(r4)
+constexpr u32 STW_R3 = 0x90640000;          // stw r3, 0(r4)
+constexpr u32 FMR_F1_F2 = 0xFC201090;       // fmr f1, f2
+constexpr u32 BL_FORWARD = 0x48000101;      // bl +0x100
+constexpr u32 B_FORWARD_8 = 0x48000008;     // b +8
+constexpr u32 B_BACK_0x100 = 0x4BFFFF00;    // b -0x100
+constexpr u32 BEQ_FORWARD_8 = 0x41820008;   // beq +8
+constexpr u32 BEQ_BACK_0x100 = 0x4182FF00;  // beq -0x100
+constexpr u32 BNE_BACK_4 = 0x4082FFFC;      // bne -4
+constexpr u32 BLR = 0x4E800020;             // blr
+
+constexpr u32 LIS_R4_MMIO = 0x3C80CC00;     // lis r4, 0xCC00
+constexpr u32 ADDI_R4_R4 = 0x38840004;      // addi r4, r4, 4
+constexpr u32 ADDIC_R6_R3 = 0x30C3FFFF;     // addic r6, r3, -1
+constexpr u32 ADDZE_R5_R3 = 0x7CA30194;     // addze r5, r3
+constexpr u32 ANDIS_R5_EQ = 0x74A52000;     // andis. r5, r5, 0x2000
+constexpr u32 CMPWI_R5 = 0x2C050000;        // cmpwi r5, 0
+constexpr u32 CMPWI_CR1_R3 = 0x2C830001;    // cmpwi cr1, r3, 1
+constexpr u32 CROR_EQ = 0x4C423382;         // cror eq, eq, 4*cr1+eq
+constexpr u32 CRXOR_EQ = 0x4C423182;        // crxor eq, eq, 4*cr1+eq
+constexpr u32 LWZU_R3 = 0x84640004;         // lwzu r3, 4(r4)
+constexpr u32 STFS_F1 = 0xD0240000;         // stfs f1, 0(r4)
+constexpr u32 DCBZ_R4 = 0x7C0027EC;         // dcbz 0, r4
+constexpr u32 MFCR_R5 = 0x7CA00026;         // mfcr r5
+constexpr u32 MFSPR_R5_DEC = 0x7CB602A6;    // mfspr r5, DEC
+constexpr u32 MFTB_R5 = 0x7CAC42E6;         // mftb r5
+constexpr u32 SYNC = 0x7C0004AC;            // sync
+constexpr u32 ISYNC = 0x4C00012C;           // isync
+constexpr u32 BNE_BACK_8 = 0x4082FFF8;      // bne -8
+constexpr u32 BNE_BACK_12 = 0x4082FFF4;     // bne -12
+constexpr u32 BNE_BACK_16 = 0x4082FFF0;     // bne -16
+constexpr u32 BNE_BACK_20 = 0x4082FFEC;     // bne -20
+constexpr u32 BEQ_BACK_24 = 0x4182FFE8;     // beq -24
+constexpr u32 BDNZ_BACK_12 = 0x4200FFF4;    // bdnz -12
+
+constexpr u32 FUNCTION_ADDRESS = 0x80004000;
+constexpr u32 CALLER_ADDRESS = 0x80004100;
+
+class PPCAnalystTest : public testing::Test
+{
+protected:
+  PPCAnalystTest() : m_system(Core::System::GetInstance())
+  {
+    m_system.GetMemory().Init();
+    m_analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_EXIT_LIVENESS);
+    m_analyzer.SetLivenessCache(&m_cache);
+  }
+
+  ~PPCAnalystTest() override
+  {
+    m_system.GetPowerPC().GetSymbolDB().Clear();
+    m_system.GetMemory().Shutdown();
+  }
+
+  // Writes the code at address and adds a function symbol for it
+  void AddFunction(const std::string& name, u32 address, std::initializer_list<u32> code)
+  {
+    WriteCode(address, code);
+
+    Common::Symbol symbol(name);
+    symbol.address = address;
+    symbol.size = static_cast<u32>(code.size() * 4);
+    m_system.GetPowerPC().GetSymbolDB().AddCompleteSymbol(symbol);
+  }
+
+  void WriteCode(u32 address, std::initializer_list<u32> code)
+  {
+    for (const u32 inst : code)
+    {
+      m_system.GetMemory().Write_U32(inst, address);
+      address += 4;
+    }
+  }
+
+  FunctionLiveness Compute(std::initializer_list<u32> code)
+  {
+    WriteCode(FUNCTION_ADDRESS, code);
+    return m_analyzer.ComputeFunctionLiveness(FUNCTION_ADDRESS, FUNCTION_ADDRESS,
+                                              static_cast<u32>(code.size()));
+  }
+
+  // Analyzes a loop at FUNCTION_ADDRESS and returns the idle loop that was found at its last
+  // instruction, if any
+  std::optional<PPCAnalyst::IdleLoop> FindIdleLoop(std::initializer_list<u32> code)
+  {
+    WriteCode(FUNCTION_ADDRESS, code);
+
+    PPCAnalyst::BlockStats stats;
+    PPCAnalyst::BlockRegStats gpa;
+    PPCAnalyst::BlockRegStats fpa;
+    PPCAnalyst::CodeBlock block;
+    block.m_stats = &stats;
+    block.m_gpa = &gpa;
+    block.m_fpa = &fpa;
+    PPCAnalyst::CodeBuffer buffer(code.size());
+
+    PPCAnalyst::IdleLoopReport report;
+    m_analyzer.SetIdleLoopReport(&report);
+    m_analyzer.Analyze(FUNCTION_ADDRESS, &block, &buffer, code.size());
+    m_analyzer.SetIdleLoopReport(nullptr);
+
+    const u32 branch_address = FUNCTION_ADDRESS + static_cast<u32>(code.size() - 1) * 4;
+    const auto it = report.find(branch_address);
+    EXPECT_EQ(buffer.back().branchIsIdleLoop, it != report.end());
+    if (it == report.end())
+      return std::nullopt;
+
+    EXPECT_EQ(it->second.start_address, FUNCTION_ADDRESS);
+    EXPECT_EQ(it->second.num_instructions, code.size());
+    return it->second;
+  }
+
+  // A direct branch at address, as the analyzer would have decoded it
+  static PPCAnalyst::CodeOp MakeBranch(u32 address, u32 inst)
+  {
+    PPCAnalyst::CodeOp op;
+    op.inst = UGeckoInstruction(inst);
+    op.address = address;
+    if (op.inst.OPCD == 18)
+      op.branchTo = address + SignExt26(op.inst.LI << 2);
+    else
+      op.branchTo = address + SignExt16(op.inst.BD << 2);
+    return op;
+  }
+
+  Core::System& m_system;
+  PPCAnalyst::LivenessCache m_cache;
+  PPCAnalyst::PPCAnalyzer m_analyzer;
+  PPCAnalyst::CodeBlock m_block;
+};
+}  // namespace
+
+TEST_F(PPCAnalystTest, FunctionLivenessStraightLine)
+{
+  const FunctionLiveness function = Compute({LI_R3, ADDI_R4_R5, ADDIC_R3_R4, CMPWI_R3, BLR});
+  ASSERT_EQ(function.instructions.size(), 5u);
+  EXPECT_EQ(function.address, FUNCTION_ADDRESS);
+  for (u32 i = 0; i < 5; ++i)
+    EXPECT_EQ(function.instructions[i].physical_address, FUNCTION_ADDRESS + i * 4);
+
+  // Returns are barriers
+  EXPECT_TRUE(function.instructions[4].barrier);
+  EXPECT_EQ(function.instructions[4].live_in, RegisterLiveness::All());
+
+  const RegisterLiveness& cmpwi = function.instructions[3].live_in;
+  EXPECT_FALSE(function.instructions[3].barrier);
+  EXPECT_EQ(function.instructions[3].successors[0], 4);
+  EXPECT_EQ(function.instructions[3].successors[1], -1);
+  EXPECT_FALSE(cmpwi.crs[0]);
+  EXPECT_TRUE(cmpwi.crs[1]);
+  EXPECT_TRUE(cmpwi.gprs[3]);
+
+  const RegisterLiveness& addic = function.instructions[2].live_in;
+  EXPECT_FALSE(addic.ca);
+  EXPECT_FALSE(addic.gprs[3]);
+  EXPECT_TRUE(addic.gprs[4]);
+
+  const RegisterLiveness& entry = function.instructions[0].live_in;
+  EXPECT_FALSE(entry.gprs[3]);
+  EXPECT_FALSE(entry.gprs[4]);
+  EXPECT_TRUE(entry.gprs[5]);
+  EXPECT_FALSE(entry.crs[0]);
+  EXPECT_FALSE(entry.ca);
+  EXPECT_TRUE(entry.fprf);
+  EXPECT_EQ(entry.fprs, BitSet32(0xFFFFFFFF));
+}
+
+TEST_F(PPCAnalystTest, FunctionLivenessBarriers)
+{
+  // Loads and stores can cause DSIs, FPU instructions can cause FP unavailable exceptions
+  const FunctionLiveness function =
+      Compute({LI_R3, LWZ_R3, LI_R3, STW_R3, LI_R3, FMR_F1_F2, LI_R3, BL_FORWARD, LI_R3, BLR});
+  ASSERT_EQ(function.instructions.size(), 10u);
+  for (u32 i = 0; i < 10; i += 2)
+  {
+    EXPECT_FALSE(function.instructions[i].barrier) << i;
+    EXPECT_FALSE(function.instructions[i].live_in.gprs[3]) << i;
+    EXPECT_TRUE(function.instructions[i].live_in.gprs[4]) << i;
+    EXPECT_TRUE(function.instructions[i].live_in.ca) << i;
+
+    EXPECT_TRUE(function.instructions[i + 1].barrier) << i + 1;
+    EXPECT_EQ(function.instructions[i + 1].live_in, RegisterLiveness::All()) << i + 1;
+  }
+}
+
+TEST_F(PPCAnalystTest, FunctionLivenessBranches)
+{
+  const FunctionLiveness function = Compute({
+      CMPWI_R3,       // 0
+      BEQ_FORWARD_8,  // 1: to 3
+      LI_R4,          // 2
+      ADDIC_R3_R4,    // 3
+      BNE_BACK_4,     // 4: to 3
+      B_FORWARD_8,    // 5: to 7
+      ADDI_R4_R5,     // 6: unreachable
+      LI_R4,          // 7
+      BLR,            // 8
+  });
+  ASSERT_EQ(function.instructions.size(), 9u);
+
+  EXPECT_EQ(function.instructions[1].successors[0], 3);
+  EXPECT_EQ(function.instructions[1].successors[1], 2);
+  EXPECT_EQ(function.instructions[4].successors[0], 3);
+  EXPECT_EQ(function.instructions[4].successors[1], 5);
+  EXPECT_EQ(function.instructions[5].successors[0], 7);
+  EXPECT_EQ(function.instructions[5].successors[1], -1);
+  for (u32 i = 0; i < 8; ++i)
+    EXPECT_FALSE(function.instructions[i].barrier) << i;
+
+  // The loop reads r4 and CR0, and overwrites r3 and CA before anything after it can read them
+  EXPECT_TRUE(function.instructions[3].live_in.gprs[4]);
+  EXPECT_FALSE(function.instructions[3].live_in.gprs[3]);
+  EXPECT_TRUE(function.instructions[3].live_in.crs[0]);
+  EXPECT_FALSE(function.instructions[3].live_in.ca);
+  EXPECT_TRUE(function.instructions[4].live_in.ca);
+  // Only one of the paths into the loop overwrites r4
+  EXPECT_FALSE(function.instructions[2].live_in.gprs[4]);
+  EXPECT_TRUE(function.instructions[1].live_in.gprs[4]);
+  EXPECT_TRUE(function.instructions[1].live_in.crs[0]);
+  EXPECT_FALSE(function.instructions[0].live_in.crs[0]);
+  // r4 is overwritten after the loop, and the skipped code doesn't matter
+  EXPECT_EQ(function.instructions[5].live_in, function.instructions[7].live_in);
+  EXPECT_FALSE(function.instructions[5].live_in.gprs[4]);
+}
+
+TEST_F(PPCAnalystTest, FunctionLivenessBranchesOutOfFunction)
+{
+  const FunctionLiveness function = Compute({LI_R3, B_BACK_0x100, LI_R3, BEQ_FORWARD_8, BLR});
+  ASSERT_EQ(function.instructions.size(), 5u);
+
+  EXPECT_TRUE(function.instructions[1].barrier);
+  EXPECT_EQ(function.instructions[0].live_in.gprs, ~BitSet32{3});
+  // One of the paths leaves the function
+  EXPECT_TRUE(function.instructions[3].barrier);
+  EXPECT_EQ(function.instructions[3].live_in, RegisterLiveness::All());
+}
+
+TEST_F(PPCAnalystTest, ExitLiveness)
+{
+  AddFunction("callee", FUNCTION_ADDRESS, {LI_R3, LI_R4, BLR});
+  AddFunction("caller", CALLER_ADDRESS, {BEQ_BACK_0x100, LI_R3, BLR});
+
+  // b FUNCTION_ADDRESS at the end of a block
+  const PPCAnalyst::CodeOp b = MakeBranch(0x80001000, 0x48003000);
+  ASSERT_EQ(b.branchTo, FUNCTION_ADDRESS);
+  RegisterLiveness liveness = m_analyzer.GetExitLiveness(b, true, &m_block);
+  EXPECT_FALSE(liveness.gprs[3]);
+  EXPECT_FALSE(liveness.gprs[4]);
+  EXPECT_TRUE(liveness.gprs[5]);
+  EXPECT_TRUE(liveness.ca);
+  EXPECT_EQ(m_block.m_physical_addresses,
+            (std::set<u32>{FUNCTION_ADDRESS, FUNCTION_ADDRESS + 4, FUNCTION_ADDRESS + 8}));
+
+  // An unconditional branch in the middle of a block has been followed
+  EXPECT_EQ(m_analyzer.GetExitLiveness(b, false, &m_block), RegisterLiveness{});
+
+  // Calls leave whatever they call free to read anything
+  PPCAnalyst::CodeOp bl = b;
+  bl.inst.LK = 1;
+  EXPECT_EQ(m_analyzer.GetExitLiveness(bl, true, &m_block), RegisterLiveness::All());
+
+  // Both paths of a conditional branch at the end of a block leave it
+  const PPCAnalyst::CodeOp bc = MakeBranch(CALLER_ADDRESS, BEQ_BACK_0x100);
+  ASSERT_EQ(bc.branchTo, FUNCTION_ADDRESS);
+  liveness = m_analyzer.GetExitLiveness(bc, true, &m_block);
+  EXPECT_FALSE(liveness.gprs[3]);
+  EXPECT_TRUE(liveness.gprs[4]);
+
+  // Only the taken path of a conditional branch in the middle of a block does
+  liveness = m_analyzer.GetExitLiveness(bc, false, &m_block);
+  EXPECT_FALSE(liveness.gprs[3]);
+  EXPECT_FALSE(liveness.gprs[4]);
+
+  // Only the untaken path of a followed branch does
+  PPCAnalyst::CodeOp followed = bc;
+  followed.branchIsFollowed = true;
+  liveness = m_analyzer.GetExitLiveness(followed, false, &m_block);
+  EXPECT_FALSE(liveness.gprs[3]);
+  EXPECT_TRUE(liveness.gprs[4]);
+
+  // Code without a symbol isn't analyzed
+  EXPECT_EQ(m_analyzer.GetExitLiveness(MakeBranch(0x80001000, B_FORWARD_8), true, &m_block),
+            RegisterLiveness::All());
+
+  m_analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_EXIT_LIVENESS);
+  EXPECT_EQ(m_analyzer.GetExitLiveness(b, true, &m_block), RegisterLiveness::All());
+}
+
+TEST_F(PPCAnalystTest, InvalidateLiveness)
+{
+  AddFunction("callee", FUNCTION_ADDRESS, {LI_R3, LI_R4, BLR});
+  AddFunction("caller", CALLER_ADDRESS, {LI_R3, BLR});
+
+  const PPCAnalyst::CodeOp to_callee = MakeBranch(0x80001000, 0x48003000);
+  const PPCAnalyst::CodeOp to_caller = MakeBranch(0x80001000, 0x48003100);
+  EXPECT_FALSE(m_analyzer.GetExitLiveness(to_callee, true, &m_block).gprs[4]);
+  EXPECT_FALSE(m_analyzer.GetExitLiveness(to_caller, true, &m_block).gprs[3]);
+  ASSERT_EQ(m_cache.size(), 2u);
+
+  // The gap between the functions
+  PPCAnalyst::InvalidateLiveness(&m_cache, FUNCTION_ADDRESS + 12,
+                                 CALLER_ADDRESS - FUNCTION_ADDRESS - 12);
+  EXPECT_EQ(m_cache.size(), 2u);
+
+  // Rewrite the code of the callee so that it reads r4. Without invalidating, the old result is
+  // still used.
+  WriteCode(FUNCTION_ADDRESS + 4, {ADDIC_R3_R4});
+  EXPECT_FALSE(m_analyzer.GetExitLiveness(to_callee, true, &m_block).gprs[4]);
+
+  PPCAnalyst::InvalidateLiveness(&m_cache, FUNCTION_ADDRESS + 4, 4);
+  EXPECT_EQ(m_cache.count(FUNCTION_ADDRESS), 0u);
+  EXPECT_EQ(m_cache.count(CALLER_ADDRESS), 1u);
+
+  const RegisterLiveness liveness = m_analyzer.GetExitLiveness(to_callee, true, &m_block);
+  EXPECT_TRUE(liveness.gprs[4]);
+  EXPECT_FALSE(liveness.ca);
+
+  // A range that covers the ends of both functions
+  PPCAnalyst::InvalidateLiveness(&m_cache, FUNCTION_ADDRESS + 8, CALLER_ADDRESS - FUNCTION_ADDRESS);
+  EXPECT_TRUE(m_cache.empty());
+}
+
+TEST_F(PPCAnalystTest, IdleLoopBasic)
+{
+  m_analyzer.SetGeneralizedIdleLoopsEnabled(true);
+  const std::optional<PPCAnalyst::IdleLoop> loop = FindIdleLoop({LWZ_R3, CMPWI_R3, BNE_BACK_8});
+  ASSERT_TRUE(loop.has_value());
+  EXPECT_FALSE(loop->generalized);
+
+  // The basic detector doesn't depend on the generalized one being enabled
+  m_analyzer.SetGeneralizedIdleLoopsEnabled(false);
+  EXPECT_TRUE(FindIdleLoop({LWZ_R3, CMPWI_R3, BNE_BACK_8}).has_value());
+}
+
+TEST_F(PPCAnalystTest, IdleLoopGeneralizedMMIOPoll)
+{
+  // Waits until an MMIO register is 0 or 1
+  const std::initializer_list<u32> code = {LIS_R4_MMIO, LWZ_R3,  CMPWI_R3,
+                                           CMPWI_CR1_R3, CROR_EQ, BNE_BACK_20};
+
+  m_analyzer.SetGeneralizedIdleLoopsEnabled(true);
+  const std::optional<PPCAnalyst::IdleLoop> loop = FindIdleLoop(code);
+  ASSERT_TRUE(loop.has_value());
+  EXPECT_TRUE(loop->generalized);
+
+  m_analyzer.SetGeneralizedIdleLoopsEnabled(false);
+  EXPECT_FALSE(FindIdleLoop(code).has_value());
+}
+
+TEST_F(PPCAnalystTest, IdleLoopGeneralizedBarriers)
+{
+  // Reads CR through mfcr between memory barriers
+  const std::initializer_list<u32> code = {SYNC,    LWZ_R3,      ISYNC,      CMPWI_R3,
+                                           MFCR_R5, ANDIS_R5_EQ, BEQ_BACK_24};
+
+  m_analyzer.SetGeneralizedIdleLoopsEnabled(true);
+  const std::optional<PPCAnalyst::IdleLoop> loop = FindIdleLoop(code);
+  ASSERT_TRUE(loop.has_value());
+  EXPECT_TRUE(loop->generalized);
+
+  m_analyzer.SetGeneralizedIdleLoopsEnabled(false);
+  EXPECT_FALSE(FindIdleLoop(code).has_value());
+}
+
+TEST_F(PPCAnalystTest, IdleLoopGeneralizedRejects)
+{
+  m_analyzer.SetGeneralizedIdleLoopsEnabled(true);
+
+  // Each of the loops below is this one with a single change. The sync keeps the basic detector
+  // from accepting any of them.
+  ASSERT_TRUE(FindIdleLoop({LWZ_R3, SYNC, CMPWI_R3, BNE_BACK_12}).has_value());
+
+  // Loop-carried GPR
+  EXPECT_FALSE(FindIdleLoop({LWZ_R3, SYNC, ADDI_R4_R4, CMPWI_R3, BNE_BACK_16}).has_value());
+  EXPECT_FALSE(FindIdleLoop({LWZU_R3, SYNC, CMPWI_R3, BNE_BACK_12}).has_value());
+
+  // Loop-carried CR field
+  EXPECT_FALSE(FindIdleLoop({LWZ_R3, SYNC, CMPWI_CR1_R3, CRXOR_EQ, BNE_BACK_16}).has_value());
+
+  // Loop-carried carry flag. Setting it first is fine.
+  EXPECT_TRUE(
+      FindIdleLoop({LWZ_R3, SYNC, ADDIC_R6_R3, ADDZE_R5_R3, CMPWI_R5, BNE_BACK_20}).has_value());
+  EXPECT_FALSE(FindIdleLoop({LWZ_R3, SYNC, ADDZE_R5_R3, CMPWI_R5, BNE_BACK_16}).has_value());
+
+  // The loop counts down CTR
+  EXPECT_FALSE(FindIdleLoop({LWZ_R3, SYNC, CMPWI_R3, BDNZ_BACK_12}).has_value());
+
+  // Stores
+  EXPECT_FALSE(FindIdleLoop({LWZ_R3, SYNC, STW_R3, CMPWI_R3, BNE_BACK_16}).has_value());
+  EXPECT_FALSE(FindIdleLoop({LWZ_R3, SYNC, STFS_F1, CMPWI_R3, BNE_BACK_16}).has_value());
+  EXPECT_FALSE(FindIdleLoop({LWZ_R3, SYNC, DCBZ_R4, CMPWI_R3, BNE_BACK_16}).has_value());
+
+  // Reads of registers that change without memory being written
+  EXPECT_FALSE(FindIdleLoop({MFSPR_R5_DEC, SYNC, CMPWI_R5, BNE_BACK_12}).has_value());
+  EXPECT_FALSE(FindIdleLoop({MFTB_R5, SYNC, CMPWI_R5, BNE_BACK_12}).has_value());
+}
@@ -0,0 +1,49 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/SymbolDB.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+
+static Common::Symbol MakeSymbol(const std::string& name, u32 address, u32 size)
+{
+  Common::Symbol symbol(name);
+  symbol.address = address;
+  symbol.size = size;
+  return symbol;
+}
+
+TEST(PPCSymbolDB, GetSymbolFromAddr)
+{
+  PPCSymbolDB db;
+  db.AddCompleteSymbol(MakeSymbol("first", 0x80003100, 0x20));
+  db.AddCompleteSymbol(MakeSymbol("second", 0x80003200, 0x10));
+  db.AddCompleteSymbol(MakeSymbol("empty", 0x80003300, 0));
+
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80003000), nullptr);
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80003100)->name, "first");
+  EXPECT_EQ(db.GetSymbolFromAddr(0x8000311c)->name, "first");
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80003120), nullptr);
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80003204)->name, "second");
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80003210), nullptr);
+  // A symbol without a size is only found by its start address
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80003300)->name, "empty");
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80003304), nullptr);
+}
+
+TEST(PPCSymbolDB, GetSymbolFromAddrAfterChanges)
+{
+  PPCSymbolDB db;
+  db.AddCompleteSymbol(MakeSymbol("outer", 0x80004000, 0x100));
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80004080)->name, "outer");
+
+  db.AddCompleteSymbol(MakeSymbol("inner", 0x80004040, 0x80));
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80004080)->name, "inner");
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80004020)->name, "outer");
+
+  db.Clear();
+  EXPECT_EQ(db.GetSymbolFromAddr(0x80004080), nullptr);
+}
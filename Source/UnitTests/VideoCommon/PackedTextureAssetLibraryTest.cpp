@@ -0,0 +1,165 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/Assets/PackedTextureAssetLibrary.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+
+using VideoCommon::CustomTextureData;
+using VideoCommon::PackedTextureAssetLibrary;
+namespace TexturePack = VideoCommon::TexturePack;
+
+namespace
+{
+CustomTextureData::ArraySlice::Level MakeLevel(AbstractTextureFormat format, u32 width, u32 height,
+                                               u32 size, u8 seed)
+{
+  CustomTextureData::ArraySlice::Level level;
+  level.format = format;
+  level.width = width;
+  level.height = height;
+  level.row_length = width;
+  level.data.resize(size);
+  for (u32 i = 0; i < size; ++i)
+    level.data[i] = static_cast<u8>(seed + i);
+  return level;
+}
+
+// An RGBA8 texture with a full mip chain
+TexturePack::SourceTexture MakeMipmappedTexture(std::string name, u32 size, u8 seed)
+{
+  TexturePack::SourceTexture texture{std::move(name), true, {}};
+  for (u32 level_size = size; level_size != 0; level_size /= 2)
+  {
+    texture.slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, level_size,
+                                               level_size, level_size * level_size * 4, seed++));
+  }
+  return texture;
+}
+}  // namespace
+
+class PackedTextureAssetLibraryTest : public testing::Test
+{
+protected:
+  PackedTextureAssetLibraryTest()
+      : m_directory(File::CreateTempDir()), m_path(m_directory + "/pack.dtp")
+  {
+  }
+
+  ~PackedTextureAssetLibraryTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  // Writes a pack with the given textures and returns whether it can be opened
+  bool WriteAndOpen(const std::vector<TexturePack::SourceTexture>& textures)
+  {
+    EXPECT_TRUE(TexturePack::Write(m_path, textures));
+    return m_library.Open(m_path);
+  }
+
+  const std::string m_directory;
+  const std::string m_path;
+  PackedTextureAssetLibrary m_library;
+};
+
+TEST_F(PackedTextureAssetLibraryTest, RoundTrip)
+{
+  std::vector<TexturePack::SourceTexture> textures;
+  textures.push_back(MakeMipmappedTexture("tex1_8x8_0123456789abcdef_5", 8, 1));
+  textures.push_back({"tex1_16x8_fedcba9876543210_14", false, {}});
+  textures.back().slice.m_levels.push_back(
+      MakeLevel(AbstractTextureFormat::DXT1, 16, 8, 4 * 2 * 8, 100));
+  textures.push_back(MakeMipmappedTexture("tex1_1x1_0000000000000000_3", 1, 200));
+  ASSERT_TRUE(WriteAndOpen(textures));
+
+  std::map<std::string, bool, std::less<>> names;
+  m_library.ForEachTexture([&](std::string_view name, bool has_arbitrary_mipmaps) {
+    names.emplace(name, has_arbitrary_mipmaps);
+  });
+  ASSERT_EQ(names.size(), textures.size());
+
+  for (const TexturePack::SourceTexture& texture : textures)
+  {
+    const auto name = names.find(texture.name);
+    ASSERT_NE(name, names.end()) << texture.name;
+    EXPECT_EQ(name->second, texture.has_arbitrary_mipmaps) << texture.name;
+
+    VideoCommon::TextureData data;
+    const auto load_info = m_library.LoadTexture(texture.name, &data);
+    EXPECT_NE(load_info.m_bytes_loaded, 0u) << texture.name;
+    ASSERT_EQ(data.m_texture.m_slices.size(), 1u);
+
+    const auto& loaded_levels = data.m_texture.m_slices[0].m_levels;
+    ASSERT_EQ(loaded_levels.size(), texture.slice.m_levels.size()) << texture.name;
+    for (std::size_t i = 0; i < loaded_levels.size(); ++i)
+    {
+      const auto& expected = texture.slice.m_levels[i];
+      const auto& actual = loaded_levels[i];
+      EXPECT_EQ(actual.format, expected.format);
+      EXPECT_EQ(actual.width, expected.width);
+      EXPECT_EQ(actual.height, expected.height);
+      EXPECT_EQ(actual.row_length, expected.row_length);
+      EXPECT_TRUE(std::ranges::equal(actual.GetData(), expected.data))
+          << texture.name << " level " << i;
+    }
+  }
+
+  VideoCommon::TextureData data;
+  EXPECT_EQ(m_library.LoadTexture("tex1_4x4_1111111111111111_5", &data).m_bytes_loaded, 0u);
+}
+
+TEST_F(PackedTextureAssetLibraryTest, RejectsTruncatedLevel)
+{
+  std::vector<TexturePack::SourceTexture> textures;
+  textures.push_back(MakeMipmappedTexture("rgba", 8, 0));
+  textures.back().slice.m_levels[1].data.resize(4 * 4 * 4 - 1);
+  EXPECT_FALSE(WriteAndOpen(textures));
+
+  textures.clear();
+  textures.push_back({"dxt1", false, {}});
+  // 8 rows need two rows of 4x4 blocks
+  textures.back().slice.m_levels.push_back(
+      MakeLevel(AbstractTextureFormat::DXT1, 16, 8, 4 * 8, 0));
+  EXPECT_FALSE(WriteAndOpen(textures));
+}
+
+TEST_F(PackedTextureAssetLibraryTest, RejectsInvalidDimensions)
+{
+  std::vector<TexturePack::SourceTexture> textures;
+  textures.push_back(MakeMipmappedTexture("row_length", 8, 0));
+  textures.back().slice.m_levels[0].row_length = 4;
+  EXPECT_FALSE(WriteAndOpen(textures));
+
+  textures.clear();
+  textures.push_back({"unaligned_dxt1", false, {}});
+  textures.back().slice.m_levels.push_back(
+      MakeLevel(AbstractTextureFormat::DXT1, 6, 4, 2 * 8, 0));
+  EXPECT_FALSE(WriteAndOpen(textures));
+
+  textures.clear();
+  textures.push_back(MakeMipmappedTexture("mip_size", 8, 0));
+  textures.back().slice.m_levels.erase(textures.back().slice.m_levels.begin() + 1);
+  EXPECT_FALSE(WriteAndOpen(textures));
+
+  textures.clear();
+  textures.push_back(MakeMipmappedTexture("mip_format", 8, 0));
+  textures.back().slice.m_levels[1].format = AbstractTextureFormat::BGRA8;
+  EXPECT_FALSE(WriteAndOpen(textures));
+}